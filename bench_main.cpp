@@ -0,0 +1,152 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 09:12:40
+ * @brief  
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "common/bench_regression.h"
+#include "common/bench_reporter.h"
+
+/*
+ * Runs without a console, every result is also written as JSON:
+ *
+ *		cxx_features_bench								-> bench_result.json
+ *		cxx_features_bench --benchmark_out=nightly.json	-> nightly.json
+ *
+ * Any --benchmark_out / --benchmark_out_format given on the command line
+ * wins over the defaults below.
+ *
+ * Regression check, see common/bench_regression.h:
+ *
+ *		--pluto_cpu=<list>				run on these cpus only, e.g. 2 or 2-5,8
+ *		--pluto_save_baseline=<file>	write the JSON output to file, same as --benchmark_out
+ *		--pluto_baseline=<file>			compare with file, exit 2 on regression
+ *		--pluto_threshold=<pct>[,<prefix>:<pct>...]	allowed slowdown, default 5
+ *		--pluto_alpha=<p>				significance level, default 0.05
+ */
+static const char* flag_value(const char* arg, const char* flag)
+{
+	const std::size_t n = std::strlen(flag);
+	return std::strncmp(arg, flag, n) == 0 && arg[n] == '=' ? arg + n + 1 : nullptr;
+}
+
+static bool has_flag(const std::vector<char*>& args, const char* flag)
+{
+	for (std::size_t i = 1; i < args.size(); ++i)
+	{
+		if (flag_value(args[i], flag) != nullptr) return true;
+	}
+	return false;
+}
+
+int main(int argc, char** argv)
+{
+	static char out[] = "--benchmark_out=bench_result.json";
+	static char out_format[] = "--benchmark_out_format=json";
+	static char repetitions[] = "--benchmark_repetitions=10";
+
+	std::string save_path, baseline_path, save_out;
+	pluto::bench::threshold_list thresholds;
+	double alpha = 0.05;
+	std::vector<int> cpus;
+
+	// take out our flags, pass the rest to the library
+	std::vector<char*> args{ argv[0] };
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* v = nullptr;
+		if ((v = flag_value(argv[i], "--pluto_save_baseline"))) save_path = v;
+		else if ((v = flag_value(argv[i], "--pluto_baseline"))) baseline_path = v;
+		else if ((v = flag_value(argv[i], "--pluto_cpu")))
+		{
+			if (!pluto::bench::parse_cpu_list(v, cpus))
+			{
+				std::cerr << "bad --pluto_cpu: " << v << std::endl;
+				return 1;
+			}
+		}
+		else if ((v = flag_value(argv[i], "--pluto_alpha"))) alpha = std::atof(v);
+		else if ((v = flag_value(argv[i], "--pluto_threshold")))
+		{
+			if (!thresholds.parse(v))
+			{
+				std::cerr << "bad --pluto_threshold: " << v << std::endl;
+				return 1;
+			}
+		}
+		else args.push_back(argv[i]);
+	}
+
+	const bool check = !save_path.empty() || !baseline_path.empty();
+	if (!save_path.empty())
+	{
+		// the baseline is the JSON file, at full precision
+		if (has_flag(args, "--benchmark_out") || has_flag(args, "--benchmark_out_format"))
+		{
+			std::cerr << "--pluto_save_baseline writes --benchmark_out, give only one of them" << std::endl;
+			return 1;
+		}
+		save_out = "--benchmark_out=" + save_path;
+		args.push_back(save_out.data());
+	}
+	if (!has_flag(args, "--benchmark_out")) args.push_back(out);
+	if (!has_flag(args, "--benchmark_out_format")) args.push_back(out_format);
+	if (check && !has_flag(args, "--benchmark_repetitions")) args.push_back(repetitions);
+
+	int n = static_cast<int>(args.size());
+	args.push_back(nullptr);
+
+	benchmark::Initialize(&n, args.data());
+	if (benchmark::ReportUnrecognizedArguments(n, args.data())) return 1;
+
+	if (!cpus.empty() && !pluto::bench::pin_to_cpus(cpus))
+	{
+		std::cerr << "cannot pin to the cpus given, running unpinned" << std::endl;
+	}
+
+	if (!check)
+	{
+		benchmark::RunSpecifiedBenchmarks();
+		benchmark::Shutdown();
+		return 0;
+	}
+
+	pluto::bench::sample_map base;
+	int digits = 0;
+	if (!baseline_path.empty())
+	{
+		std::ifstream in(baseline_path);
+		if (!in)
+		{
+			std::cerr << "cannot read baseline " << baseline_path << std::endl;
+			return 1;
+		}
+		base = pluto::bench::read_baseline(in, digits);
+	}
+
+	pluto::bench::collecting_reporter reporter;
+	benchmark::RunSpecifiedBenchmarks(&reporter);
+	benchmark::Shutdown();
+
+	if (baseline_path.empty()) return 0;
+
+	// a console baseline is rounded, compare the new run at the same precision
+	pluto::bench::sample_map now = reporter.samples();
+	if (digits != 0)
+	{
+		pluto::bench::round_samples(base, digits);
+		pluto::bench::round_samples(now, digits);
+	}
+
+	std::cout << '\n';
+	auto rows = pluto::bench::compare(base, now, thresholds, alpha);
+	return pluto::bench::print_report(std::cout, rows) != 0 ? 2 : 0;
+}
@@ -0,0 +1,155 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 21:48:37
+ * @brief
+ */
+
+#include "alloc_counter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace pluto
+{
+namespace alloc
+{
+
+namespace
+{
+
+struct thread_counters
+{
+	alloc_stats total;
+	std::int64_t live;
+	std::int64_t peak_mark;		// the current scope's high-water mark
+};
+
+/* zero initialized, no constructor runs inside operator new */
+thread_local thread_counters counters{};
+
+/* the header in front of every block, the size sits right below the user pointer */
+constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+std::size_t header_for(std::size_t align)
+{
+	return std::max(align, header_size);
+}
+
+void note_alloc(std::size_t n)
+{
+	thread_counters& c = counters;
+	++c.total.allocations;
+	c.total.bytes += n;
+	c.live += static_cast<std::int64_t>(n);
+	c.peak_mark = std::max(c.peak_mark, c.live);
+	c.total.peak = std::max(c.total.peak, c.live);
+}
+
+void note_free(std::size_t n)
+{
+	thread_counters& c = counters;
+	++c.total.deallocations;
+	c.total.freed_bytes += n;
+	c.live -= static_cast<std::int64_t>(n);
+}
+
+void* allocate(std::size_t n, std::size_t align) noexcept
+{
+	const std::size_t header = header_for(align);
+	if (n > SIZE_MAX - 2 * header) return nullptr;
+
+	void* base = align <= header_size
+		? std::malloc(n + header)
+		: std::aligned_alloc(header, (n + header + header - 1) / header * header);
+	if (base == nullptr) return nullptr;
+
+	auto* user = static_cast<unsigned char*>(base) + header;
+	reinterpret_cast<std::size_t*>(user)[-1] = n;
+	note_alloc(n);
+	return user;
+}
+
+void deallocate(void* p, std::size_t align) noexcept
+{
+	if (p == nullptr) return;
+	auto* user = static_cast<unsigned char*>(p);
+	note_free(reinterpret_cast<std::size_t*>(user)[-1]);
+	std::free(user - header_for(align));
+}
+
+void* allocate_or_throw(std::size_t n, std::size_t align)
+{
+	for (;;)
+	{
+		if (void* p = allocate(n, align)) return p;
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) throw std::bad_alloc();
+		handler();
+	}
+}
+
+} // namespace
+
+alloc_stats thread_stats()
+{
+	return counters.total;
+}
+
+alloc_scope::alloc_scope()
+	: start_(counters.total), start_live_(counters.live), saved_peak_(counters.peak_mark)
+{
+	counters.peak_mark = counters.live;
+}
+
+alloc_scope::~alloc_scope()
+{
+	counters.peak_mark = std::max(saved_peak_, counters.peak_mark);
+}
+
+alloc_stats alloc_scope::stats() const
+{
+	const alloc_stats& now = counters.total;
+	alloc_stats s;
+	s.allocations = now.allocations - start_.allocations;
+	s.deallocations = now.deallocations - start_.deallocations;
+	s.bytes = now.bytes - start_.bytes;
+	s.freed_bytes = now.freed_bytes - start_.freed_bytes;
+	s.peak = counters.peak_mark - start_live_;
+	return s;
+}
+
+} // alloc
+} // pluto
+
+// the replaced global forms, everything ends in allocate / deallocate
+
+using pluto::alloc::allocate;
+using pluto::alloc::allocate_or_throw;
+using pluto::alloc::deallocate;
+
+void* operator new(std::size_t n) { return allocate_or_throw(n, 0); }
+void* operator new[](std::size_t n) { return allocate_or_throw(n, 0); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return allocate(n, 0); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return allocate(n, 0); }
+
+void* operator new(std::size_t n, std::align_val_t al) { return allocate_or_throw(n, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t n, std::align_val_t al) { return allocate_or_throw(n, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(n, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(n, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { deallocate(p, 0); }
+void operator delete[](void* p) noexcept { deallocate(p, 0); }
+void operator delete(void* p, std::size_t) noexcept { deallocate(p, 0); }
+void operator delete[](void* p, std::size_t) noexcept { deallocate(p, 0); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p, 0); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p, 0); }
+
+void operator delete(void* p, std::align_val_t al) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept { deallocate(p, static_cast<std::size_t>(al)); }
@@ -0,0 +1,102 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 21:48:37
+ * @brief
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace pluto
+{
+namespace alloc
+{
+
+/*
+ * Allocation accounting for the test binary. alloc_counter.cpp replaces
+ * the global operator new / delete (every form: array, nothrow, aligned,
+ * sized) with versions that keep per-thread totals, so claims like "a
+ * small std::any does not allocate" can be checked instead of trusted:
+ *
+ *		std::any a;
+ *		EXPECT_NO_ALLOCATIONS({ a = 42; });
+ *		EXPECT_ALLOCATIONS_LE(1, { a = std::string(100, 'x'); });
+ *
+ * or, to look at the numbers,
+ *
+ *		alloc_scope scope;
+ *		v.push_back(x);
+ *		scope.stats().allocations, .bytes, .peak ...
+ *
+ * Every block is prefixed with a 16 byte (or alignment sized) header that
+ * remembers its size, so bytes and live memory are exact even for the
+ * unsized delete. Counting is per thread: a scope only sees what its own
+ * thread allocates, memory freed on another thread shows up there.
+ *
+ * Only the test project links alloc_counter.cpp, the benchmarks keep the
+ * plain allocator.
+ */
+
+struct alloc_stats
+{
+	std::uint64_t allocations = 0;
+	std::uint64_t deallocations = 0;
+	std::uint64_t bytes = 0;		// allocated
+	std::uint64_t freed_bytes = 0;
+	std::int64_t peak = 0;			// highest live bytes above the starting point
+
+	/* bytes still held, negative if more was freed than allocated */
+	std::int64_t net_bytes() const
+	{
+		return static_cast<std::int64_t>(bytes) - static_cast<std::int64_t>(freed_bytes);
+	}
+};
+
+/* everything the calling thread did since it started, peak is its all-time high */
+alloc_stats thread_stats();
+
+/*
+ * Counts the calling thread's allocations between construction and
+ * stats(). Scopes nest, an inner scope does not disturb the peak seen by
+ * the outer one. Create and destroy it on the same thread.
+ */
+class alloc_scope
+{
+public:
+	alloc_scope();
+	~alloc_scope();
+
+	alloc_scope(const alloc_scope&) = delete;
+	alloc_scope& operator=(const alloc_scope&) = delete;
+
+	alloc_stats stats() const;
+
+private:
+	alloc_stats start_;
+	std::int64_t start_live_;
+	std::int64_t saved_peak_;
+};
+
+} // alloc
+} // pluto
+
+/* gtest checks, the block is a braced statement list: EXPECT_NO_ALLOCATIONS({ a = 1; }) */
+#define EXPECT_NO_ALLOCATIONS(...)																\
+	do {																						\
+		pluto::alloc::alloc_scope pluto_alloc_scope_;											\
+		{ __VA_ARGS__ }																			\
+		const auto pluto_alloc_stats_ = pluto_alloc_scope_.stats();								\
+		EXPECT_EQ(pluto_alloc_stats_.allocations, 0u)											\
+			<< "block allocated " << pluto_alloc_stats_.bytes << " bytes";						\
+	} while (0)
+
+#define EXPECT_ALLOCATIONS_LE(n, ...)															\
+	do {																						\
+		pluto::alloc::alloc_scope pluto_alloc_scope_;											\
+		{ __VA_ARGS__ }																			\
+		const auto pluto_alloc_stats_ = pluto_alloc_scope_.stats();								\
+		EXPECT_LE(pluto_alloc_stats_.allocations, static_cast<std::uint64_t>(n))				\
+			<< "block allocated " << pluto_alloc_stats_.bytes << " bytes";						\
+	} while (0)
@@ -0,0 +1,107 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 22:06:51
+ * @brief
+ */
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "common/alloc_counter.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::alloc;
+
+namespace
+{
+
+void* volatile escaped = nullptr;
+
+/* let the pointer escape, so the compiler cannot drop a new / delete pair */
+void escape(void* p)
+{
+	escaped = p;
+}
+
+} // namespace
+
+TEST(PLUTO, COMMON_ALLOC_COUNTER) {
+
+	{
+		alloc_scope scope;
+		auto p = make_unique<int[]>(100);
+		auto q = make_unique<long>(7);
+		escape(q.get());
+		q.reset();
+
+		auto s = scope.stats();
+		EXPECT_EQ(s.allocations, 2u);
+		EXPECT_EQ(s.deallocations, 1u);
+		EXPECT_EQ(s.bytes, 100 * sizeof(int) + sizeof(long));
+		EXPECT_EQ(s.net_bytes(), static_cast<int64_t>(100 * sizeof(int)));
+		TEST_COUT << s.allocations << " allocations, " << s.bytes << " bytes, peak " << s.peak << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// peak is the high-water mark inside the scope, nested scopes keep their own
+		alloc_scope outer;
+		{
+			vector<char> big(4096);
+		}
+		{
+			alloc_scope inner;
+			vector<char> small(64);
+			EXPECT_EQ(inner.stats().peak, 64);
+		}
+		EXPECT_EQ(outer.stats().peak, 4096);
+		EXPECT_EQ(outer.stats().net_bytes(), 0);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// over-aligned new goes through the aligned forms and is counted the same
+		struct alignas(64) line { char c[64]; };
+		alloc_scope scope;
+		auto p = make_unique<line>();
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(p.get()) % 64, 0u);
+		p.reset();
+		EXPECT_EQ(scope.stats().bytes, sizeof(line));
+		EXPECT_EQ(scope.stats().net_bytes(), 0);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// another thread's allocations are not seen by this thread's scope
+		alloc_scope scope;
+		alloc_stats worker;
+		{
+			thread t([&worker] {
+				alloc_scope s;
+				vector<int> v(1000);
+				worker = s.stats();
+			});
+			t.join();
+		}
+		EXPECT_EQ(worker.allocations, 1u);
+		EXPECT_EQ(worker.bytes, 1000 * sizeof(int));
+		TEST_COUT << "this thread: " << scope.stats().allocations << " allocations (the std::thread state)" << endl;
+		EXPECT_LE(scope.stats().allocations, 2u);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		int x = 0;
+		EXPECT_NO_ALLOCATIONS({ x += 1; });
+		EXPECT_ALLOCATIONS_LE(1, { auto p = make_unique<int>(x); escape(p.get()); });
+	}
+}
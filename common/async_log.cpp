@@ -0,0 +1,472 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 23:21:06
+ * @brief
+ */
+
+#include "async_log.h"
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pluto
+{
+namespace logging
+{
+
+namespace detail
+{
+
+namespace
+{
+
+template<class T>
+void append_number(std::string& out, T v)
+{
+	char buf[32];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v);
+	out.append(buf, r.ptr);
+}
+
+/* what an ostream with default flags prints: %g, 6 significant digits */
+void append_double(std::string& out, double v)
+{
+	char buf[64];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::general, 6);
+	out.append(buf, r.ptr);
+}
+
+void append_pointer(std::string& out, std::uint64_t v)
+{
+	if (v == 0)
+	{
+		out += '0';
+		return;
+	}
+	char buf[32];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v, 16);
+	out += "0x";
+	out.append(buf, r.ptr);
+}
+
+/* turn the encoded arguments of one record into text */
+void format(const char* p, const char* end, std::string& out)
+{
+	while (p < end)
+	{
+		const auto t = static_cast<tag>(*p++);
+		std::uint64_t word = 0;
+		switch (t)
+		{
+		case tag::newline:
+			out += '\n';
+			break;
+		case tag::chr:
+			out += *p++;
+			break;
+		case tag::boolean:
+			out += *p++ != 0 ? '1' : '0';
+			break;
+		case tag::str:
+		{
+			std::uint32_t n;
+			std::memcpy(&n, p, sizeof(n));
+			p += sizeof(n);
+			out.append(p, n);
+			p += n;
+			break;
+		}
+		case tag::i64:
+		{
+			std::int64_t i;
+			std::memcpy(&i, p, 8);
+			p += 8;
+			append_number(out, i);
+			break;
+		}
+		case tag::f64:
+		{
+			double d;
+			std::memcpy(&d, p, 8);
+			p += 8;
+			append_double(out, d);
+			break;
+		}
+		case tag::u64:
+			std::memcpy(&word, p, 8);
+			p += 8;
+			append_number(out, word);
+			break;
+		case tag::ptr:
+			std::memcpy(&word, p, 8);
+			p += 8;
+			append_pointer(out, word);
+			break;
+		default:
+			return;	// corrupt, drop the rest of the record
+		}
+	}
+}
+
+void write_stdout(std::string_view text)
+{
+	std::fwrite(text.data(), 1, text.size(), stdout);
+	std::fflush(stdout);
+}
+
+/*
+ * The writer thread and the list of per-thread buffers. Created on the
+ * first log call and never destroyed, only stopped at exit after a last
+ * drain, so threads that log during static destruction cannot touch a
+ * dead object; they write their lines to the sink themselves.
+ */
+class writer
+{
+public:
+	static writer& instance()
+	{
+		static writer* w = new writer;
+		static stopper stop_at_exit{ w };
+		return *w;
+	}
+
+	void add(std::shared_ptr<thread_buffer> b)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffers_.push_back(std::move(b));
+	}
+
+	std::size_t buffer_count()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return buffers_.size();
+	}
+
+	void set_sink(std::function<void(std::string_view)> sink)
+	{
+		std::lock_guard<std::mutex> lock(sink_mutex_);
+		sink_ = sink ? std::move(sink) : write_stdout;
+	}
+
+	/* after stop(): one thread at a time writes a ring out, the writer is gone */
+	void drain_late(thread_buffer& b)
+	{
+		std::lock_guard<std::mutex> lock(late_mutex_);
+		std::string text;
+		b.drain(text);
+		write(text);
+	}
+
+	/* a line from a thread whose ring is gone, written out in the order it came */
+	void write_late(const char* data, std::size_t length)
+	{
+		std::lock_guard<std::mutex> lock(late_mutex_);
+		std::string text;
+		format(data, data + length, text);
+		write(text);
+	}
+
+	/* wait for a whole pass of the writer that started after this call */
+	void flush()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		const std::uint64_t ticket = ++flush_requested_;
+		done_.wait(lock, [&] { return flush_done_ >= ticket || !running_; });
+	}
+
+private:
+	struct stopper
+	{
+		writer* w;
+		~stopper() { w->stop(); }
+	};
+
+	writer() : sink_(write_stdout), thread_([this] { run(); }) {}
+
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		if (thread_.joinable()) thread_.join();
+
+		// lines committed after the writer's last pass are written out here
+		std::lock_guard<std::mutex> late(late_mutex_);
+		writer_stopped.store(true, std::memory_order_seq_cst);
+		std::vector<std::shared_ptr<thread_buffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			buffers = buffers_;
+		}
+		std::string text;
+		for (auto& b : buffers) b->drain(text);
+		write(text);
+	}
+
+	void write(const std::string& text)
+	{
+		if (text.empty()) return;
+		std::lock_guard<std::mutex> lock(sink_mutex_);
+		sink_(text);
+	}
+
+	void run()
+	{
+		std::string text;
+		std::vector<std::shared_ptr<thread_buffer>> buffers;
+		auto idle = std::chrono::microseconds(50);
+
+		for (;;)
+		{
+			std::uint64_t ticket;
+			bool stopping;
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				ticket = flush_requested_;
+				stopping = stopping_;
+				// forget threads that are gone and whose lines are all out
+				std::erase_if(buffers_, [](const auto& b) { return b->abandoned.load() && b->empty(); });
+				buffers = buffers_;
+			}
+
+			bool any = false;
+			for (auto& b : buffers) any |= b->drain(text);
+			write(text);
+			text.clear();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				flush_done_ = ticket;
+			}
+			done_.notify_all();
+
+			if (stopping && !any)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				running_ = false;
+				done_.notify_all();
+				return;
+			}
+
+			// back off while nothing is logged, up to 1 ms between looks
+			idle = any ? std::chrono::microseconds(50) : std::min(idle * 2, std::chrono::microseconds(1000));
+			if (!any && ticket == flush_requested_snapshot()) std::this_thread::sleep_for(idle);
+		}
+	}
+
+	std::uint64_t flush_requested_snapshot()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return flush_requested_;
+	}
+
+	std::mutex mutex_;
+	std::condition_variable done_;
+	std::vector<std::shared_ptr<thread_buffer>> buffers_;
+	std::uint64_t flush_requested_ = 0;
+	std::uint64_t flush_done_ = 0;
+	bool stopping_ = false;
+	bool running_ = true;
+
+	std::mutex sink_mutex_;
+	std::function<void(std::string_view)> sink_;
+
+	std::mutex late_mutex_;
+
+	std::thread thread_;
+};
+
+} // namespace
+
+thread_buffer::thread_buffer() : data_(new char[ring_capacity]) {}
+
+thread_buffer::~thread_buffer()
+{
+	delete[] data_;
+}
+
+void thread_buffer::wait_for_room(std::uint64_t end)
+{
+	for (;;)
+	{
+		cached_head_ = head_.load(std::memory_order_acquire);
+		if (end - cached_head_ <= ring_capacity) return;
+		// nobody left to make room but this thread
+		if (writer_stopped.load(std::memory_order_acquire)) drain_after_stop(*this);
+		else std::this_thread::yield();
+	}
+}
+
+bool thread_buffer::drain(std::string& out)
+{
+	std::uint64_t head = head_.load(std::memory_order_relaxed);
+	const std::uint64_t tail = tail_.load(std::memory_order_seq_cst);
+	if (head == tail) return false;
+
+	while (head != tail)
+	{
+		const char* p = data_ + (head & (ring_capacity - 1));
+		record_header h;
+		std::memcpy(&h, p, sizeof(h));
+		if (h.length != skip_record) format(p + sizeof(h), p + sizeof(h) + h.length, out);
+		head += h.size;
+	}
+	head_.store(head, std::memory_order_release);
+	return true;
+}
+
+void drain_after_stop(thread_buffer& b)
+{
+	writer::instance().drain_late(b);
+}
+
+thread_buffer* register_thread()
+{
+	// trivially destructible, still readable while the thread's other thread_locals and the statics die
+	thread_local bool owner_destroyed = false;
+
+	// keeps the buffer alive with the writer after the thread is gone
+	struct owner
+	{
+		std::shared_ptr<thread_buffer> buffer = std::make_shared<thread_buffer>();
+		~owner()
+		{
+			buffer->abandoned.store(true);
+			local_buffer = nullptr;
+			owner_destroyed = true;
+		}
+	};
+
+	if (owner_destroyed)
+	{
+		// logging from a destructor that runs after owner's: no new ring, the lines go to the
+		// sink from this thread, once the writer has written out what the old ring still holds
+		thread_local bool old_ring_written = false;
+		if (!old_ring_written)
+		{
+			writer::instance().flush();
+			old_ring_written = true;
+		}
+		return nullptr;
+	}
+
+	thread_local owner o;
+	writer::instance().add(o.buffer);
+	local_buffer = o.buffer.get();
+	return o.buffer.get();
+}
+
+void write_encoded(const char* data, std::size_t length)
+{
+	thread_buffer* b = local();
+	if (b == nullptr)
+	{
+		writer::instance().write_late(data, length);
+		return;
+	}
+
+	const std::size_t size = round8(sizeof(record_header) + length);
+	char* p = b->reserve(size);
+	const record_header h{ static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(length) };
+	std::memcpy(p, &h, sizeof(h));
+	std::memcpy(p + sizeof(h), data, length);
+	b->commit();
+}
+
+std::size_t registered_buffers()
+{
+	return writer::instance().buffer_count();
+}
+
+} // detail
+
+line::~line()
+{
+	sync_stream();
+	if (truncated_)
+	{
+		used_ = static_cast<std::size_t>(detail::encode(buf_ + used_, "...") - buf_);
+		buf_[used_++] = static_cast<char>(detail::tag::newline);
+	}
+	if (used_ != 0) detail::write_encoded(buf_, used_);
+}
+
+line::operator std::ostream&()
+{
+	if (!stream_)
+	{
+		stream_buffer_.emplace(*this);
+		stream_.emplace(&*stream_buffer_);
+	}
+	return *stream_;
+}
+
+void line::stream_buffer::write_area()
+{
+	const auto n = static_cast<std::size_t>(pptr() - pbase());
+	if (n == 0) return;
+	owner_.append(std::string_view(pbase(), n));
+	setp(area_, area_ + sizeof(area_));
+}
+
+line::stream_buffer::int_type line::stream_buffer::overflow(int_type c)
+{
+	write_area();
+	if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+	*pptr() = traits_type::to_char_type(c);
+	pbump(1);
+	return c;
+}
+
+std::streamsize line::stream_buffer::xsputn(const char* s, std::streamsize n)
+{
+	if (n <= epptr() - pptr())
+	{
+		traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+		pbump(static_cast<int>(n));
+		return n;
+	}
+	write_area();
+	owner_.append(std::string_view(s, static_cast<std::size_t>(n)));
+	return n;
+}
+
+int line::stream_buffer::sync()
+{
+	write_area();
+	return 0;
+}
+
+line& line::operator<<(std::ostream& (*manip)(std::ostream&))
+{
+	sync_stream();
+	if (manip == static_cast<std::ostream& (*)(std::ostream&)>(std::endl))
+	{
+		// a cut line gets its newline from the destructor
+		if (truncated_) return *this;
+		if (used_ < sizeof(buf_) - 16) buf_[used_++] = static_cast<char>(detail::tag::newline);
+		else truncated_ = true;
+	}
+	return *this;
+}
+
+void flush()
+{
+	detail::writer::instance().flush();
+}
+
+void set_sink(std::function<void(std::string_view)> sink)
+{
+	detail::writer::instance().set_sink(std::move(sink));
+}
+
+} // logging
+} // pluto
@@ -0,0 +1,448 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 23:21:06
+ * @brief
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace pluto
+{
+namespace logging
+{
+
+/*
+ * Asynchronous logging. The calling thread only copies the arguments, in
+ * binary, into a ring buffer of its own; a background writer thread turns
+ * them into text with std::to_chars and writes whole batches to the sink.
+ *
+ *		pluto::logging::log("visited ", n, " values in ", ms, " ms");
+ *		pluto::logging::line() << "[ OUTPUT   ] " << x << std::endl;
+ *
+ * Compared with std::cout << ... << std::endl there is no stream lock, no
+ * locale, no formatting and no write(2) per line on the hot path: a log
+ * call is a few stores of ints / doubles and one memcpy per string.
+ *
+ * Formatting matches an ostream with default flags: integers in decimal,
+ * floating point as %g with 6 digits, bool as 0/1, char as the character,
+ * pointers in hex. Any other type with an operator<< is formatted on the
+ * calling thread into a string first. Manipulators other than std::endl
+ * and std::flush are ignored.
+ *
+ * log() and line() find that operator<< by ADL. An operator<< that is
+ * only visible where line() is used, e.g. through a using-directive
+ * (std::tuple's in cxx17/tuple.h), is still picked by the caller: line
+ * converts to a std::ostream& whose text goes into the line.
+ *
+ * Each thread's lines come out in order; lines of different threads
+ * interleave by batch. std::endl only adds '\n', it does not make the
+ * caller wait; flush() waits until everything the calling thread
+ * logged before it has been handed to the sink. A full ring makes the
+ * logging thread wait for the writer, nothing is dropped. A log() line
+ * longer than max_record bytes is cut and ends in "...". A line() is
+ * collected on the stack in line::capacity bytes, about 1000 characters
+ * of text: a longer one keeps the text that fits and ends in "...".
+ * Once the writer has stopped at exit, and on a thread whose ring was
+ * already destroyed (logging from a later thread_local destructor), each
+ * log call writes its line to the sink itself.
+ *
+ * Compiling with PLUTO_ASYNC_TEST_COUT routes TEST_COUT,
+ * TEST_COUT_DELIMITER and with them fold_expression::printer through
+ * line(), see common/define.h.
+ */
+
+namespace detail
+{
+
+enum class tag : std::uint8_t
+{
+	i64,
+	u64,
+	f64,
+	chr,
+	boolean,
+	ptr,
+	str,
+	newline,
+};
+
+/* record header in the ring: size includes the header and is a multiple of 8 */
+struct record_header
+{
+	std::uint32_t size;
+	std::uint32_t length;	// bytes of encoded arguments, skip_record: wrap to the start
+};
+
+inline constexpr std::uint32_t skip_record = ~std::uint32_t{ 0 };
+
+inline constexpr std::size_t ring_capacity = std::size_t{ 1 } << 16;
+
+/* set at exit once the writer thread is gone; from then on a thread writes out its own lines */
+inline std::atomic<bool> writer_stopped{ false };
+
+class thread_buffer;
+
+/* the writer is gone: hand what b holds to the sink from the calling thread */
+void drain_after_stop(thread_buffer& b);
+
+class thread_buffer
+{
+public:
+	thread_buffer();
+	~thread_buffer();
+
+	/* n is a multiple of 8; returns room for n bytes, waits while the ring is full */
+	char* reserve(std::size_t n)
+	{
+		std::uint64_t pos = tail_.load(std::memory_order_relaxed);
+		const std::size_t room = ring_capacity - static_cast<std::size_t>(pos & (ring_capacity - 1));
+		const std::size_t need = room < n ? room + n : n;
+		if (pos + need - cached_head_ > ring_capacity) wait_for_room(pos + need);
+
+		if (room < n)
+		{
+			// not enough space before the end: a padding record, then start over
+			const record_header pad{ static_cast<std::uint32_t>(room), skip_record };
+			std::memcpy(data_ + (pos & (ring_capacity - 1)), &pad, sizeof(pad));
+			pos += room;
+		}
+		pending_ = pos + n;
+		return data_ + (pos & (ring_capacity - 1));
+	}
+
+	/*
+	 * seq_cst pairs the tail with writer_stopped: either the last sweep
+	 * at exit sees this record or this thread sees the writer is gone
+	 */
+	void commit()
+	{
+		tail_.store(pending_, std::memory_order_seq_cst);
+		if (writer_stopped.load(std::memory_order_seq_cst)) drain_after_stop(*this);
+	}
+
+	/* writer side, appends the formatted text; returns false when nothing was there */
+	bool drain(std::string& out);
+
+	bool empty() const
+	{
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+
+	std::atomic<bool> abandoned{ false };
+
+private:
+	void wait_for_room(std::uint64_t end);
+
+	alignas(64) std::atomic<std::uint64_t> head_{ 0 };	// written by the writer
+	alignas(64) std::atomic<std::uint64_t> tail_{ 0 };	// written by the owner
+	std::uint64_t cached_head_ = 0;
+	std::uint64_t pending_ = 0;
+	char* data_;
+};
+
+/*
+ * The calling thread's buffer, registered with the writer on first use.
+ * nullptr once it was destroyed with the thread's other thread_locals:
+ * a line logged from a later destructor goes to the sink directly.
+ */
+thread_buffer* register_thread();
+
+inline thread_local thread_buffer* local_buffer = nullptr;
+
+inline thread_buffer* local()
+{
+	return local_buffer != nullptr ? local_buffer : register_thread();
+}
+
+template<class T>
+inline constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+template<class T>
+inline constexpr bool is_string_v = std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>;
+
+/* kept as is: arithmetic, strings, pointers; everything else becomes a string through operator<< */
+template<class T>
+inline constexpr bool is_native_v = std::is_arithmetic_v<T> || is_string_v<T> || std::is_pointer_v<T>;
+
+/* an operator<< for T is found from here, i.e. by ADL */
+template<class T, class = void>
+struct is_streamable : std::false_type {};
+
+template<class T>
+struct is_streamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type {};
+
+template<class T>
+inline constexpr bool is_streamable_v = is_streamable<T>::value;
+
+template<class T>
+decltype(auto) prepare(const T& v)
+{
+	if constexpr (is_native_v<T>)
+	{
+		return (v);
+	}
+	else
+	{
+		std::ostringstream os;
+		os << v;
+		return os.str();
+	}
+}
+
+template<class T>
+std::string_view as_string(const T& v)
+{
+	if constexpr (std::is_pointer_v<T>)
+	{
+		if (v == nullptr) return "(null)";
+	}
+	return std::string_view(v);
+}
+
+template<class T>
+std::size_t encoded_size(const T& v)
+{
+	if constexpr (is_string_v<T>) return 1 + sizeof(std::uint32_t) + as_string(v).size();
+	else if constexpr (std::is_same_v<T, bool> || is_char_v<T>) return 2;
+	else return 1 + 8;
+}
+
+template<class T>
+char* encode(char* p, const T& v)
+{
+	auto put = [&p](tag t, const void* src, std::size_t n) {
+		*p++ = static_cast<char>(t);
+		std::memcpy(p, src, n);
+		p += n;
+	};
+
+	if constexpr (is_string_v<T>)
+	{
+		const std::string_view s = as_string(v);
+		const auto n = static_cast<std::uint32_t>(s.size());
+		put(tag::str, &n, sizeof(n));
+		if (n != 0) std::memcpy(p, s.data(), n);	// an empty view may hold nullptr
+		p += n;
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		const char c = v ? 1 : 0;
+		put(tag::boolean, &c, 1);
+	}
+	else if constexpr (is_char_v<T>)
+	{
+		const char c = static_cast<char>(v);
+		put(tag::chr, &c, 1);
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		const double d = static_cast<double>(v);
+		put(tag::f64, &d, 8);
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+	{
+		const std::int64_t i = v;
+		put(tag::i64, &i, 8);
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		const std::uint64_t u = v;
+		put(tag::u64, &u, 8);
+	}
+	else
+	{
+		const auto u = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(v));
+		put(tag::ptr, &u, 8);
+	}
+	return p;
+}
+
+constexpr std::size_t round8(std::size_t n) { return (n + 7) & ~std::size_t{ 7 }; }
+
+/* already encoded arguments as one record */
+void write_encoded(const char* data, std::size_t length);
+
+/* the arguments and a newline as one record */
+template<class... Args>
+void write_record(const Args&... args)
+{
+	const std::size_t length = (std::size_t{ 1 } + ... + encoded_size(args));
+	auto encode_all = [&](char* q) {
+		((q = encode(q, args)), ...);
+		*q = static_cast<char>(tag::newline);
+	};
+
+	thread_buffer* b = local();
+	if (b == nullptr)
+	{
+		// no ring any more, see register_thread()
+		std::string encoded(length, '\0');
+		encode_all(encoded.data());
+		write_encoded(encoded.data(), length);
+		return;
+	}
+
+	const std::size_t size = round8(sizeof(record_header) + length);
+	char* p = b->reserve(size);
+	const record_header h{ static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(length) };
+	std::memcpy(p, &h, sizeof(h));
+	encode_all(p + sizeof(h));
+	b->commit();
+}
+
+/* threads with a ring right now, dead ones drop out once written out; for tests */
+std::size_t registered_buffers();
+
+} // detail
+
+/* the longest record, header included; longer lines are cut */
+inline constexpr std::size_t max_record = detail::ring_capacity / 4;
+
+/* one line: the arguments formatted back to back, then '\n' */
+template<class... Args>
+void log(const Args&... args)
+{
+	[](const auto&... prepared) {
+		if ((std::size_t{ 64 } + ... + detail::encoded_size(prepared)) > max_record)
+		{
+			std::ostringstream os;
+			((os << prepared), ...);
+			std::string text = os.str();
+			// the encoded size overstates the text, it may still fit
+			if (text.size() > max_record - 64)
+			{
+				text.resize(max_record - 64);
+				detail::write_record(text, "...");
+			}
+			else
+			{
+				detail::write_record(text);
+			}
+		}
+		else
+		{
+			detail::write_record(prepared...);
+		}
+	}(detail::prepare(args)...);
+}
+
+/*
+ * Stream syntax: the pieces are collected on the stack and go into the
+ * ring as one record when the line object dies, at the end of the full
+ * expression. A line does not add '\n' by itself, std::endl does.
+ */
+class line
+{
+public:
+	/* bytes of encoded pieces a line holds, a little less of text */
+	static constexpr std::size_t capacity = 1024;
+
+	line() = default;
+	~line();
+
+	line(const line&) = delete;
+	line& operator=(const line&) = delete;
+
+	template<class T, std::enable_if_t<detail::is_native_v<T> || detail::is_streamable_v<T>, int> = 0>
+	line& operator<<(const T& v)
+	{
+		sync_stream();
+		append(detail::prepare(v));
+		return *this;
+	}
+
+	/* for an operator<<(std::ostream&, const T&) only the caller can see, the rest of the chain goes through it */
+	operator std::ostream&();
+
+	/* std::endl ends the text with '\n' but does not wait for the writer, std::flush does nothing */
+	line& operator<<(std::ostream& (*manip)(std::ostream&));
+
+	/* std::boolalpha, std::hex, ... have no effect */
+	line& operator<<(std::ios_base& (*)(std::ios_base&)) { return *this; }
+
+private:
+	/*
+	 * The text written to stream() becomes string pieces of the line.
+	 * Single characters (put, std::endl) collect in a small put area that
+	 * goes in as one piece on sync, when it is full, and before a larger
+	 * write, so they do not cost a piece header each.
+	 */
+	class stream_buffer : public std::streambuf
+	{
+	public:
+		explicit stream_buffer(line& owner) : owner_(owner) { setp(area_, area_ + sizeof(area_)); }
+
+	protected:
+		int_type overflow(int_type c) override;
+		std::streamsize xsputn(const char* s, std::streamsize n) override;
+		int sync() override;
+
+	private:
+		void write_area();
+
+		line& owner_;
+		char area_[64];
+	};
+
+	/* text still in the stream's put area goes in before anything appended after it */
+	void sync_stream()
+	{
+		if (stream_buffer_) stream_buffer_->pubsync();
+	}
+
+	/* 16 bytes stay free for the "..." and newline of a cut line */
+	template<class T>
+	void append(const T& v)
+	{
+		if (truncated_) return;
+		const std::size_t room = sizeof(buf_) - used_ - 16;
+		if (detail::encoded_size(v) <= room)
+		{
+			used_ = static_cast<std::size_t>(detail::encode(buf_ + used_, v) - buf_);
+			return;
+		}
+
+		// keep the part of a string that fits, a number is all or nothing
+		if constexpr (detail::is_string_v<T>)
+		{
+			constexpr std::size_t header = 1 + sizeof(std::uint32_t);
+			if (room > header)
+			{
+				used_ = static_cast<std::size_t>(detail::encode(buf_ + used_, detail::as_string(v).substr(0, room - header)) - buf_);
+			}
+		}
+		truncated_ = true;
+	}
+
+	char buf_[capacity];
+	std::size_t used_ = 0;
+	bool truncated_ = false;
+	std::optional<stream_buffer> stream_buffer_;
+	std::optional<std::ostream> stream_;
+};
+
+/* wait until every line this thread logged so far has reached the sink */
+void flush();
+
+/*
+ * Where the text goes, called on the writer thread with whole batches.
+ * The default (also restored by an empty function) writes to stdout.
+ */
+void set_sink(std::function<void(std::string_view)> sink);
+
+} // logging
+} // pluto
@@ -0,0 +1,61 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 00:14:52
+ * @brief
+ */
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "async_log.h"
+
+using namespace std;
+using namespace pluto;
+
+/* the hot-path cost, the writer formats and discards on its own thread */
+static void BM_AsyncLog(benchmark::State& state)
+{
+	if (state.thread_index() == 0) logging::set_sink([](string_view s) { benchmark::DoNotOptimize(s.data()); });
+	int i = 0;
+	for (auto _ : state)
+	{
+		logging::log("visited ", i++, " values in ", 0.125, " ms");
+	}
+	logging::flush();
+	if (state.thread_index() == 0) logging::set_sink({});
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_AsyncLine(benchmark::State& state)
+{
+	if (state.thread_index() == 0) logging::set_sink([](string_view s) { benchmark::DoNotOptimize(s.data()); });
+	int i = 0;
+	for (auto _ : state)
+	{
+		logging::line() << "visited " << i++ << " values in " << 0.125 << " ms" << std::endl;
+	}
+	logging::flush();
+	if (state.thread_index() == 0) logging::set_sink({});
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* what TEST_COUT and PrintVisitor do: format under the stream, flush every line */
+static void BM_OstreamEndl(benchmark::State& state)
+{
+	static ofstream os("/dev/null");
+	static mutex m;
+	int i = 0;
+	for (auto _ : state)
+	{
+		lock_guard<mutex> lock(m);
+		os << "visited " << i++ << " values in " << 0.125 << " ms" << std::endl;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AsyncLog)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+BENCHMARK(BM_AsyncLine)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+BENCHMARK(BM_OstreamEndl)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
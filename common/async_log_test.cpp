@@ -0,0 +1,281 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 23:58:31
+ * @brief
+ */
+
+#ifndef PLUTO_ASYNC_TEST_COUT
+#define PLUTO_ASYNC_TEST_COUT
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "common/alloc_counter.h"
+#include "common/async_log.h"
+#include "common/child_process.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto;
+
+/* an operator<< ADL cannot find: std::pair's namespace is std, this one is only visible through the using-directive */
+namespace printers
+{
+
+std::ostream& operator<<(std::ostream& os, const std::pair<int, int>& p)
+{
+	return os << '(' << p.first << ", " << p.second << ')';
+}
+
+} // printers
+
+using namespace printers;
+
+namespace
+{
+
+constexpr const char* child_env = "PLUTO_ASYNC_LOG_CHILD";
+constexpr int late_lines = 3000;
+
+/* runs after the writer stopped at exit, logs more than a ring holds */
+void log_after_stop()
+{
+	for (int i = 0; i < late_lines; ++i) logging::log("late ", i, ' ', string(50, '.'));
+}
+
+/* logs from its destructor, which runs after the thread's ring is gone */
+atomic<int64_t> late_heap_growth{ 0 };
+
+struct late_logger
+{
+	int id = -1;
+
+	~late_logger()
+	{
+		if (id < 0) return;
+		alloc::alloc_scope scope;
+		logging::log("late ", id);
+		late_heap_growth += scope.stats().net_bytes();
+	}
+};
+
+thread_local late_logger late_logger_;
+
+/* collects the writer's output instead of printing it */
+struct capture
+{
+	capture()
+	{
+		logging::flush();
+		logging::set_sink([this](string_view s) {
+			lock_guard<mutex> lock(m);
+			text.append(s);
+		});
+	}
+
+	~capture()
+	{
+		logging::flush();
+		logging::set_sink({});
+	}
+
+	string take()
+	{
+		logging::flush();
+		lock_guard<mutex> lock(m);
+		return std::exchange(text, string());
+	}
+
+	mutex m;
+	string text;
+};
+
+} // namespace
+
+TEST(PLUTO, COMMON_ASYNC_LOG) {
+
+	if (getenv(child_env) != nullptr)
+	{
+		// registered before the first log call creates the writer, so it runs after the writer stopped
+		std::atexit(log_after_stop);
+		logging::log("child started");
+		std::exit(0);
+	}
+
+	{
+		// formatted later, the same text an ostream with default flags would give
+		capture c;
+		const string s2 = "s2";
+		const void* p = &s2;
+		logging::log(42, ' ', -7, ' ', 3.14, ' ', 1.0 / 3, ' ', 2.5f, ' ', 1e20, ' ', true, ' ', "str", ' ', s2,
+			' ', 18446744073709551615ull, ' ', p, ' ', complex<double>(1, 2));
+
+		ostringstream expected;
+		expected << 42 << ' ' << -7 << ' ' << 3.14 << ' ' << 1.0 / 3 << ' ' << 2.5f << ' ' << 1e20 << ' ' << true
+			<< ' ' << "str" << ' ' << s2 << ' ' << 18446744073709551615ull << ' ' << p << ' ' << complex<double>(1, 2) << '\n';
+		EXPECT_EQ(c.take(), expected.str());
+	}
+
+	{
+		// stream syntax: TEST_COUT goes through logging::line() in this file
+		capture c;
+		TEST_COUT << "x = " << 1 << ", y = " << 2.0 << endl;
+		TEST_COUT_DELIMITER;
+		TEST_COUT << "no newline";
+		TEST_COUT << ", continued" << std::endl;
+		EXPECT_EQ(c.take(), "[ OUTPUT   ] x = 1, y = 2\n"
+			"[ OUTPUT   ] ----------------------------------------\n"
+			"[ OUTPUT   ] no newline[ OUTPUT   ] , continued\n");
+
+		// the fold in fold_expression::printer: (TEST_COUT << ... << args) << std::endl
+		[](auto&&... args) { (TEST_COUT << ... << args) << std::endl; }(6, " is ", 2.5, '!');
+		EXPECT_EQ(c.take(), "[ OUTPUT   ] 6 is 2.5!\n");
+
+		// the caller's operator<<, the rest of the line goes through the ostream it returns
+		TEST_COUT << "p = " << pair{ 1, 2 } << ", done " << 3 << endl;
+		EXPECT_EQ(c.take(), "[ OUTPUT   ] p = (1, 2), done 3\n");
+
+		// characters written one at a time through that ostream share pieces, the line keeps them all
+		{
+			logging::line l;
+			ostream& os = l;
+			os << pair{ 3, 4 };
+			for (int i = 0; i < 600; ++i) os.put('x');
+			os << std::endl;
+		}
+		EXPECT_EQ(c.take(), "(3, 4)" + string(600, 'x') + "\n");
+	}
+
+	{
+		// lines longer than the line buffer keep the text that fits
+		capture c;
+		logging::line() << "x = " << string(5000, 'a') << 42 << std::endl;
+		const string out = c.take();
+		EXPECT_GT(out.size(), logging::line::capacity - 32);
+		EXPECT_LT(out.size(), logging::line::capacity);
+		EXPECT_EQ(out.substr(0, 4), "x = ");
+		EXPECT_EQ(out.substr(4, out.size() - 8), string(out.size() - 8, 'a'));
+		EXPECT_EQ(out.substr(out.size() - 4), "...\n");
+
+		logging::log(string(100000, 'b'));
+		const string long_out = c.take();
+		EXPECT_LT(long_out.size(), logging::max_record);
+		EXPECT_EQ(long_out.substr(long_out.size() - 4), "...\n");
+
+		// encoded over max_record, formatted under it: written whole, not cut
+		const string payload(logging::max_record - 94, 'x');
+		logging::log("payload: ", payload, " n=", 7);
+		EXPECT_EQ(c.take(), "payload: " + payload + " n=7\n");
+	}
+
+	{
+		// every thread's lines arrive complete and in order, through many ring wraps
+		capture c;
+		constexpr int threads = 4, lines = 20000;
+		vector<thread> ts;
+		for (int t = 0; t < threads; ++t)
+		{
+			ts.emplace_back([t] {
+				for (int i = 0; i < lines; ++i) logging::log(t, ' ', i);
+				logging::flush();
+			});
+		}
+		for (auto& t : ts) t.join();
+
+		istringstream in(c.take());
+		vector<int> next(threads, 0);
+		int t = 0, i = 0, bad = 0, total = 0;
+		while (in >> t >> i)
+		{
+			if (t < 0 || t >= threads || next[t] != i) ++bad;
+			else ++next[t];
+			++total;
+		}
+		EXPECT_EQ(bad, 0);
+		EXPECT_EQ(total, threads * lines);
+	}
+
+	{
+		// lines logged after the thread's ring is gone go to the sink directly, no ring is kept for them
+		capture c;
+		logging::flush();
+		logging::flush();
+		const size_t rings = logging::detail::registered_buffers();
+		late_heap_growth = 0;
+
+		constexpr int threads = 200;
+		for (int t = 0; t < threads; ++t)
+		{
+			thread([t] {
+				late_logger_.id = t;
+				logging::log("early ", t);
+			}).join();
+		}
+
+		// a pass writes the dead threads' rings out, the next one drops them
+		logging::flush();
+		logging::flush();
+		EXPECT_LE(logging::detail::registered_buffers(), rings);
+		// only the capture's text grows, a ring per thread would be 200 * 64 KB
+		EXPECT_LT(late_heap_growth.load(), static_cast<int64_t>(logging::detail::ring_capacity));
+
+		// and each thread's late line comes after its early one
+		istringstream in(c.take());
+		vector<int> seen(threads, 0);
+		string word;
+		int t = 0, bad = 0;
+		while (in >> word >> t)
+		{
+			if (t < 0 || t >= threads) ++bad;
+			else if (word == "early" && seen[t] == 0) seen[t] = 1;
+			else if (word == "late" && seen[t] == 1) seen[t] = 2;
+			else ++bad;
+		}
+		EXPECT_EQ(bad, 0);
+		EXPECT_EQ(std::count(seen.begin(), seen.end(), 2), threads);
+	}
+
+#if defined(__linux__)
+	{
+		// a copy of this test binary logs from an atexit handler that runs after the writer stopped
+		const string out_path = "/tmp/pluto_async_log_test_" + to_string(getpid()) + ".txt";
+		const int child = child_process::spawn_self("PLUTO.COMMON_ASYNC_LOG", string(child_env) + "=1", out_path);
+		ASSERT_GT(child, 0);
+		const int status = child_process::wait(child, chrono::seconds(10));
+		ASSERT_NE(status, child_process::hung) << "logging after the writer stopped hung";
+		EXPECT_EQ(status, 0);
+
+		ifstream in(out_path);
+		int late = 0, bad = 0;
+		for (string l; getline(in, l);)
+		{
+			if (l.rfind("late ", 0) != 0) continue;
+			bad += l != "late " + to_string(late) + ' ' + string(50, '.');
+			++late;
+		}
+		in.close();
+		std::remove(out_path.c_str());
+		EXPECT_EQ(late, late_lines);
+		EXPECT_EQ(bad, 0);
+	}
+#endif
+}
@@ -0,0 +1,507 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:31:52
+ * @brief
+ */
+
+#include "bench_regression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace pluto
+{
+namespace bench
+{
+
+namespace
+{
+
+bool parse_double(const std::string& s, double& out)
+{
+	if (s.empty()) return false;
+	char* end = nullptr;
+	out = std::strtod(s.c_str(), &end);
+	return end == s.c_str() + s.size();
+}
+
+/* nanoseconds per console time unit, 0 if s is not a unit */
+double unit_scale(const std::string& s)
+{
+	if (s == "ns") return 1.0;
+	if (s == "us") return 1e3;
+	if (s == "ms") return 1e6;
+	if (s == "s") return 1e9;
+	return 0.0;
+}
+
+bool is_aggregate(const std::string& name)
+{
+	for (const char* suffix : { "_mean", "_median", "_stddev", "_cv", "_BigO", "_RMS" })
+	{
+		const std::size_t n = std::char_traits<char>::length(suffix);
+		if (name.size() > n && name.compare(name.size() - n, n, suffix) == 0) return true;
+	}
+	return false;
+}
+
+std::string strip_color(const std::string& line)
+{
+	std::string out;
+	out.reserve(line.size());
+	for (std::size_t i = 0; i < line.size(); ++i)
+	{
+		if (line[i] == '\x1b')
+		{
+			while (i < line.size() && line[i] != 'm') ++i;
+			continue;
+		}
+		out += line[i];
+	}
+	return out;
+}
+
+/*
+ * Just enough JSON for what the JSON reporter writes: the "benchmarks"
+ * array of flat objects, everything else is skipped.
+ */
+class json_reader
+{
+public:
+	explicit json_reader(std::string text) : s_(std::move(text)) {}
+
+	bool read_benchmarks(sample_map& samples)
+	{
+		if (!consume('{')) return false;
+		if (consume('}')) return true;
+		do
+		{
+			std::string key;
+			if (!read_string(key) || !consume(':')) return false;
+			if (key != "benchmarks")
+			{
+				if (!skip_value()) return false;
+				continue;
+			}
+
+			if (!consume('[')) return false;
+			if (consume(']')) continue;
+			do
+			{
+				std::map<std::string, std::string> fields;
+				if (!read_flat_object(fields)) return false;
+				add_run(fields, samples);
+			} while (consume(','));
+			if (!consume(']')) return false;
+		} while (consume(','));
+		return consume('}');
+	}
+
+private:
+	static void add_run(const std::map<std::string, std::string>& fields, sample_map& samples)
+	{
+		auto field = [&fields](const char* key) {
+			auto it = fields.find(key);
+			return it == fields.end() ? std::string() : it->second;
+		};
+
+		double real = 0.0, iterations = 0.0;
+		const double scale = unit_scale(field("time_unit").empty() ? "ns" : field("time_unit"));
+		if (field("run_type") == "aggregate" || field("error_occurred") == "true") return;
+		if (!parse_double(field("real_time"), real) || !parse_double(field("iterations"), iterations)) return;
+		if (scale == 0.0 || iterations == 0.0 || is_aggregate(field("name"))) return;
+
+		samples[field("name")].push_back(real * scale);
+	}
+
+	void skip_space()
+	{
+		while (i_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[i_]))) ++i_;
+	}
+
+	bool consume(char c)
+	{
+		skip_space();
+		if (i_ < s_.size() && s_[i_] == c)
+		{
+			++i_;
+			return true;
+		}
+		return false;
+	}
+
+	bool read_string(std::string& out)
+	{
+		if (!consume('"')) return false;
+		out.clear();
+		while (i_ < s_.size() && s_[i_] != '"')
+		{
+			char c = s_[i_++];
+			if (c == '\\' && i_ < s_.size())
+			{
+				c = s_[i_++];
+				switch (c)
+				{
+				case 'b': c = '\b'; break;
+				case 'f': c = '\f'; break;
+				case 'n': c = '\n'; break;
+				case 'r': c = '\r'; break;
+				case 't': c = '\t'; break;
+				case 'u':
+					if (i_ + 4 > s_.size()) return false;
+					c = static_cast<char>(std::strtol(s_.substr(i_, 4).c_str(), nullptr, 16));
+					i_ += 4;
+					break;
+				default: break;		// \" \\ \/
+				}
+			}
+			out += c;
+		}
+		return consume('"');
+	}
+
+	/* a number, true, false or null, as written */
+	bool read_literal(std::string& out)
+	{
+		skip_space();
+		const std::size_t begin = i_;
+		while (i_ < s_.size() && s_[i_] != ',' && s_[i_] != '}' && s_[i_] != ']'
+			&& !std::isspace(static_cast<unsigned char>(s_[i_]))) ++i_;
+		out = s_.substr(begin, i_ - begin);
+		return !out.empty();
+	}
+
+	bool skip_value()
+	{
+		skip_space();
+		if (i_ >= s_.size()) return false;
+		std::string ignored;
+		if (s_[i_] == '"') return read_string(ignored);
+		if (s_[i_] != '{' && s_[i_] != '[') return read_literal(ignored);
+
+		const char close = s_[i_] == '{' ? '}' : ']';
+		++i_;
+		if (consume(close)) return true;
+		do
+		{
+			if (close == '}' && (!read_string(ignored) || !consume(':'))) return false;
+			if (!skip_value()) return false;
+		} while (consume(','));
+		return consume(close);
+	}
+
+	/* the string and literal members of an object, nested values are skipped */
+	bool read_flat_object(std::map<std::string, std::string>& fields)
+	{
+		if (!consume('{')) return false;
+		if (consume('}')) return true;
+		do
+		{
+			std::string key, value;
+			if (!read_string(key) || !consume(':')) return false;
+			skip_space();
+			if (i_ < s_.size() && s_[i_] == '"')
+			{
+				if (!read_string(value)) return false;
+			}
+			else if (i_ < s_.size() && (s_[i_] == '{' || s_[i_] == '['))
+			{
+				if (!skip_value()) return false;
+				continue;
+			}
+			else if (!read_literal(value)) return false;
+			fields[key] = value;
+		} while (consume(','));
+		return consume('}');
+	}
+
+	std::string s_;
+	std::size_t i_ = 0;
+};
+
+} // namespace
+
+sample_map parse_console_output(std::istream& in)
+{
+	sample_map samples;
+	std::string line;
+	while (std::getline(in, line))
+	{
+		std::istringstream row(strip_color(line));
+		std::vector<std::string> tok;
+		for (std::string t; row >> t;) tok.push_back(t);
+
+		// <name...> <real> <unit> <cpu> <unit> <iterations> [counters...]
+		double real = 0, cpu = 0;
+		for (std::size_t i = 1; i + 3 < tok.size(); ++i)
+		{
+			const double scale = unit_scale(tok[i + 1]);
+			if (scale == 0.0 || unit_scale(tok[i + 3]) == 0.0) continue;
+			if (!parse_double(tok[i], real) || !parse_double(tok[i + 2], cpu)) continue;
+
+			std::string name = tok[0];
+			for (std::size_t j = 1; j < i; ++j) name += ' ' + tok[j];
+			if (!is_aggregate(name)) samples[name].push_back(real * scale);
+			break;
+		}
+	}
+	return samples;
+}
+
+sample_map parse_json_output(std::istream& in)
+{
+	std::ostringstream text;
+	text << in.rdbuf();
+
+	sample_map samples;
+	if (!json_reader(text.str()).read_benchmarks(samples)) samples.clear();
+	return samples;
+}
+
+sample_map read_baseline(std::istream& in, int& digits)
+{
+	in >> std::ws;
+	if (in.peek() == '{')
+	{
+		digits = 0;
+		return parse_json_output(in);
+	}
+	digits = console_digits;
+	return parse_console_output(in);
+}
+
+void round_samples(sample_map& samples, int digits)
+{
+	for (auto& [name, values] : samples)
+	{
+		for (double& v : values)
+		{
+			if (v == 0.0 || !std::isfinite(v)) continue;
+			// scale by a power of ten that is exact, 10^-k is not
+			const int e = digits - 1 - static_cast<int>(std::floor(std::log10(std::fabs(v))));
+			const double scale = std::pow(10.0, std::abs(e));
+			v = e >= 0 ? std::round(v * scale) / scale : std::round(v / scale) * scale;
+		}
+	}
+}
+
+mann_whitney_result mann_whitney(const std::vector<double>& a, const std::vector<double>& b)
+{
+	const std::size_t n1 = a.size(), n2 = b.size(), n = n1 + n2;
+	if (n1 == 0 || n2 == 0) return { 0.0, 0.0, 1.0 };
+
+	// rank the pooled samples, ties get the average rank
+	std::vector<std::pair<double, bool>> pooled;
+	pooled.reserve(n);
+	for (double x : a) pooled.emplace_back(x, true);
+	for (double x : b) pooled.emplace_back(x, false);
+	std::sort(pooled.begin(), pooled.end(),
+		[](const auto& l, const auto& r) { return l.first < r.first; });
+
+	double rank_sum_a = 0.0, tie_term = 0.0;
+	for (std::size_t i = 0; i < n;)
+	{
+		std::size_t j = i;
+		while (j < n && pooled[j].first == pooled[i].first) ++j;
+		const double rank = (static_cast<double>(i + j) + 1.0) / 2.0;	// ranks i+1 .. j
+		for (std::size_t k = i; k < j; ++k) if (pooled[k].second) rank_sum_a += rank;
+		const double t = static_cast<double>(j - i);
+		tie_term += t * t * t - t;
+		i = j;
+	}
+
+	const double dn1 = static_cast<double>(n1), dn2 = static_cast<double>(n2), dn = static_cast<double>(n);
+	const double u = rank_sum_a - dn1 * (dn1 + 1.0) / 2.0;
+	const double mu = dn1 * dn2 / 2.0;
+	const double sigma = std::sqrt(dn1 * dn2 / 12.0 * ((dn + 1.0) - tie_term / (dn * (dn - 1.0))));
+	if (sigma == 0.0) return { u, 0.0, 1.0 };
+
+	const double diff = u - mu;
+	const double z = (diff - std::copysign(std::min(0.5, std::fabs(diff)), diff)) / sigma;
+	return { u, z, std::erfc(std::fabs(z) / std::sqrt(2.0)) };
+}
+
+double median(std::vector<double> v)
+{
+	if (v.empty()) return 0.0;
+	const std::size_t mid = v.size() / 2;
+	std::nth_element(v.begin(), v.begin() + mid, v.end());
+	if (v.size() % 2 != 0) return v[mid];
+	const double hi = v[mid];
+	return (*std::max_element(v.begin(), v.begin() + mid) + hi) / 2.0;
+}
+
+bool threshold_list::parse(const std::string& spec)
+{
+	std::istringstream in(spec);
+	for (std::string item; std::getline(in, item, ',');)
+	{
+		const std::size_t colon = item.rfind(':');
+		double percent = 0.0;
+		if (colon == std::string::npos)
+		{
+			if (!parse_double(item, percent) || percent < 0.0) return false;
+			default_ = percent / 100.0;
+		}
+		else
+		{
+			if (colon == 0 || !parse_double(item.substr(colon + 1), percent) || percent < 0.0) return false;
+			prefixes_.emplace_back(item.substr(0, colon), percent / 100.0);
+		}
+	}
+	return true;
+}
+
+double threshold_list::get(const std::string& name) const
+{
+	double value = default_;
+	std::size_t best = 0;
+	for (const auto& [prefix, fraction] : prefixes_)
+	{
+		if (prefix.size() > best && name.compare(0, prefix.size(), prefix) == 0)
+		{
+			best = prefix.size();
+			value = fraction;
+		}
+	}
+	return value;
+}
+
+const char* verdict_name(verdict v)
+{
+	switch (v)
+	{
+	case verdict::same: return "same";
+	case verdict::faster: return "faster";
+	case verdict::slower: return "slower";
+	case verdict::regression: return "REGRESSION";
+	case verdict::added: return "new";
+	case verdict::missing: return "missing";
+	}
+	return "?";
+}
+
+std::vector<comparison> compare(const sample_map& base, const sample_map& now,
+	const threshold_list& thresholds, double alpha)
+{
+	std::vector<comparison> rows;
+	for (const auto& [name, samples] : now)
+	{
+		comparison c{ name, 0.0, median(samples), 0.0, 1.0, thresholds.get(name), verdict::added };
+		auto it = base.find(name);
+		if (it != base.end() && !it->second.empty())
+		{
+			c.base_ns = median(it->second);
+			c.delta = c.base_ns > 0.0 ? c.now_ns / c.base_ns - 1.0 : 0.0;
+			c.p = mann_whitney(it->second, samples).p;
+
+			if (c.p >= alpha) c.result = verdict::same;
+			else if (c.delta > c.threshold) c.result = verdict::regression;
+			else if (c.delta < -c.threshold) c.result = verdict::faster;
+			else if (c.delta > 0.0) c.result = verdict::slower;
+			else c.result = verdict::same;
+		}
+		rows.push_back(c);
+	}
+	for (const auto& [name, samples] : base)
+	{
+		if (now.count(name) == 0)
+		{
+			rows.push_back({ name, median(samples), 0.0, 0.0, 1.0, thresholds.get(name), verdict::missing });
+		}
+	}
+	return rows;
+}
+
+std::size_t print_report(std::ostream& os, const std::vector<comparison>& rows)
+{
+	std::size_t width = 9;
+	for (const auto& r : rows) width = std::max(width, r.name.size());
+
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+	os << std::left << std::setw(static_cast<int>(width)) << "Benchmark" << std::right
+		<< std::setw(14) << "base ns" << std::setw(14) << "new ns"
+		<< std::setw(10) << "delta" << std::setw(10) << "p" << std::setw(8) << "limit" << "  verdict\n";
+	os << std::string(width + 70, '-') << '\n';
+
+	std::size_t regressions = 0;
+	for (const auto& r : rows)
+	{
+		os << std::left << std::setw(static_cast<int>(width)) << r.name << std::right << std::fixed;
+		if (r.result == verdict::added) os << std::setw(14) << "-";
+		else os << std::setw(14) << std::setprecision(2) << r.base_ns;
+		if (r.result == verdict::missing) os << std::setw(14) << "-";
+		else os << std::setw(14) << std::setprecision(2) << r.now_ns;
+
+		if (r.result == verdict::added || r.result == verdict::missing)
+		{
+			os << std::setw(10) << "-" << std::setw(10) << "-";
+		}
+		else
+		{
+			std::ostringstream delta;
+			delta << std::showpos << std::fixed << std::setprecision(1) << r.delta * 100.0 << '%';
+			os << std::setw(10) << delta.str() << std::setw(10) << std::setprecision(4) << r.p;
+		}
+		std::ostringstream limit;
+		limit << std::fixed << std::setprecision(0) << r.threshold * 100.0 << '%';
+		os << std::setw(8) << limit.str() << "  " << verdict_name(r.result) << '\n';
+
+		if (r.result == verdict::regression) ++regressions;
+	}
+	os << std::string(width + 70, '-') << '\n'
+		<< regressions << " regression(s) in " << rows.size() << " benchmark(s)\n";
+	os.flags(flags);
+	os.precision(precision);
+	return regressions;
+}
+
+bool parse_cpu_list(const std::string& spec, std::vector<int>& cpus)
+{
+	cpus.clear();
+	std::istringstream in(spec);
+	for (std::string item; std::getline(in, item, ',');)
+	{
+		const std::size_t dash = item.find('-');
+		double first = 0, last = 0;
+		if (!parse_double(item.substr(0, dash), first)) return false;
+		if (dash == std::string::npos) last = first;
+		else if (!parse_double(item.substr(dash + 1), last)) return false;
+
+		if (first < 0 || last < first || first != std::floor(first) || last != std::floor(last)) return false;
+		for (int cpu = static_cast<int>(first); cpu <= static_cast<int>(last); ++cpu) cpus.push_back(cpu);
+	}
+	return !cpus.empty();
+}
+
+bool pin_to_cpus(const std::vector<int>& cpus)
+{
+#if defined(__linux__)
+	if (cpus.empty()) return false;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus)
+	{
+		if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+		CPU_SET(cpu, &set);
+	}
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpus;
+	return false;
+#endif
+}
+
+} // bench
+} // pluto
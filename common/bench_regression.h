@@ -0,0 +1,143 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:31:52
+ * @brief
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pluto
+{
+namespace bench
+{
+
+/*
+ * Performance regression check for cxx_features_bench.
+ *
+ * Record a baseline, the JSON output of a run with repetitions:
+ *
+ *		cxx_features_bench --pluto_cpu=2-5 --pluto_save_baseline=baseline.json
+ *
+ * and later compare a new run against it:
+ *
+ *		cxx_features_bench --pluto_cpu=2-5 --pluto_baseline=baseline.json
+ *			--pluto_threshold=5,BM_Visit:10 --benchmark_filter=Visit
+ *
+ * Every benchmark runs --benchmark_repetitions times (10 unless given).
+ * For each benchmark found in both runs, the repetitions of the baseline
+ * and of the new run are compared with a two-sided Mann-Whitney U test.
+ * It only looks at ranks, so one noisy repetition does not hide or fake
+ * a change the way it shifts a mean. A benchmark regresses when
+ *
+ *		p < alpha  &&  median(new) > median(base) * (1 + threshold)
+ *
+ * and the process then exits with 2. The threshold list is a default
+ * percentage followed by name_prefix:percent overrides, the longest
+ * matching prefix wins.
+ *
+ * The baseline file is what the JSON reporter writes (--benchmark_out),
+ * with every time at full precision, so the bench_result.json of any run
+ * with repetitions is a baseline too. Console output captured with
+ * `> bench_output.txt` is accepted as well, but it prints about 3
+ * significant digits: both sides are then rounded to 3 digits before the
+ * test, so they are compared at the same precision. Aggregate entries
+ * (_mean, _median, _stddev, _cv) are skipped in both formats.
+ *
+ * --pluto_cpu takes a cpu list, "2" or "2-5,8". Benchmark threads inherit
+ * the set, so give at least as many cpus as the widest ThreadRange runs.
+ */
+
+/* real time per iteration in nanoseconds, one entry per repetition */
+using sample_map = std::map<std::string, std::vector<double>>;
+
+/* read the repetitions out of console reporter output */
+sample_map parse_console_output(std::istream& in);
+
+/* read the repetitions out of JSON reporter output */
+sample_map parse_json_output(std::istream& in);
+
+/* significant digits the console reporter prints at least */
+inline constexpr int console_digits = 3;
+
+/*
+ * Either format, told apart by its first character. digits is 0 for
+ * JSON, console_digits for console text.
+ */
+sample_map read_baseline(std::istream& in, int& digits);
+
+/* round every sample to digits significant digits */
+void round_samples(sample_map& samples, int digits);
+
+struct mann_whitney_result
+{
+	double u;	// U statistic of the first sample
+	double z;	// normal approximation, tie and continuity corrected
+	double p;	// two-sided p-value
+};
+
+mann_whitney_result mann_whitney(const std::vector<double>& a, const std::vector<double>& b);
+
+double median(std::vector<double> v);
+
+/* "5,BM_Visit:10,BM_Any:20" */
+class threshold_list
+{
+public:
+	explicit threshold_list(double default_percent = 5.0) : default_(default_percent / 100.0) {}
+
+	/* false on a malformed list */
+	bool parse(const std::string& spec);
+
+	/* allowed slowdown as a fraction, 0.05 for 5% */
+	double get(const std::string& name) const;
+
+private:
+	double default_;
+	std::vector<std::pair<std::string, double>> prefixes_;
+};
+
+enum class verdict
+{
+	same,		// not significant, or within the threshold
+	faster,		// significant and faster by more than the threshold
+	slower,		// significant but within the threshold
+	regression,	// significant and slower by more than the threshold
+	added,		// only in the new run
+	missing,	// only in the baseline, e.g. filtered out
+};
+
+const char* verdict_name(verdict v);
+
+struct comparison
+{
+	std::string name;
+	double base_ns;		// median of the baseline repetitions
+	double now_ns;		// median of the new repetitions
+	double delta;		// now / base - 1
+	double p;
+	double threshold;
+	verdict result;
+};
+
+std::vector<comparison> compare(const sample_map& base, const sample_map& now,
+	const threshold_list& thresholds, double alpha);
+
+/* one row per benchmark, returns the number of regressions */
+std::size_t print_report(std::ostream& os, const std::vector<comparison>& rows);
+
+/* "2" or "0-3,8", false on a malformed list */
+bool parse_cpu_list(const std::string& spec, std::vector<int>& cpus);
+
+/* bind the process, and every thread it starts, to cpus; false where that is not supported */
+bool pin_to_cpus(const std::vector<int>& cpus);
+
+} // bench
+} // pluto
@@ -0,0 +1,232 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:31:52
+ * @brief
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "common/bench_regression.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::bench;
+
+namespace
+{
+
+const char* console_dump = R"(2026-10-19T20:31:52+00:00
+Running ./cxx_features_bench
+Run on (8 X 3000 MHz CPU s)
+CPU Caches:
+  L1 Data 32 KiB (x4)
+Load Average: 0.52, 0.58, 0.59
+---------------------------------------------------------------------------------
+Benchmark                                       Time             CPU   Iterations
+---------------------------------------------------------------------------------
+BM_Visit/8                                   12.3 ns         12.3 ns     56789012
+BM_Visit/8                                   12.5 ns         12.4 ns     56789012
+BM_Visit/8_mean                              12.4 ns         12.4 ns            2
+BM_Visit/8_median                            12.4 ns         12.4 ns            2
+BM_Visit/8_stddev                           0.141 ns        0.071 ns            2
+BM_Visit/8_cv                                1.14 %          0.57 %             2
+BM_Fold/1024/threads:4                       1.25 us         4.98 us       140000 items_per_second=205.6M/s
+BM_Sleep                                      100 ms        0.012 ms            7
+)";
+
+const char* json_dump = R"({
+  "context": {
+    "date": "2026-10-19T20:31:52+00:00",
+    "executable": "./cxx_features_bench",
+    "num_cpus": 8,
+    "caches": [
+      { "type": "Data", "level": 1, "size": 32768, "num_sharing": 2 }
+    ],
+    "load_avg": [0.52, 0.58, 0.59],
+    "library_build_type": "release"
+  },
+  "benchmarks": [
+    {
+      "name": "BM_Visit/8",
+      "run_name": "BM_Visit/8",
+      "run_type": "iteration",
+      "repetitions": 2,
+      "repetition_index": 0,
+      "threads": 1,
+      "iterations": 56789012,
+      "real_time": 1.2345678901234567e+01,
+      "cpu_time": 1.2300000000000001e+01,
+      "time_unit": "ns"
+    },
+    {
+      "name": "BM_Visit/8",
+      "run_name": "BM_Visit/8",
+      "run_type": "iteration",
+      "repetitions": 2,
+      "repetition_index": 1,
+      "threads": 1,
+      "iterations": 56789012,
+      "real_time": 1.2500000000000000e+01,
+      "cpu_time": 1.2400000000000000e+01,
+      "time_unit": "ns"
+    },
+    {
+      "name": "BM_Visit/8_mean",
+      "run_name": "BM_Visit/8",
+      "run_type": "aggregate",
+      "aggregate_name": "mean",
+      "iterations": 2,
+      "real_time": 1.2422839450617284e+01,
+      "cpu_time": 1.2350000000000000e+01,
+      "time_unit": "ns"
+    },
+    {
+      "name": "BM_Fold/1024/threads:4",
+      "run_name": "BM_Fold/1024/threads:4",
+      "run_type": "iteration",
+      "iterations": 140000,
+      "real_time": 1.2512345678901234e+00,
+      "cpu_time": 4.9800000000000004e+00,
+      "time_unit": "us",
+      "items_per_second": 2.0560000000000000e+08
+    },
+    {
+      "name": "BM_Broken",
+      "run_name": "BM_Broken",
+      "run_type": "iteration",
+      "error_occurred": true,
+      "error_message": "quote \" and \\ in a message",
+      "iterations": 0,
+      "real_time": 0.0000000000000000e+00,
+      "cpu_time": 0.0000000000000000e+00,
+      "time_unit": "ns"
+    }
+  ]
+}
+)";
+
+} // namespace
+
+TEST(PLUTO, COMMON_BENCH_REGRESSION) {
+
+	{
+		// textbook values, asymptotic two-sided test with continuity correction
+		auto r = mann_whitney({ 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10 });
+		EXPECT_DOUBLE_EQ(r.u, 0.0);
+		EXPECT_NEAR(r.z, -2.5067182, 1e-6);
+		EXPECT_NEAR(r.p, 0.0121858, 1e-6);
+
+		// the other order mirrors U and z, keeps p
+		r = mann_whitney({ 6, 7, 8, 9, 10 }, { 1, 2, 3, 4, 5 });
+		EXPECT_DOUBLE_EQ(r.u, 25.0);
+		EXPECT_NEAR(r.p, 0.0121858, 1e-6);
+
+		// ties take the average rank and shrink the variance
+		r = mann_whitney({ 1, 2, 2, 3, 5 }, { 2, 3, 4, 6, 7, 8 });
+		EXPECT_DOUBLE_EQ(r.u, 5.5);
+		EXPECT_NEAR(r.z, -1.6621645, 1e-6);
+		EXPECT_NEAR(r.p, 0.0964798, 1e-6);
+
+		// the same samples are never different
+		EXPECT_DOUBLE_EQ(mann_whitney({ 3, 1, 2 }, { 1, 2, 3 }).p, 1.0);
+		EXPECT_DOUBLE_EQ(mann_whitney({ 4, 4 }, { 4, 4, 4 }).p, 1.0);
+		EXPECT_DOUBLE_EQ(mann_whitney({}, { 1 }).p, 1.0);
+
+		EXPECT_DOUBLE_EQ(median({ 3, 1, 2 }), 2.0);
+		EXPECT_DOUBLE_EQ(median({ 4, 1, 3, 2 }), 2.5);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		istringstream in(console_dump);
+		const sample_map s = parse_console_output(in);
+		for (const auto& [name, v] : s) TEST_COUT << name << " x" << v.size() << endl;
+
+		ASSERT_EQ(s.size(), 3u);
+		EXPECT_EQ(s.at("BM_Visit/8"), (vector<double>{ 12.3, 12.5 }));
+		EXPECT_EQ(s.at("BM_Fold/1024/threads:4"), (vector<double>{ 1250.0 }));
+		EXPECT_EQ(s.at("BM_Sleep"), (vector<double>{ 1e8 }));
+
+		// read_baseline tells the formats apart, console text is rounded
+		istringstream again(console_dump);
+		int digits = -1;
+		EXPECT_EQ(read_baseline(again, digits), s);
+		EXPECT_EQ(digits, console_digits);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		istringstream in(json_dump);
+		int digits = -1;
+		const sample_map s = read_baseline(in, digits);
+		EXPECT_EQ(digits, 0);
+
+		// every digit survives, aggregates and failed runs are left out
+		ASSERT_EQ(s.size(), 2u);
+		EXPECT_EQ(s.at("BM_Visit/8"), (vector<double>{ 12.345678901234567, 12.5 }));
+		EXPECT_DOUBLE_EQ(s.at("BM_Fold/1024/threads:4").at(0), 1251.2345678901234);
+
+		istringstream broken("{ \"benchmarks\": [ { \"name\": ");
+		EXPECT_TRUE(parse_json_output(broken).empty());
+
+		// rounding to the console's digits makes both sides comparable
+		sample_map r = s;
+		round_samples(r, console_digits);
+		EXPECT_DOUBLE_EQ(r.at("BM_Visit/8").at(0), 12.3);
+		EXPECT_DOUBLE_EQ(r.at("BM_Fold/1024/threads:4").at(0), 1250.0);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		threshold_list t;
+		EXPECT_DOUBLE_EQ(t.get("BM_Any"), 0.05);
+
+		ASSERT_TRUE(t.parse("8,BM_Visit:10,BM_Visit/8:20"));
+		EXPECT_DOUBLE_EQ(t.get("BM_Any"), 0.08);
+		EXPECT_DOUBLE_EQ(t.get("BM_Visit/64"), 0.10);
+		EXPECT_DOUBLE_EQ(t.get("BM_Visit/8"), 0.20);		// the longest prefix wins
+
+		EXPECT_FALSE(threshold_list().parse("x"));
+		EXPECT_FALSE(threshold_list().parse("5,:10"));
+		EXPECT_FALSE(threshold_list().parse("BM_Visit:-1"));
+
+		vector<int> cpus;
+		EXPECT_TRUE(parse_cpu_list("2", cpus));
+		EXPECT_EQ(cpus, (vector<int>{ 2 }));
+		EXPECT_TRUE(parse_cpu_list("0-3,8", cpus));
+		EXPECT_EQ(cpus, (vector<int>{ 0, 1, 2, 3, 8 }));
+		EXPECT_FALSE(parse_cpu_list("3-1", cpus));
+		EXPECT_FALSE(parse_cpu_list("a", cpus));
+		EXPECT_FALSE(parse_cpu_list("", cpus));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		sample_map base{ { "BM_A", { 10, 11, 10, 12, 11, 10, 11, 12 } }, { "BM_B", { 10, 11, 10, 12 } }, { "BM_Gone", { 1 } } };
+		sample_map now{ { "BM_A", { 20, 21, 20, 22, 21, 20, 21, 22 } }, { "BM_B", { 10, 12, 11, 10 } }, { "BM_New", { 1 } } };
+
+		threshold_list t;
+		auto rows = compare(base, now, t, 0.05);
+		ASSERT_EQ(rows.size(), 4u);
+		EXPECT_EQ(rows[0].result, verdict::regression);
+		EXPECT_EQ(rows[1].result, verdict::same);
+		EXPECT_EQ(rows[2].result, verdict::added);
+		EXPECT_EQ(rows[3].result, verdict::missing);
+
+		ostringstream os;
+		EXPECT_EQ(print_report(os, rows), 1u);
+		TEST_COUT << os.str();
+
+		// the same slowdown is only slower under a higher limit
+		ASSERT_TRUE(t.parse("BM_A:150"));
+		EXPECT_EQ(compare(base, now, t, 0.05)[0].result, verdict::slower);
+	}
+}
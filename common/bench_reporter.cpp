@@ -0,0 +1,25 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:31:52
+ * @brief
+ */
+
+#include "bench_reporter.h"
+
+namespace pluto
+{
+namespace bench
+{
+
+void collecting_reporter::ReportRuns(const std::vector<Run>& reports)
+{
+	for (const Run& run : reports)
+	{
+		if (run.run_type != Run::RT_Iteration || run.error_occurred || run.iterations == 0) continue;
+		samples_[run.benchmark_name()].push_back(run.real_accumulated_time * 1e9 / static_cast<double>(run.iterations));
+	}
+	benchmark::ConsoleReporter::ReportRuns(reports);
+}
+
+} // bench
+} // pluto
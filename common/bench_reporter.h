@@ -0,0 +1,38 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:31:52
+ * @brief
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "common/bench_regression.h"
+
+namespace pluto
+{
+namespace bench
+{
+
+/*
+ * The usual console output, plus every repetition collected into a
+ * sample_map at full precision, for compare() in bench_regression.h.
+ */
+class collecting_reporter : public benchmark::ConsoleReporter
+{
+public:
+	collecting_reporter() : benchmark::ConsoleReporter(OO_Tabular) {}
+
+	void ReportRuns(const std::vector<Run>& reports) override;
+
+	const sample_map& samples() const { return samples_; }
+
+private:
+	sample_map samples_;
+};
+
+} // bench
+} // pluto
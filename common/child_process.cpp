@@ -0,0 +1,78 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/21 10:04:27
+ * @brief
+ */
+
+#include "child_process.h"
+
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace pluto
+{
+namespace child_process
+{
+
+int spawn_self(const std::string& gtest_name, const std::string& env, const std::string& stdout_path)
+{
+#if defined(__linux__)
+	const std::string filter = "--gtest_filter=" + gtest_name;
+	char* const argv[] = { const_cast<char*>("/proc/self/exe"), const_cast<char*>(filter.c_str()), nullptr };
+	std::vector<char*> envp;
+	for (char** e = environ; *e != nullptr; ++e) envp.push_back(*e);
+	envp.push_back(const_cast<char*>(env.c_str()));
+	envp.push_back(nullptr);
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, stdout_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	pid_t child;
+	const int error = posix_spawn(&child, "/proc/self/exe", &actions, nullptr, argv, envp.data());
+	posix_spawn_file_actions_destroy(&actions);
+	return error == 0 ? child : -1;
+#else
+	(void)gtest_name;
+	(void)env;
+	(void)stdout_path;
+	return -1;
+#endif
+}
+
+int wait(int pid, std::chrono::milliseconds timeout)
+{
+#if defined(__linux__)
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	int status = 0;
+	pid_t done = 0;
+	while ((done = waitpid(pid, &status, WNOHANG)) == 0 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	if (done == 0)
+	{
+		kill(pid, SIGKILL);
+		waitpid(pid, &status, 0);
+		return hung;
+	}
+	if (done != pid || !WIFEXITED(status)) return signalled;
+	return WEXITSTATUS(status);
+#else
+	(void)pid;
+	(void)timeout;
+	return hung;
+#endif
+}
+
+} // child_process
+} // pluto
@@ -0,0 +1,43 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/21 10:04:27
+ * @brief
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace pluto
+{
+namespace child_process
+{
+
+/*
+ * Tests that need a second process run a copy of the test binary:
+ *
+ *		if (getenv("PLUTO_X_CHILD") != nullptr) std::_Exit(child_side());
+ *		...
+ *		const int pid = child_process::spawn_self("PLUTO.X", "PLUTO_X_CHILD=1");
+ *		ASSERT_GT(pid, 0);
+ *		EXPECT_EQ(0, child_process::wait(pid, std::chrono::seconds(10)));
+ *
+ * The copy runs only the named gtest test, with env ("NAME=value")
+ * added to the environment to send it down the child's path, and with
+ * its stdout in stdout_path. Linux only, it starts /proc/self/exe;
+ * elsewhere spawn_self() returns -1.
+ */
+
+/* the child's pid, -1 when it could not be started */
+int spawn_self(const std::string& gtest_name, const std::string& env, const std::string& stdout_path = "/dev/null");
+
+/* what wait() returns instead of an exit status */
+inline constexpr int hung = -1;			// still running at the timeout, killed
+inline constexpr int signalled = -2;	// ended by a signal
+
+/* the child's exit status, or hung / signalled; a hang fails the test instead of stalling the run */
+int wait(int pid, std::chrono::milliseconds timeout);
+
+} // child_process
+} // pluto
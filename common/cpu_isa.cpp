@@ -0,0 +1,72 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 09:12:40
+ * @brief
+ */
+
+#include "cpu_isa.h"
+
+namespace pluto
+{
+namespace cpu
+{
+
+namespace
+{
+
+isa detect_once()
+{
+#if PLUTO_SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return isa::avx2;
+	if (__builtin_cpu_supports("sse4.2")) return isa::sse42;
+#endif
+	return isa::scalar;
+}
+
+} // namespace
+
+const char* isa_name(isa i)
+{
+	switch (i)
+	{
+	case isa::avx512: return "avx512";
+	case isa::avx2: return "avx2";
+	case isa::sse42: return "sse4.2";
+	default: return "scalar";
+	}
+}
+
+isa detect()
+{
+	static const isa best = detect_once();
+	return best;
+}
+
+isa_dispatch::isa_dispatch(std::initializer_list<isa> implemented)
+{
+	for (isa i : implemented) implemented_ |= 1u << static_cast<unsigned>(i);
+	detected_ = best_at_most(detect());
+	active_.store(detected_, std::memory_order_relaxed);
+}
+
+isa isa_dispatch::set(isa requested) noexcept
+{
+	const isa chosen = best_at_most(static_cast<int>(requested) < static_cast<int>(detected_) ? requested : detected_);
+	active_.store(chosen, std::memory_order_relaxed);
+	return chosen;
+}
+
+isa isa_dispatch::best_at_most(isa limit) const noexcept
+{
+	for (int i = static_cast<int>(limit); i > 0; --i)
+	{
+		if (implemented_ & (1u << i)) return static_cast<isa>(i);
+	}
+	return isa::scalar;
+}
+
+} // cpu
+} // pluto
@@ -0,0 +1,89 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 09:12:40
+ * @brief
+ */
+
+#pragma once
+
+#include <atomic>
+#include <initializer_list>
+
+/*
+ * x86 with gcc or clang: kernels can use __attribute__((target(...))),
+ * <immintrin.h> and __builtin_cpu_supports. The .cpp files that define
+ * kernels include <immintrin.h> themselves under #if PLUTO_SIMD_X86.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PLUTO_SIMD_X86 1
+#else
+#define PLUTO_SIMD_X86 0
+#endif
+
+namespace pluto
+{
+namespace cpu
+{
+
+/*
+ * Instruction sets kernels are written for, each one a superset of the
+ * ones before it. avx2 includes FMA, every AVX2 CPU has it.
+ */
+enum class isa
+{
+	scalar,
+	sse42,
+	avx2,
+	avx512,
+};
+
+const char* isa_name(isa i);
+
+/* best instruction set this CPU supports */
+isa detect();
+
+/*
+ * The instruction set one module of kernels runs on. The module lists
+ * the sets it has kernels for, scalar is always there:
+ *
+ *		static cpu::isa_dispatch dispatch{ isa::sse42, isa::avx2 };
+ *
+ *		switch (dispatch.active())
+ *		{
+ *		case isa::avx2: return avx2::find(...);
+ *		case isa::sse42: return sse42::find(...);
+ *		default: return scalar::find(...);
+ *		}
+ *
+ * active() starts at detected(), the best listed set the CPU supports,
+ * and can be lowered with set(), e.g. to compare paths in tests.
+ */
+class isa_dispatch
+{
+public:
+	explicit isa_dispatch(std::initializer_list<isa> implemented);
+
+	isa_dispatch(const isa_dispatch&) = delete;
+	isa_dispatch& operator=(const isa_dispatch&) = delete;
+
+	isa detected() const noexcept { return detected_; }
+
+	isa active() const noexcept { return active_.load(std::memory_order_relaxed); }
+
+	/*
+	 * Switch to the best listed set that is neither above requested nor
+	 * above detected(). Returns the new active().
+	 */
+	isa set(isa requested) noexcept;
+
+private:
+	isa best_at_most(isa limit) const noexcept;
+
+	unsigned implemented_ = 1u << static_cast<unsigned>(isa::scalar);
+	isa detected_ = isa::scalar;
+	std::atomic<isa> active_{ isa::scalar };
+};
+
+} // cpu
+} // pluto
@@ -0,0 +1,40 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 09:20:11
+ * @brief
+ */
+
+#include <iostream>
+#include <gtest/gtest.h>
+
+#include "cpu_isa.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cpu;
+
+TEST(PLUTO, COMMON_CPU_ISA) {
+
+	TEST_COUT << "detected " << isa_name(detect()) << endl;
+
+	{
+		// scalar is always there, and the only choice without kernels
+		isa_dispatch none{};
+		EXPECT_EQ(isa::scalar, none.detected());
+		EXPECT_EQ(isa::scalar, none.set(isa::avx512));
+	}
+
+	{
+		// never above the CPU, and a request falls to the next listed set below it
+		isa_dispatch d{ isa::sse42, isa::avx512 };
+		EXPECT_TRUE(d.detected() <= detect());
+		EXPECT_NE(isa::avx2, d.detected());
+		EXPECT_EQ(d.detected(), d.active());
+
+		const isa below_avx512 = detect() >= isa::sse42 ? isa::sse42 : isa::scalar;
+		EXPECT_EQ(below_avx512, d.set(isa::avx2));
+		EXPECT_EQ(below_avx512, d.active());
+		EXPECT_EQ(isa::scalar, d.set(isa::scalar));
+		EXPECT_EQ(d.detected(), d.set(isa::avx512));
+	}
+}
@@ -7,5 +7,25 @@
 
 #pragma once
 
+#include "common/perf_counter.h"
+
+#if defined(PLUTO_ASYNC_TEST_COUT)
+
+/* through the asynchronous sink, see common/async_log.h */
+#include "common/async_log.h"
+
+#define TEST_COUT pluto::logging::line() << "[ OUTPUT   ] "
+#define TEST_COUT_DELIMITER pluto::logging::line() << "[ OUTPUT   ] ----------------------------------------" << std::endl;
+
+#else
+
 #define TEST_COUT std::cout << "[ OUTPUT   ] " 
-#define TEST_COUT_DELIMITER std::cout << "[ OUTPUT   ] ----------------------------------------" << endl;
\ No newline at end of file
+#define TEST_COUT_DELIMITER std::cout << "[ OUTPUT   ] ----------------------------------------" << endl;
+
+#endif
+
+/* hardware counters of the enclosing block, printed through TEST_COUT when it ends, see common/perf_counter.h */
+#define TEST_PERF_SCOPE(name) pluto::perf::scoped_counters TEST_PERF_CONCAT(test_perf_scope_, __LINE__)(name, nullptr, \
+	[](const std::string& text) { TEST_COUT << text << std::endl; })
+#define TEST_PERF_CONCAT(a, b) TEST_PERF_CONCAT_(a, b)
+#define TEST_PERF_CONCAT_(a, b) a##b
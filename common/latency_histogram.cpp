@@ -0,0 +1,165 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 22:31:14
+ * @brief
+ */
+
+#include "latency_histogram.h"
+#include "number_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace pluto
+{
+namespace latency
+{
+
+using number_format::grouped;
+
+namespace
+{
+
+std::atomic<std::size_t> next_id{ 0 };
+
+struct registry
+{
+	std::mutex mutex;
+	std::map<std::string, std::unique_ptr<histogram>> named;
+};
+
+/* never destroyed, timers in static destructors may still record */
+registry& get_registry()
+{
+	static registry* r = new registry;
+	return *r;
+}
+
+} // namespace
+
+snapshot& snapshot::merge(const snapshot& other)
+{
+	for (std::size_t i = 0; i < bucket_count; ++i) counts[i] += other.counts[i];
+	count += other.count;
+	sum += other.sum;
+	min = std::min(min, other.min);
+	max = std::max(max, other.max);
+	return *this;
+}
+
+std::uint64_t snapshot::percentile(double p) const
+{
+	if (count == 0) return 0;
+	const double clamped = std::clamp(p, 0.0, 100.0);
+	const auto rank = std::max<std::uint64_t>(1,
+		static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count))));
+
+	std::uint64_t seen = 0;
+	for (std::size_t i = 0; i < bucket_count; ++i)
+	{
+		seen += counts[i];
+		if (seen >= rank) return std::min(bucket_highest(i), max);
+	}
+	return max;
+}
+
+histogram::histogram() : id_(next_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+histogram::~histogram() = default;
+
+histogram::shard& histogram::add_shard()
+{
+	// owns the table local_ points into, and clears local_ when the thread exits
+	struct table_owner
+	{
+		std::vector<shard*> slots;
+		~table_owner() { local_ = { nullptr, 0 }; }
+	};
+	thread_local table_owner owner;
+	std::vector<shard*>& shards = owner.slots;
+
+	auto s = std::make_unique<shard>();
+	shard* raw = s.get();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		shards_.push_back(std::move(s));
+	}
+	if (shards.size() <= id_) shards.resize(id_ + 1, nullptr);
+	shards[id_] = raw;
+	local_ = { shards.data(), shards.size() };
+	return *raw;
+}
+
+snapshot histogram::take_snapshot() const
+{
+	snapshot out;
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (const auto& s : shards_)
+	{
+		for (std::size_t i = 0; i < bucket_count; ++i) out.counts[i] += s->counts[i].load(std::memory_order_relaxed);
+		out.count += s->count.load(std::memory_order_relaxed);
+		out.sum += s->sum.load(std::memory_order_relaxed);
+		out.min = std::min(out.min, s->min.load(std::memory_order_relaxed));
+		out.max = std::max(out.max, s->max.load(std::memory_order_relaxed));
+	}
+	return out;
+}
+
+void histogram::reset()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (const auto& s : shards_)
+	{
+		for (auto& c : s->counts) c.store(0, std::memory_order_relaxed);
+		s->count.store(0, std::memory_order_relaxed);
+		s->sum.store(0, std::memory_order_relaxed);
+		s->min.store(~std::uint64_t{ 0 }, std::memory_order_relaxed);
+		s->max.store(0, std::memory_order_relaxed);
+	}
+}
+
+histogram& histogram::named(const std::string& name)
+{
+	registry& r = get_registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	auto& h = r.named[name];
+	if (!h) h = std::make_unique<histogram>();
+	return *h;
+}
+
+std::map<std::string, snapshot> snapshot_all()
+{
+	registry& r = get_registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	std::map<std::string, snapshot> out;
+	for (const auto& [name, h] : r.named) out.emplace(name, h->take_snapshot());
+	return out;
+}
+
+void print(std::ostream& os, const std::string& name, const snapshot& s)
+{
+	std::ostringstream line;
+	line << "[ OUTPUT   ] " << name << ": n=" << s.count;
+	if (s.count != 0)
+	{
+		line << " p50=" << grouped(s.p50()) << " ns"
+			<< " p99=" << grouped(s.p99()) << " ns"
+			<< " p99.9=" << grouped(s.p999()) << " ns"
+			<< " max=" << grouped(s.max) << " ns";
+	}
+	os << line.str() << std::endl;
+}
+
+void report(std::ostream& os)
+{
+	for (const auto& [name, s] : snapshot_all())
+	{
+		if (s.count != 0) print(os, name, s);
+	}
+}
+
+} // latency
+} // pluto
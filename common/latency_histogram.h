@@ -0,0 +1,212 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 22:31:14
+ * @brief
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pluto
+{
+namespace latency
+{
+
+/*
+ * HDR style latency histogram, cheap enough to leave in hot paths:
+ *
+ *		void insert_all_hot_path(...)
+ *		{
+ *			PLUTO_TIME_SCOPE("insert_all");
+ *			...
+ *		}
+ *
+ *		pluto::latency::report(std::cout);
+ *		// [ OUTPUT   ] insert_all: n=10000 p50=182 ns p99=412 ns p99.9=2,303 ns max=15,871 ns
+ *
+ * Buckets are log-linear: values below 128 ns have their own bucket,
+ * above that every power of two is split into 64 buckets, so a reported
+ * percentile is at most 1/64 (1.6%) above the recorded value. The full
+ * uint64_t range fits in 3776 buckets.
+ *
+ * Every thread records into its own shard of the histogram, a plain
+ * array of counters with a single writer. Recording is a few relaxed
+ * loads and stores, no lock and no atomic read-modify-write; snapshot()
+ * may run concurrently from any thread and adds the shards up. Shards
+ * stay with the histogram when their thread exits.
+ *
+ * PLUTO_TIME_SCOPE(name) resolves the named histogram once per call
+ * site (a function local static, so the name must be constant there)
+ * and times the rest of the scope with steady_clock. Named histograms
+ * live until the process ends.
+ */
+
+inline constexpr unsigned sub_bucket_bits = 6;
+inline constexpr std::size_t bucket_count = 3776;
+
+constexpr std::size_t bucket_index(std::uint64_t v)
+{
+	if (v < (2u << sub_bucket_bits)) return static_cast<std::size_t>(v);
+	const unsigned shift = static_cast<unsigned>(std::bit_width(v)) - (sub_bucket_bits + 1);
+	return (static_cast<std::size_t>(shift) << sub_bucket_bits) + static_cast<std::size_t>(v >> shift);
+}
+
+/* smallest and largest value that land in bucket i */
+constexpr std::uint64_t bucket_lowest(std::size_t i)
+{
+	if (i < (2u << sub_bucket_bits)) return i;
+	const unsigned shift = static_cast<unsigned>(i >> sub_bucket_bits) - 1;
+	return static_cast<std::uint64_t>(i - (static_cast<std::size_t>(shift) << sub_bucket_bits)) << shift;
+}
+
+constexpr std::uint64_t bucket_highest(std::size_t i)
+{
+	if (i < (2u << sub_bucket_bits)) return i;
+	const unsigned shift = static_cast<unsigned>(i >> sub_bucket_bits) - 1;
+	return bucket_lowest(i) + ((std::uint64_t{ 1 } << shift) - 1);
+}
+
+static_assert(bucket_index(~std::uint64_t{ 0 }) == bucket_count - 1);
+
+/* a point-in-time copy, can be merged with snapshots of other histograms or processes */
+struct snapshot
+{
+	std::vector<std::uint64_t> counts = std::vector<std::uint64_t>(bucket_count);
+	std::uint64_t count = 0;
+	std::uint64_t sum = 0;
+	std::uint64_t min = ~std::uint64_t{ 0 };
+	std::uint64_t max = 0;
+
+	snapshot& merge(const snapshot& other);
+
+	/* p in [0, 100], the highest value of the bucket holding that rank, capped by max */
+	std::uint64_t percentile(double p) const;
+
+	std::uint64_t p50() const { return percentile(50.0); }
+	std::uint64_t p99() const { return percentile(99.0); }
+	std::uint64_t p999() const { return percentile(99.9); }
+	double mean() const { return count != 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+class histogram
+{
+public:
+	histogram();
+	~histogram();
+
+	histogram(const histogram&) = delete;
+	histogram& operator=(const histogram&) = delete;
+
+	/* a value in nanoseconds, lock free, wait free after the thread's first record */
+	void record(std::uint64_t ns)
+	{
+		shard& s = local_shard();
+		bump(s.counts[bucket_index(ns)], 1);
+		bump(s.count, 1);
+		bump(s.sum, ns);
+		if (ns < s.min.load(std::memory_order_relaxed)) s.min.store(ns, std::memory_order_relaxed);
+		if (ns > s.max.load(std::memory_order_relaxed)) s.max.store(ns, std::memory_order_relaxed);
+	}
+
+	snapshot take_snapshot() const;
+
+	/* zero every shard; records racing with it may be lost */
+	void reset();
+
+	/* the histogram registered under name, created on first use */
+	static histogram& named(const std::string& name);
+
+private:
+	struct shard
+	{
+		std::array<std::atomic<std::uint64_t>, bucket_count> counts{};
+		std::atomic<std::uint64_t> count{ 0 };
+		std::atomic<std::uint64_t> sum{ 0 };
+		std::atomic<std::uint64_t> min{ ~std::uint64_t{ 0 } };
+		std::atomic<std::uint64_t> max{ 0 };
+	};
+
+	/* only the owning thread writes, a load and a store instead of a locked add */
+	static void bump(std::atomic<std::uint64_t>& c, std::uint64_t n)
+	{
+		c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	/*
+	 * This thread's shards by histogram id. The fast path reads a trivial
+	 * thread_local, which costs no TLS init guard; the vector behind it
+	 * is only touched when a shard is added.
+	 */
+	struct shard_table
+	{
+		shard* const* slots;
+		std::size_t size;
+	};
+
+	static inline thread_local shard_table local_{ nullptr, 0 };
+
+	shard& local_shard()
+	{
+		if (id_ < local_.size && local_.slots[id_] != nullptr) return *local_.slots[id_];
+		return add_shard();
+	}
+
+	shard& add_shard();
+
+	const std::size_t id_;
+	mutable std::mutex mutex_;	// guards shards_, not the counters
+	std::vector<std::unique_ptr<shard>> shards_;
+};
+
+/* records the lifetime of the object into a histogram */
+class scoped_timer
+{
+public:
+	explicit scoped_timer(histogram& h) : h_(h), start_(std::chrono::steady_clock::now()) {}
+
+	~scoped_timer()
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - start_;
+		h_.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+	}
+
+	scoped_timer(const scoped_timer&) = delete;
+	scoped_timer& operator=(const scoped_timer&) = delete;
+
+private:
+	histogram& h_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+/* snapshots of every named histogram */
+std::map<std::string, snapshot> snapshot_all();
+
+/* one line in the [ OUTPUT   ] format */
+void print(std::ostream& os, const std::string& name, const snapshot& s);
+
+/* print every named histogram that has recorded something */
+void report(std::ostream& os);
+
+} // latency
+} // pluto
+
+#define PLUTO_TIME_SCOPE(name)																	\
+	static pluto::latency::histogram& PLUTO_LATENCY_CONCAT(pluto_histogram_, __LINE__) =		\
+		pluto::latency::histogram::named(name);													\
+	pluto::latency::scoped_timer PLUTO_LATENCY_CONCAT(pluto_timer_, __LINE__)(					\
+		PLUTO_LATENCY_CONCAT(pluto_histogram_, __LINE__))
+#define PLUTO_LATENCY_CONCAT(a, b) PLUTO_LATENCY_CONCAT_(a, b)
+#define PLUTO_LATENCY_CONCAT_(a, b) a##b
@@ -0,0 +1,82 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 23:04:12
+ * @brief
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "latency_histogram.h"
+
+using namespace std;
+using namespace pluto::latency;
+
+namespace
+{
+
+/* latencies spread over 10 ns .. 100 us, so the bucket index changes every call */
+vector<uint64_t> random_latencies()
+{
+	std::mt19937_64 gen(1);
+	std::lognormal_distribution<double> d(5.0, 1.5);
+	vector<uint64_t> v(1 << 16);
+	for (auto& x : v) x = 10 + static_cast<uint64_t>(d(gen)) % 100000;
+	return v;
+}
+
+} // namespace
+
+/* the cost of record() itself, per thread */
+static void BM_HistogramRecord(benchmark::State& state)
+{
+	static histogram h;
+	auto v = random_latencies();
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		h.record(v[i++ & 0xffff]);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* PLUTO_TIME_SCOPE around an empty block: two clock reads plus record() */
+static void BM_TimeScope(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		PLUTO_TIME_SCOPE("bench.empty_scope");
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* what the clock alone costs here, one read */
+static void BM_SteadyClockNow(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_HistogramSnapshot(benchmark::State& state)
+{
+	histogram h;
+	for (uint64_t v : random_latencies()) h.record(v);
+	for (auto _ : state)
+	{
+		auto s = h.take_snapshot();
+		benchmark::DoNotOptimize(s.p99());
+	}
+}
+
+BENCHMARK(BM_HistogramRecord)->Threads(1)->Threads(2)->Threads(4);
+BENCHMARK(BM_TimeScope);
+BENCHMARK(BM_SteadyClockNow);
+BENCHMARK(BM_HistogramSnapshot);
@@ -0,0 +1,105 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 22:52:40
+ * @brief
+ */
+
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "common/latency_histogram.h"
+#include "common/define.h"
+#include "cxx17/fold_expression.h"
+
+using namespace std;
+using namespace pluto::latency;
+
+TEST(PLUTO, COMMON_LATENCY_HISTOGRAM) {
+
+	{
+		// every value falls inside its bucket, and a bucket is at most 1/64 of its values wide
+		vector<uint64_t> values;
+		for (uint64_t v = 0; v < 100000; ++v) values.push_back(v);
+		for (int b = 17; b < 64; ++b) for (uint64_t d : { 0ull, 1ull, 12345ull }) values.push_back((1ull << b) + d);
+		values.push_back(~0ull);
+
+		size_t bad = 0;
+		for (uint64_t v : values)
+		{
+			const size_t i = bucket_index(v);
+			if (i >= bucket_count || bucket_lowest(i) > v || bucket_highest(i) < v) ++bad;
+			if (bucket_highest(i) - bucket_lowest(i) > bucket_lowest(i) / 64) ++bad;
+		}
+		EXPECT_EQ(bad, 0u);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		histogram h;
+		for (uint64_t v = 1; v <= 10000; ++v) h.record(v);
+		auto s = h.take_snapshot();
+		print(cout, "1..10000", s);
+
+		EXPECT_EQ(s.count, 10000u);
+		EXPECT_EQ(s.min, 1u);
+		EXPECT_EQ(s.max, 10000u);
+		EXPECT_DOUBLE_EQ(s.mean(), 5000.5);
+		EXPECT_GE(s.p50(), 5000u);
+		EXPECT_LE(s.p50(), 5000u + 5000u / 64);
+		EXPECT_GE(s.p99(), 9900u);
+		EXPECT_LE(s.p99(), 9900u + 9900u / 64);
+		EXPECT_GE(s.p999(), 9990u);
+		EXPECT_EQ(s.percentile(100.0), 10000u);
+
+		h.reset();
+		EXPECT_EQ(h.take_snapshot().count, 0u);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// one shard per thread, the snapshot adds them up; snapshots merge the same way
+		histogram h;
+		vector<thread> threads;
+		for (uint64_t t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&h, t] {
+				for (uint64_t i = 0; i < 10000; ++i) h.record(t * 1000 + i % 100);
+			});
+		}
+		for (auto& t : threads) t.join();
+
+		auto s = h.take_snapshot();
+		EXPECT_EQ(s.count, 40000u);
+		EXPECT_EQ(s.min, 0u);
+		EXPECT_EQ(s.max, 3099u);
+
+		histogram other;
+		other.record(1000000);
+		s.merge(other.take_snapshot());
+		EXPECT_EQ(s.count, 40001u);
+		EXPECT_EQ(s.max, 1000000u);
+		print(cout, "4 threads + 1 merged", s);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// the tail of std::set insertion through the fold helper
+		for (int round = 0; round < 1000; ++round)
+		{
+			std::set<int> s;
+			PLUTO_TIME_SCOPE("insert_all");
+			pluto::cxx17::fold_expression::insert_all(s, round, 2, 45, 12, 7, 9, 31, 4);
+		}
+		auto all = snapshot_all();
+		ASSERT_EQ(all.count("insert_all"), 1u);
+		EXPECT_EQ(all["insert_all"].count, 1000u);
+		report(cout);
+	}
+}
@@ -0,0 +1,32 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 09:41:26
+ * @brief
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pluto
+{
+namespace number_format
+{
+
+/* 1234567 -> "1,234,567", for the report lines of perf_counter and latency_histogram */
+inline std::string grouped(std::uint64_t n)
+{
+	std::string digits = std::to_string(n), out;
+	for (std::size_t i = 0; i < digits.size(); ++i)
+	{
+		if (i != 0 && (digits.size() - i) % 3 == 0) out += ',';
+		out += digits[i];
+	}
+	return out;
+}
+
+} // number_format
+} // pluto
@@ -0,0 +1,220 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 21:02:18
+ * @brief
+ */
+
+#include "perf_counter.h"
+#include "number_format.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace pluto
+{
+namespace perf
+{
+
+using number_format::grouped;
+
+namespace
+{
+
+std::uint64_t now_ns()
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if defined(__linux__)
+
+struct event_config
+{
+	std::uint32_t type;
+	std::uint64_t config;
+};
+
+constexpr std::uint64_t cache_miss(std::uint64_t cache)
+{
+	return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr std::array<event_config, event_count> configs = { {
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D) },
+	{ PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL) },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+} };
+
+int open_counter(const event_config& c)
+{
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = c.type;
+	attr.config = c.config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+#endif
+
+} // namespace
+
+const char* event_name(event e)
+{
+	switch (e)
+	{
+	case event::cycles: return "cycles";
+	case event::instructions: return "instructions";
+	case event::l1d_misses: return "L1d misses";
+	case event::llc_misses: return "LLC misses";
+	case event::branch_misses: return "branch misses";
+	}
+	return "?";
+}
+
+double counter_values::ipc() const
+{
+	if (!has(event::cycles) || !has(event::instructions) || (*this)[event::cycles] == 0) return 0.0;
+	return static_cast<double>((*this)[event::instructions]) / static_cast<double>((*this)[event::cycles]);
+}
+
+counter_set::counter_set()
+{
+	fd_.fill(-1);
+#if defined(__linux__)
+	for (std::size_t i = 0; i < event_count; ++i)
+	{
+		fd_[i] = open_counter(configs[i]);
+		if (fd_[i] < 0 && error_.empty())
+		{
+			error_ = std::string("perf_event_open: ") + std::strerror(errno);
+		}
+	}
+#else
+	error_ = "perf_event_open: not supported on this platform";
+#endif
+}
+
+counter_set::~counter_set()
+{
+#if defined(__linux__)
+	for (int fd : fd_) if (fd >= 0) close(fd);
+#endif
+}
+
+bool counter_set::available() const
+{
+	for (int fd : fd_) if (fd >= 0) return true;
+	return false;
+}
+
+void counter_set::start()
+{
+#if defined(__linux__)
+	for (int fd : fd_)
+	{
+		if (fd < 0) continue;
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+	start_ns_ = now_ns();
+}
+
+counter_values counter_set::stop()
+{
+	counter_values v;
+	v.ns = now_ns() - start_ns_;
+#if defined(__linux__)
+	for (int fd : fd_) if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+	for (std::size_t i = 0; i < event_count; ++i)
+	{
+		// value, time enabled, time running; scale up if the PMU was multiplexed
+		std::uint64_t data[3] = {};
+		if (fd_[i] < 0 || read(fd_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+		if (data[2] == 0) continue;
+
+		v.value[i] = data[2] < data[1]
+			? static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2])
+			: data[0];
+		v.valid[i] = true;
+	}
+#endif
+	return v;
+}
+
+std::string describe(const std::string& name, const counter_values& v, const std::string& note)
+{
+	std::ostringstream line;
+	line << "[perf] " << name << ": ";
+
+	bool any = false;
+	for (std::size_t i = 0; i < event_count; ++i)
+	{
+		if (!v.valid[i]) continue;
+		line << grouped(v.value[i]) << ' ' << event_name(static_cast<event>(i));
+		if (static_cast<event>(i) == event::instructions && v.ipc() != 0.0)
+		{
+			line << " (IPC " << std::fixed << std::setprecision(2) << v.ipc() << ')';
+		}
+		line << ", ";
+		any = true;
+	}
+	if (!any) line << "counters unavailable" << (note.empty() ? "" : " (" + note + ")") << ", ";
+
+	if (v.ns < 10000) line << v.ns << " ns";
+	else line << std::fixed << std::setprecision(1) << static_cast<double>(v.ns) / 1000.0 << " us";
+
+	return line.str();
+}
+
+void print(std::ostream& os, const std::string& name, const counter_values& v, const std::string& note)
+{
+	os << "[ OUTPUT   ] " << describe(name, v, note) << std::endl;
+}
+
+scoped_counters::scoped_counters(std::string name, counter_values* out, line_sink sink)
+	: name_(std::move(name)), out_(out), sink_(sink)
+{
+	counters_.start();
+}
+
+scoped_counters::~scoped_counters()
+{
+	stop();
+}
+
+const counter_values& scoped_counters::stop()
+{
+	if (stopped_) return values_;
+	values_ = counters_.stop();
+	stopped_ = true;
+
+	if (out_ != nullptr) *out_ = values_;
+	if (sink_ != nullptr) sink_(describe(name_, values_, counters_.error()));
+	else print(std::cout, name_, values_, counters_.error());
+	return values_;
+}
+
+} // perf
+} // pluto
@@ -0,0 +1,134 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 21:02:18
+ * @brief
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace pluto
+{
+namespace perf
+{
+
+/*
+ * Hardware counters for a block of code, read with perf_event_open(2):
+ *
+ *		{
+ *			TEST_PERF_SCOPE("tuple_cat");
+ *			auto t2 = std::tuple_cat(t1, ...);
+ *		}
+ *
+ * prints, when the scope ends,
+ *
+ *		[ OUTPUT   ] [perf] tuple_cat: 1,234 cycles, 2,410 instructions (IPC 1.95),
+ *					  12 L1d misses, 0 LLC misses, 3 branch misses, 1.9 us
+ *
+ * Only user space is counted (exclude_kernel), which is what an
+ * unprivileged process may read with perf_event_paranoid <= 2. When a
+ * counter cannot be opened (no PMU in a VM or container, seccomp, not
+ * Linux) it is left out, and with none at all only the wall time is
+ * printed. Nothing fails because of missing counters.
+ *
+ * The numbers are also returned: scoped_counters::stop() or the
+ * counter_values* passed to the constructor.
+ */
+
+enum class event : std::size_t
+{
+	cycles,
+	instructions,
+	l1d_misses,
+	llc_misses,
+	branch_misses,
+};
+
+inline constexpr std::size_t event_count = 5;
+
+const char* event_name(event e);
+
+struct counter_values
+{
+	std::array<std::uint64_t, event_count> value{};
+	std::array<bool, event_count> valid{};
+	std::uint64_t ns = 0;		// wall time of the scope
+
+	bool has(event e) const { return valid[static_cast<std::size_t>(e)]; }
+	std::uint64_t operator[](event e) const { return value[static_cast<std::size_t>(e)]; }
+
+	/* instructions per cycle, 0 without both counters */
+	double ipc() const;
+};
+
+/*
+ * The opened counters of one thread. They count between start() and
+ * stop() and can be started again.
+ */
+class counter_set
+{
+public:
+	counter_set();
+	~counter_set();
+
+	counter_set(const counter_set&) = delete;
+	counter_set& operator=(const counter_set&) = delete;
+
+	/* true if at least one counter could be opened */
+	bool available() const;
+
+	/* why counters are missing, empty if all opened */
+	const std::string& error() const { return error_; }
+
+	void start();
+	counter_values stop();
+
+private:
+	std::array<int, event_count> fd_;
+	std::string error_;
+	std::uint64_t start_ns_ = 0;
+};
+
+/* the text of a report line, "[perf] name: 1,234 cycles, ..." */
+std::string describe(const std::string& name, const counter_values& v, const std::string& note = {});
+
+/* one line in the [ OUTPUT   ] format */
+void print(std::ostream& os, const std::string& name, const counter_values& v, const std::string& note = {});
+
+/*
+ * Counts from construction to stop() or the end of the scope, then
+ * hands describe() to sink; without one the line is print()ed to
+ * std::cout. TEST_PERF_SCOPE passes a sink that writes through
+ * TEST_COUT, so the line goes wherever the test output goes.
+ */
+class scoped_counters
+{
+public:
+	using line_sink = void (*)(const std::string& text);
+
+	explicit scoped_counters(std::string name, counter_values* out = nullptr, line_sink sink = nullptr);
+	~scoped_counters();
+
+	scoped_counters(const scoped_counters&) = delete;
+	scoped_counters& operator=(const scoped_counters&) = delete;
+
+	/* end the measurement early, print it and return it; later calls return the same values */
+	const counter_values& stop();
+
+private:
+	std::string name_;
+	counter_values* out_;
+	line_sink sink_;
+	counter_values values_;
+	counter_set counters_;
+	bool stopped_ = false;
+};
+
+} // perf
+} // pluto
@@ -0,0 +1,88 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 21:24:05
+ * @brief
+ */
+
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::perf;
+
+TEST(PLUTO, COMMON_PERF_COUNTER) {
+
+	{
+		counter_set counters;
+		TEST_COUT << "counters " << (counters.available() ? "available" : "unavailable")
+			<< (counters.error().empty() ? "" : ": " + counters.error()) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// the values come back through the pointer, with or without counters
+		vector<int> v(1 << 16);
+		iota(v.begin(), v.end(), 0);
+
+		counter_values values;
+		long long sum = 0;
+		{
+			TEST_PERF_SCOPE("sum 64K ints");
+			scoped_counters scope("sum 64K ints, programmatic", &values);
+			sum = accumulate(v.begin(), v.end(), 0LL);
+		}
+		EXPECT_EQ(sum, (1LL << 16) * ((1 << 16) - 1) / 2);
+		EXPECT_GT(values.ns, 0u);
+
+		if (values.has(event::instructions))
+		{
+			// at least one add per element
+			EXPECT_GE(values[event::instructions], v.size());
+		}
+		if (values.has(event::cycles) && values.has(event::instructions))
+		{
+			EXPECT_GT(values.ipc(), 0.0);
+		}
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// stop() ends the measurement once, the destructor does not print again
+		scoped_counters scope("stopped early");
+		const counter_values& first = scope.stop();
+		const counter_values& second = scope.stop();
+		EXPECT_EQ(&first, &second);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// a set can be restarted
+		counter_set counters;
+		counters.start();
+		auto a = counters.stop();
+		counters.start();
+		auto b = counters.stop();
+		EXPECT_EQ(a.valid, b.valid);
+		print(cout, "empty block", b, counters.error());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// the line goes to the sink when there is one
+		static string last;
+		{
+			scoped_counters scope("to the sink", nullptr, [](const string& text) { last = text; });
+		}
+		EXPECT_EQ(0u, last.rfind("[perf] to the sink: ", 0)) << last;
+		TEST_PERF_SCOPE("through TEST_COUT");
+	}
+}
@@ -0,0 +1,470 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 15:32:17
+ * @brief
+ */
+
+#include "simd_kernels.h"
+
+#include <cmath>
+#include <cstring>
+
+#if PLUTO_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace pluto
+{
+namespace cxx11
+{
+namespace simd
+{
+
+namespace
+{
+
+enum class op
+{
+	add,
+	sub,
+	mul,
+};
+
+template<class R>
+struct tag {};
+
+/* signed overflow wraps like the vector instructions do */
+template<op O, class R>
+R apply_scalar(R x, R y)
+{
+	if constexpr (std::is_integral_v<R>)
+	{
+		using U = std::make_unsigned_t<R>;
+		if constexpr (O == op::add) return static_cast<R>(static_cast<U>(x) + static_cast<U>(y));
+		if constexpr (O == op::sub) return static_cast<R>(static_cast<U>(x) - static_cast<U>(y));
+		if constexpr (O == op::mul) return static_cast<R>(static_cast<U>(x) * static_cast<U>(y));
+	}
+	else
+	{
+		if constexpr (O == op::add) return x + y;
+		if constexpr (O == op::sub) return x - y;
+		if constexpr (O == op::mul) return x * y;
+	}
+}
+
+template<class R>
+R fma_scalar(R x, R y, R z)
+{
+	if constexpr (std::is_integral_v<R>)
+	{
+		return apply_scalar<op::add>(apply_scalar<op::mul>(x, y), z);
+	}
+	else
+	{
+		return std::fma(x, y, z);
+	}
+}
+
+namespace scalar
+{
+
+template<op O, class A, class B, class R>
+void binary(const A* a, const B* b, R* out, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		out[i] = apply_scalar<O>(static_cast<R>(a[i]), static_cast<R>(b[i]));
+	}
+}
+
+template<class A, class B, class R>
+void fma(const A* a, const B* b, const R* c, R* out, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		out[i] = fma_scalar(static_cast<R>(a[i]), static_cast<R>(b[i]), c[i]);
+	}
+}
+
+template<class A, class R>
+void convert(const A* a, R* out, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<R>(a[i]);
+}
+
+} // scalar
+
+#if PLUTO_SIMD_X86
+
+/*
+ * The kernels are the same for every instruction set, only the register
+ * types and the load / store / apply primitives differ. Each ISA
+ * namespace defines those primitives and then stamps out the kernels.
+ */
+#define PLUTO_SIMD_KERNELS(TARGET)																\
+template<op O, class A, class B, class R>														\
+TARGET void binary(const A* a, const B* b, R* out, std::size_t n)								\
+{																								\
+	constexpr std::size_t w = reg<R>::lanes;													\
+	std::size_t i = 0;																			\
+	for (; i + w <= n; i += w)																	\
+	{																							\
+		store(out + i, apply<O>(load(a + i, tag<R>{}), load(b + i, tag<R>{})));				\
+	}																							\
+	scalar::binary<O>(a + i, b + i, out + i, n - i);											\
+}																								\
+																								\
+template<class A, class B, class R>																\
+TARGET void fma(const A* a, const B* b, const R* c, R* out, std::size_t n)						\
+{																								\
+	constexpr std::size_t w = reg<R>::lanes;													\
+	std::size_t i = 0;																			\
+	for (; i + w <= n; i += w)																	\
+	{																							\
+		store(out + i, fused(load(a + i, tag<R>{}), load(b + i, tag<R>{}), load(c + i, tag<R>{})));	\
+	}																							\
+	scalar::fma(a + i, b + i, c + i, out + i, n - i);											\
+}																								\
+																								\
+template<class A, class R>																		\
+TARGET void convert(const A* a, R* out, std::size_t n)											\
+{																								\
+	constexpr std::size_t w = reg<R>::lanes;													\
+	std::size_t i = 0;																			\
+	for (; i + w <= n; i += w) store(out + i, load(a + i, tag<R>{}));							\
+	scalar::convert(a + i, out + i, n - i);														\
+}
+
+template<class T>
+std::int32_t load_u32(const T* p)
+{
+	std::int32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+namespace avx2
+{
+
+#define PLUTO_AVX2 __attribute__((target("avx2,fma"))) inline
+
+template<class R> struct reg;
+template<> struct reg<std::int32_t> { static constexpr std::size_t lanes = 8; };
+template<> struct reg<float> { static constexpr std::size_t lanes = 8; };
+template<> struct reg<double> { static constexpr std::size_t lanes = 4; };
+
+// 8 x int32
+
+PLUTO_AVX2 __m256i load(const std::int8_t* p, tag<std::int32_t>) { return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m256i load(const std::uint8_t* p, tag<std::int32_t>) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m256i load(const std::int16_t* p, tag<std::int32_t>) { return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m256i load(const std::uint16_t* p, tag<std::int32_t>) { return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m256i load(const std::int32_t* p, tag<std::int32_t>) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+// 8 x float
+
+PLUTO_AVX2 __m256 load(const float* p, tag<float>) { return _mm256_loadu_ps(p); }
+
+template<class A>
+PLUTO_AVX2 __m256 load(const A* p, tag<float>) { return _mm256_cvtepi32_ps(load(p, tag<std::int32_t>{})); }
+
+// 4 x double, through 4 x int32
+
+PLUTO_AVX2 __m128i load4(const std::int8_t* p) { return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(load_u32(p))); }
+PLUTO_AVX2 __m128i load4(const std::uint8_t* p) { return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(load_u32(p))); }
+PLUTO_AVX2 __m128i load4(const std::int16_t* p) { return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m128i load4(const std::uint16_t* p) { return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX2 __m128i load4(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+PLUTO_AVX2 __m256d load(const double* p, tag<double>) { return _mm256_loadu_pd(p); }
+PLUTO_AVX2 __m256d load(const float* p, tag<double>) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+template<class A>
+PLUTO_AVX2 __m256d load(const A* p, tag<double>) { return _mm256_cvtepi32_pd(load4(p)); }
+
+PLUTO_AVX2 void store(std::int32_t* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+PLUTO_AVX2 void store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+PLUTO_AVX2 void store(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+
+template<op O>
+PLUTO_AVX2 __m256i apply(__m256i x, __m256i y)
+{
+	if constexpr (O == op::add) return _mm256_add_epi32(x, y);
+	if constexpr (O == op::sub) return _mm256_sub_epi32(x, y);
+	if constexpr (O == op::mul) return _mm256_mullo_epi32(x, y);
+}
+
+template<op O>
+PLUTO_AVX2 __m256 apply(__m256 x, __m256 y)
+{
+	if constexpr (O == op::add) return _mm256_add_ps(x, y);
+	if constexpr (O == op::sub) return _mm256_sub_ps(x, y);
+	if constexpr (O == op::mul) return _mm256_mul_ps(x, y);
+}
+
+template<op O>
+PLUTO_AVX2 __m256d apply(__m256d x, __m256d y)
+{
+	if constexpr (O == op::add) return _mm256_add_pd(x, y);
+	if constexpr (O == op::sub) return _mm256_sub_pd(x, y);
+	if constexpr (O == op::mul) return _mm256_mul_pd(x, y);
+}
+
+PLUTO_AVX2 __m256i fused(__m256i x, __m256i y, __m256i z) { return _mm256_add_epi32(_mm256_mullo_epi32(x, y), z); }
+PLUTO_AVX2 __m256 fused(__m256 x, __m256 y, __m256 z) { return _mm256_fmadd_ps(x, y, z); }
+PLUTO_AVX2 __m256d fused(__m256d x, __m256d y, __m256d z) { return _mm256_fmadd_pd(x, y, z); }
+
+PLUTO_SIMD_KERNELS(PLUTO_AVX2)
+
+#undef PLUTO_AVX2
+
+} // avx2
+
+namespace avx512
+{
+
+#define PLUTO_AVX512 __attribute__((target("avx512f,avx2,fma"))) inline
+
+template<class R> struct reg;
+template<> struct reg<std::int32_t> { static constexpr std::size_t lanes = 16; };
+template<> struct reg<float> { static constexpr std::size_t lanes = 16; };
+template<> struct reg<double> { static constexpr std::size_t lanes = 8; };
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// gcc's own avx512 conversions start from _mm512_undefined_*(), which trips this one
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// 16 x int32
+
+PLUTO_AVX512 __m512i load(const std::int8_t* p, tag<std::int32_t>) { return _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m512i load(const std::uint8_t* p, tag<std::int32_t>) { return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m512i load(const std::int16_t* p, tag<std::int32_t>) { return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+PLUTO_AVX512 __m512i load(const std::uint16_t* p, tag<std::int32_t>) { return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+PLUTO_AVX512 __m512i load(const std::int32_t* p, tag<std::int32_t>) { return _mm512_loadu_si512(p); }
+
+// 16 x float
+
+PLUTO_AVX512 __m512 load(const float* p, tag<float>) { return _mm512_loadu_ps(p); }
+
+template<class A>
+PLUTO_AVX512 __m512 load(const A* p, tag<float>) { return _mm512_cvtepi32_ps(load(p, tag<std::int32_t>{})); }
+
+// 8 x double, through 8 x int32
+
+PLUTO_AVX512 __m256i load8(const std::int8_t* p) { return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m256i load8(const std::uint8_t* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m256i load8(const std::int16_t* p) { return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m256i load8(const std::uint16_t* p) { return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+PLUTO_AVX512 __m256i load8(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+PLUTO_AVX512 __m512d load(const double* p, tag<double>) { return _mm512_loadu_pd(p); }
+PLUTO_AVX512 __m512d load(const float* p, tag<double>) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+
+template<class A>
+PLUTO_AVX512 __m512d load(const A* p, tag<double>) { return _mm512_cvtepi32_pd(load8(p)); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+PLUTO_AVX512 void store(std::int32_t* p, __m512i v) { _mm512_storeu_si512(p, v); }
+PLUTO_AVX512 void store(float* p, __m512 v) { _mm512_storeu_ps(p, v); }
+PLUTO_AVX512 void store(double* p, __m512d v) { _mm512_storeu_pd(p, v); }
+
+template<op O>
+PLUTO_AVX512 __m512i apply(__m512i x, __m512i y)
+{
+	if constexpr (O == op::add) return _mm512_add_epi32(x, y);
+	if constexpr (O == op::sub) return _mm512_sub_epi32(x, y);
+	if constexpr (O == op::mul) return _mm512_mullo_epi32(x, y);
+}
+
+template<op O>
+PLUTO_AVX512 __m512 apply(__m512 x, __m512 y)
+{
+	if constexpr (O == op::add) return _mm512_add_ps(x, y);
+	if constexpr (O == op::sub) return _mm512_sub_ps(x, y);
+	if constexpr (O == op::mul) return _mm512_mul_ps(x, y);
+}
+
+template<op O>
+PLUTO_AVX512 __m512d apply(__m512d x, __m512d y)
+{
+	if constexpr (O == op::add) return _mm512_add_pd(x, y);
+	if constexpr (O == op::sub) return _mm512_sub_pd(x, y);
+	if constexpr (O == op::mul) return _mm512_mul_pd(x, y);
+}
+
+PLUTO_AVX512 __m512i fused(__m512i x, __m512i y, __m512i z) { return _mm512_add_epi32(_mm512_mullo_epi32(x, y), z); }
+PLUTO_AVX512 __m512 fused(__m512 x, __m512 y, __m512 z) { return _mm512_fmadd_ps(x, y, z); }
+PLUTO_AVX512 __m512d fused(__m512d x, __m512d y, __m512d z) { return _mm512_fmadd_pd(x, y, z); }
+
+PLUTO_SIMD_KERNELS(PLUTO_AVX512)
+
+#undef PLUTO_AVX512
+
+} // avx512
+
+#undef PLUTO_SIMD_KERNELS
+
+#endif // PLUTO_SIMD_X86
+
+cpu::isa_dispatch& dispatch()
+{
+	static cpu::isa_dispatch kernels{ isa::avx2, isa::avx512 };
+	return kernels;
+}
+
+/* std::int32_t, float or double : the register element types we have */
+template<class R>
+constexpr bool has_simd_v = std::is_same_v<R, std::int32_t> || std::is_same_v<R, float> || std::is_same_v<R, double>;
+
+} // namespace
+
+isa detected_isa()
+{
+	return dispatch().detected();
+}
+
+isa active_isa()
+{
+	return dispatch().active();
+}
+
+isa set_isa(isa requested)
+{
+	return dispatch().set(requested);
+}
+
+namespace
+{
+
+template<op O, class A, class B, class R>
+void run_binary(const A* a, const B* b, R* out, std::size_t n)
+{
+#if PLUTO_SIMD_X86
+	if constexpr (has_simd_v<R>)
+	{
+		switch (active_isa())
+		{
+		case isa::avx512: return avx512::binary<O>(a, b, out, n);
+		case isa::avx2: return avx2::binary<O>(a, b, out, n);
+		default: break;
+		}
+	}
+#endif
+	scalar::binary<O>(a, b, out, n);
+}
+
+} // namespace
+
+template<class A, class B>
+void add(const A* a, const B* b, promote_t<A, B>* out, std::size_t n)
+{
+	run_binary<op::add>(a, b, out, n);
+}
+
+template<class A, class B>
+void sub(const A* a, const B* b, promote_t<A, B>* out, std::size_t n)
+{
+	run_binary<op::sub>(a, b, out, n);
+}
+
+template<class A, class B>
+void mul(const A* a, const B* b, promote_t<A, B>* out, std::size_t n)
+{
+	run_binary<op::mul>(a, b, out, n);
+}
+
+template<class A, class B>
+void fma(const A* a, const B* b, const promote_t<A, B>* c, promote_t<A, B>* out, std::size_t n)
+{
+#if PLUTO_SIMD_X86
+	if constexpr (has_simd_v<promote_t<A, B>>)
+	{
+		switch (active_isa())
+		{
+		case isa::avx512: return avx512::fma(a, b, c, out, n);
+		case isa::avx2: return avx2::fma(a, b, c, out, n);
+		default: break;
+		}
+	}
+#endif
+	scalar::fma(a, b, c, out, n);
+}
+
+template<class R, class A>
+void convert(const A* a, R* out, std::size_t n)
+{
+	static_assert(std::is_same_v<promote_t<A, R>, R>, "only widening conversions");
+
+#if PLUTO_SIMD_X86
+	if constexpr (has_simd_v<R>)
+	{
+		switch (active_isa())
+		{
+		case isa::avx512: return avx512::convert(a, out, n);
+		case isa::avx2: return avx2::convert(a, out, n);
+		default: break;
+		}
+	}
+#endif
+	scalar::convert(a, out, n);
+}
+
+// every supported pair
+
+#define PLUTO_SIMD_PAIR(A, B)																\
+template void add<A, B>(const A*, const B*, promote_t<A, B>*, std::size_t);				\
+template void sub<A, B>(const A*, const B*, promote_t<A, B>*, std::size_t);				\
+template void mul<A, B>(const A*, const B*, promote_t<A, B>*, std::size_t);				\
+template void fma<A, B>(const A*, const B*, const promote_t<A, B>*, promote_t<A, B>*, std::size_t);
+
+#define PLUTO_SIMD_ROW(A)				\
+PLUTO_SIMD_PAIR(A, std::int8_t)			\
+PLUTO_SIMD_PAIR(A, std::uint8_t)		\
+PLUTO_SIMD_PAIR(A, std::int16_t)		\
+PLUTO_SIMD_PAIR(A, std::uint16_t)		\
+PLUTO_SIMD_PAIR(A, std::int32_t)		\
+PLUTO_SIMD_PAIR(A, float)				\
+PLUTO_SIMD_PAIR(A, double)
+
+PLUTO_SIMD_ROW(std::int8_t)
+PLUTO_SIMD_ROW(std::uint8_t)
+PLUTO_SIMD_ROW(std::int16_t)
+PLUTO_SIMD_ROW(std::uint16_t)
+PLUTO_SIMD_ROW(std::int32_t)
+PLUTO_SIMD_ROW(float)
+PLUTO_SIMD_ROW(double)
+
+#define PLUTO_SIMD_CONVERT(R, A) template void convert<R, A>(const A*, R*, std::size_t);
+
+PLUTO_SIMD_CONVERT(std::int32_t, std::int8_t)
+PLUTO_SIMD_CONVERT(std::int32_t, std::uint8_t)
+PLUTO_SIMD_CONVERT(std::int32_t, std::int16_t)
+PLUTO_SIMD_CONVERT(std::int32_t, std::uint16_t)
+PLUTO_SIMD_CONVERT(std::int32_t, std::int32_t)
+PLUTO_SIMD_CONVERT(float, std::int8_t)
+PLUTO_SIMD_CONVERT(float, std::uint8_t)
+PLUTO_SIMD_CONVERT(float, std::int16_t)
+PLUTO_SIMD_CONVERT(float, std::uint16_t)
+PLUTO_SIMD_CONVERT(float, std::int32_t)
+PLUTO_SIMD_CONVERT(float, float)
+PLUTO_SIMD_CONVERT(double, std::int8_t)
+PLUTO_SIMD_CONVERT(double, std::uint8_t)
+PLUTO_SIMD_CONVERT(double, std::int16_t)
+PLUTO_SIMD_CONVERT(double, std::uint16_t)
+PLUTO_SIMD_CONVERT(double, std::int32_t)
+PLUTO_SIMD_CONVERT(double, float)
+PLUTO_SIMD_CONVERT(double, double)
+
+#undef PLUTO_SIMD_CONVERT
+#undef PLUTO_SIMD_ROW
+#undef PLUTO_SIMD_PAIR
+
+} // simd
+} // cxx11
+} // pluto
@@ -0,0 +1,95 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 15:32:17
+ * @brief
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "trailing_return_type.h"
+#include "common/cpu_isa.h"
+
+namespace pluto
+{
+namespace cxx11
+{
+namespace simd
+{
+
+/*
+ * Element-wise kernels over arrays of mixed scalar types:
+ *
+ *		int16_t a[n]; float b[n]; float out[n];
+ *		simd::add(a, b, out, n);	// out[i] = a[i] + b[i]
+ *
+ * The output type is never chosen by hand, it is whatever
+ * return_type_deduction::add deduces for one element, decltype(x + y),
+ * so the arrays behave exactly like the scalar expression:
+ *
+ *		int8_t  + int8_t	-> int			(integral promotion)
+ *		uint8_t + int32_t	-> int
+ *		int16_t + float		-> float
+ *		float   + double	-> double
+ *
+ * Compilers vectorize these mixed loops poorly: the widening has to be
+ * spelled out (cvtepi8_epi32, cvtepi32_ps, ...). The kernels here do it
+ * explicitly, in AVX2 (+FMA) and AVX-512F flavours, picked at run time
+ * from what the CPU supports, with a scalar fallback everywhere else.
+ *
+ * Supported element types : int8_t, uint8_t, int16_t, uint16_t,
+ *							  int32_t, float, double (every pair).
+ *
+ * fma(a, b, c, out) computes out[i] = a[i] * b[i] + c[i]; for floating
+ * types it is fused (one rounding) like std::fma in every code path.
+ * Integer overflow wraps in the SIMD paths.
+ */
+
+/* the element type of a[i] + b[i] */
+template<class A, class B>
+using promote_t = decltype(return_type_deduction::add(std::declval<A>(), std::declval<B>()));
+
+/* scalar, avx2 or avx512, see common/cpu_isa.h */
+using cpu::isa;
+using cpu::isa_name;
+
+/* best instruction set available on this CPU */
+isa detected_isa();
+
+/* instruction set the kernels currently use */
+isa active_isa();
+
+/*
+ * Restrict the kernels to an instruction set, e.g. to compare paths in
+ * tests. Requests above detected_isa() are clamped. Returns the new
+ * active_isa().
+ */
+isa set_isa(isa requested);
+
+template<class A, class B>
+void add(const A* a, const B* b, promote_t<A, B>* out, std::size_t n);
+
+template<class A, class B>
+void sub(const A* a, const B* b, promote_t<A, B>* out, std::size_t n);
+
+template<class A, class B>
+void mul(const A* a, const B* b, promote_t<A, B>* out, std::size_t n);
+
+template<class A, class B>
+void fma(const A* a, const B* b, const promote_t<A, B>* c, promote_t<A, B>* out, std::size_t n);
+
+/*
+ * out[i] = static_cast<R>(a[i]) for widening conversions, i.e. when
+ * promote_t<A, R> is R. R is int32_t, float or double.
+ */
+template<class R, class A>
+void convert(const A* a, R* out, std::size_t n);
+
+} // simd
+} // cxx11
+} // pluto
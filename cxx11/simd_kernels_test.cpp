@@ -0,0 +1,129 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 15:32:17
+ * @brief
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <type_traits>
+#include <gtest/gtest.h>
+
+#include "simd_kernels.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx11;
+using namespace pluto::cxx11::simd;
+
+namespace
+{
+
+template<class... Ts>
+struct type_list {};
+
+using supported = type_list<int8_t, uint8_t, int16_t, uint16_t, int32_t, float, double>;
+
+/* small values, and quarters for floating types, keep every result exact */
+template<class T>
+vector<T> random_array(size_t n, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> dist(std::is_signed_v<T> ? -40 : 0, 40);
+	vector<T> v(n);
+	for (auto& x : v)
+	{
+		if constexpr (std::is_floating_point_v<T>) x = static_cast<T>(dist(gen)) / 4;
+		else x = static_cast<T>(dist(gen));
+	}
+	return v;
+}
+
+template<class A, class B>
+void check_pair()
+{
+	using R = promote_t<A, B>;
+	static_assert(std::is_same_v<R, decltype(return_type_deduction::add(A{}, B{}))>);
+
+	// odd length, so every kernel also runs its scalar tail
+	const size_t n = 103;
+	auto a = random_array<A>(n, 1);
+	auto b = random_array<B>(n, 2);
+	auto c = random_array<R>(n, 3);
+	vector<R> out(n);
+
+	add(a.data(), b.data(), out.data(), n);
+	for (size_t i = 0; i < n; ++i) ASSERT_EQ(return_type_deduction::add(a[i], b[i]), out[i]) << i;
+
+	sub(a.data(), b.data(), out.data(), n);
+	for (size_t i = 0; i < n; ++i) ASSERT_EQ(static_cast<R>(a[i] - b[i]), out[i]) << i;
+
+	mul(a.data(), b.data(), out.data(), n);
+	for (size_t i = 0; i < n; ++i) ASSERT_EQ(static_cast<R>(a[i] * b[i]), out[i]) << i;
+
+	simd::fma(a.data(), b.data(), c.data(), out.data(), n);
+	for (size_t i = 0; i < n; ++i) ASSERT_EQ(static_cast<R>(a[i] * b[i] + c[i]), out[i]) << i;
+}
+
+template<class A, class... Bs>
+void check_row(type_list<Bs...>)
+{
+	(check_pair<A, Bs>(), ...);
+}
+
+template<class... As>
+void check_all(type_list<As...> all)
+{
+	(check_row<As>(all), ...);
+}
+
+template<class R, class A>
+void check_convert()
+{
+	const size_t n = 37;
+	auto a = random_array<A>(n, 4);
+	vector<R> out(n);
+	convert(a.data(), out.data(), n);
+	for (size_t i = 0; i < n; ++i) ASSERT_EQ(static_cast<R>(a[i]), out[i]) << i;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX11_SIMD_KERNELS) {
+
+	TEST_COUT << "detected " << isa_name(detected_isa()) << endl;
+
+	for (isa i : { isa::scalar, isa::avx2, isa::avx512 })
+	{
+		if (set_isa(i) != i) continue;
+		TEST_COUT << "checking " << isa_name(i) << endl;
+
+		check_all(supported{});
+
+		check_convert<int32_t, int8_t>();
+		check_convert<int32_t, uint16_t>();
+		check_convert<float, int16_t>();
+		check_convert<float, uint8_t>();
+		check_convert<double, int32_t>();
+		check_convert<double, float>();
+	}
+
+	set_isa(detected_isa());
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// the output type is deduced like add() does
+		int16_t a[] = { 1, 2, 3 };
+		float b[] = { 0.5f, 0.5f, 0.5f };
+		promote_t<int16_t, float> out[3];
+		static_assert(std::is_same_v<decltype(out[0]), float&>);
+
+		add(a, b, out, 3);
+		TEST_COUT << out[0] << ' ' << out[1] << ' ' << out[2] << endl;   // 1.5 2.5 3.5
+	}
+}
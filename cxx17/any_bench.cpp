@@ -0,0 +1,83 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 19:40:12
+ * @brief
+ */
+
+#include <any>
+#include <array>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "any.h"
+
+using namespace std;
+
+/* 64 bytes, too big for the small buffer, assignment allocates */
+using big_t = array<char, 64>;
+
+template<class T>
+static T make_value(int i)
+{
+	if constexpr (is_same_v<T, int>) return i;
+	else if constexpr (is_same_v<T, string>) return string(32, static_cast<char>('a' + (i & 15)));
+	else return T{ static_cast<char>(i) };
+}
+
+/* a = value, the old contained object is destroyed each time */
+template<class T>
+static void BM_AnyAssign(benchmark::State& state)
+{
+	std::any a;
+	int i = 0;
+	for (auto _ : state)
+	{
+		a = make_value<T>(i++);
+		benchmark::DoNotOptimize(&a);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* any_cast<T>(a) returns a copy, any_cast<T>(&a) a pointer or nullptr */
+template<class T>
+static void BM_AnyCast_Value(benchmark::State& state)
+{
+	std::any a = make_value<T>(7);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::any_cast<T>(a));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<class T>
+static void BM_AnyCast_Pointer(benchmark::State& state)
+{
+	std::any a = make_value<T>(7);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::any_cast<T>(&a));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* the failing cast, checked through the pointer form instead of catching bad_any_cast */
+static void BM_AnyCast_Mismatch(benchmark::State& state)
+{
+	std::any a = 7;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::any_cast<double>(&a));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_AnyAssign, int);
+BENCHMARK_TEMPLATE(BM_AnyAssign, string);
+BENCHMARK_TEMPLATE(BM_AnyAssign, big_t);
+BENCHMARK_TEMPLATE(BM_AnyCast_Value, int);
+BENCHMARK_TEMPLATE(BM_AnyCast_Value, string);
+BENCHMARK_TEMPLATE(BM_AnyCast_Pointer, int);
+BENCHMARK_TEMPLATE(BM_AnyCast_Pointer, string);
+BENCHMARK(BM_AnyCast_Mismatch);
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include "any.h"
+#include "common/alloc_counter.h"
 #include "common/define.h"
 
 using namespace std;
@@ -58,4 +59,10 @@ TEST(PLUTO, CXX17_ANY) {
 	a = 1;
 	int* i = std::any_cast<int>(&a);
 	TEST_COUT << *i << "\n";
+
+	// small nothrow-movable values are stored inside the any, anything else is new'ed
+	std::any b;
+	EXPECT_NO_ALLOCATIONS({ b = 1; b = 3.14; b = true; });
+	EXPECT_ALLOCATIONS_LE(1, { b = s; });	// "123456" fits the string's own buffer, only the holder is allocated
+	EXPECT_NO_ALLOCATIONS({ b = 2; });		// frees the holder
 }
\ No newline at end of file
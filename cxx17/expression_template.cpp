@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 14:20:33
+ * @brief
+ */
+
+#include "expression_template.h"
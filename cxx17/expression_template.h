@@ -0,0 +1,380 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 14:20:33
+ * @brief
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cxx11/trailing_return_type.h"
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace expression_template
+{
+
+/*
+ * With plain std::vector operators, a + b + c * d evaluates as
+ *
+ *		t1 = a + b;		// loop 1, allocation 1
+ *		t2 = c * d;		// loop 2, allocation 2
+ *		r  = t1 + t2;	// loop 3, allocation 3
+ *
+ * Expression templates make the operators return a small object that
+ * only remembers WHAT to compute, e.g. for the expression above
+ *
+ *		binary<plus, binary<plus, A, B>, binary<multiplies, C, D>>
+ *
+ * and nothing is computed until the tree is assigned to a vec. The
+ * assignment then runs a single loop, r[i] = (a[i] + b[i]) + c[i] * d[i],
+ * which the compiler inlines and vectorizes like hand written code.
+ *
+ * The element type of every node is deduced the same way as
+ * cxx11::return_type_deduction::add, i.e. decltype(x + y):
+ *
+ *		vec<short> + vec<float>		-> float
+ *		vec<int> * vec<double>		-> double
+ *
+ * Operands are held by reference (terminal, see lazy()) or by value (inner nodes,
+ * scalars), so an expression must not outlive the vectors it reads.
+ *
+ * A scalar has no length, it fits any. is_broadcast tells such nodes
+ * apart, size() is only asked of the others, so an empty vec is still
+ * an operand of length 0 that must match the rest.
+ */
+
+/* element type of an expression */
+template<class E>
+using value_t = std::decay_t<decltype(std::declval<const E&>()[std::size_t{}])>;
+
+template<class T>
+struct is_expression : std::false_type {};
+
+template<class T>
+constexpr bool is_expression_v = is_expression<std::decay_t<T>>::value;
+
+/* a node with the same value at every index: a scalar or built only from scalars */
+template<class T>
+struct is_broadcast : std::false_type {};
+
+template<class T>
+constexpr bool is_broadcast_v = is_broadcast<std::decay_t<T>>::value;
+
+// operations, all promoting like return_type_deduction::add
+
+struct plus
+{
+	template<class A, class B>
+	auto operator()(A x, B y) const -> decltype(x + y)
+	{
+		return cxx11::return_type_deduction::add(x, y);
+	}
+};
+
+struct minus
+{
+	template<class A, class B>
+	auto operator()(A x, B y) const -> decltype(x - y) { return x - y; }
+};
+
+struct multiplies
+{
+	template<class A, class B>
+	auto operator()(A x, B y) const -> decltype(x * y) { return x * y; }
+};
+
+struct divides
+{
+	template<class A, class B>
+	auto operator()(A x, B y) const -> decltype(x / y) { return x / y; }
+};
+
+struct negate
+{
+	template<class A>
+	auto operator()(A x) const -> decltype(-x) { return -x; }
+};
+
+// leaves
+
+/* a view of contiguous storage, e.g. a vec or std::vector */
+template<class T>
+class terminal
+{
+public:
+	terminal(const T* data, std::size_t size) : data_(data), size_(size) {}
+
+	const T& operator[](std::size_t i) const { return data_[i]; }
+	std::size_t size() const { return size_; }
+
+private:
+	const T* data_;
+	std::size_t size_;
+};
+
+/* a scalar broadcast to every element */
+template<class T>
+class scalar
+{
+public:
+	explicit scalar(T value) : value_(value) {}
+
+	T operator[](std::size_t) const { return value_; }
+
+private:
+	T value_;
+};
+
+// inner nodes
+
+template<class Op, class E>
+class unary
+{
+public:
+	unary(Op op, E e) : op_(op), e_(std::move(e)) {}
+
+	auto operator[](std::size_t i) const -> decltype(std::declval<const Op&>()(std::declval<const E&>()[i]))
+	{
+		return op_(e_[i]);
+	}
+
+	std::size_t size() const { return e_.size(); }
+
+private:
+	Op op_;
+	E e_;
+};
+
+template<class Op, class L, class R>
+class binary
+{
+public:
+	binary(L l, R r) : l_(std::move(l)), r_(std::move(r))
+	{
+		if constexpr (!is_broadcast_v<L> && !is_broadcast_v<R>) assert(l_.size() == r_.size());
+	}
+
+	auto operator[](std::size_t i) const -> decltype(Op{}(std::declval<const L&>()[i], std::declval<const R&>()[i]))
+	{
+		return Op{}(l_[i], r_[i]);
+	}
+
+	std::size_t size() const
+	{
+		if constexpr (is_broadcast_v<L>) return r_.size();
+		else return l_.size();
+	}
+
+private:
+	L l_;
+	R r_;
+};
+
+/*
+ * n-ary sum, one node instead of a chain of binary ones. The element is
+ * a unary left fold over the operands: (... + es[i]).
+ */
+template<class... Es>
+class sum_node
+{
+public:
+	explicit sum_node(Es... es) : es_(std::move(es)...) {}
+
+	auto operator[](std::size_t i) const
+	{
+		return std::apply([i](const Es&... es) { return (... + es[i]); }, es_);
+	}
+
+	std::size_t size() const
+	{
+		return std::apply([](const Es&... es) {
+			std::size_t n = 0;
+			bool known = false;
+			([&](const auto& e) {
+				if constexpr (!is_broadcast_v<decltype(e)>)
+				{
+					assert(!known || n == e.size());
+					n = e.size();
+					known = true;
+				}
+			}(es), ...);
+			return n;
+		}, es_);
+	}
+
+private:
+	std::tuple<Es...> es_;
+};
+
+template<class T> struct is_expression<terminal<T>> : std::true_type {};
+template<class T> struct is_expression<scalar<T>> : std::true_type {};
+template<class Op, class E> struct is_expression<unary<Op, E>> : std::true_type {};
+template<class Op, class L, class R> struct is_expression<binary<Op, L, R>> : std::true_type {};
+template<class... Es> struct is_expression<sum_node<Es...>> : std::true_type {};
+
+template<class T> struct is_broadcast<scalar<T>> : std::true_type {};
+template<class Op, class E> struct is_broadcast<unary<Op, E>> : is_broadcast<E> {};
+template<class Op, class L, class R> struct is_broadcast<binary<Op, L, R>> : std::bool_constant<is_broadcast_v<L> && is_broadcast_v<R>> {};
+template<class... Es> struct is_broadcast<sum_node<Es...>> : std::bool_constant<(is_broadcast_v<Es> && ...)> {};
+
+/*
+ * vec<T> owns its elements like std::vector and is the place where
+ * expressions get evaluated: construction or assignment from an
+ * expression runs the one fused loop.
+ */
+template<class T>
+class vec
+{
+public:
+	using value_type = T;
+
+	vec() = default;
+	explicit vec(std::size_t n, T value = T()) : data_(n, value) {}
+	vec(std::initializer_list<T> il) : data_(il) {}
+	explicit vec(std::vector<T> v) : data_(std::move(v)) {}
+
+	template<class E, std::enable_if_t<is_expression_v<E>, int> = 0>
+	vec(const E& e) : data_(e.size())
+	{
+		static_assert(!is_broadcast_v<E>, "an expression of scalars has no length");
+		assign(e);
+	}
+
+	template<class E, std::enable_if_t<is_expression_v<E>, int> = 0>
+	vec& operator=(const E& e)
+	{
+		static_assert(!is_broadcast_v<E>, "an expression of scalars has no length");
+		if (data_.size() == e.size())
+		{
+			// e may read from *this, element i only depends on element i
+			assign(e);
+		}
+		else
+		{
+			// e may still point into the old buffer, fill a new one first
+			vec fresh(e);
+			data_.swap(fresh.data_);
+		}
+		return *this;
+	}
+
+	/* e is an expression, a vec or a scalar */
+	template<class E>
+	vec& operator+=(const E& e) { return *this = *this + e; }
+
+	template<class E>
+	vec& operator*=(const E& e) { return *this = *this * e; }
+
+	T& operator[](std::size_t i) { return data_[i]; }
+	const T& operator[](std::size_t i) const { return data_[i]; }
+	std::size_t size() const { return data_.size(); }
+	T* data() { return data_.data(); }
+	const T* data() const { return data_.data(); }
+	auto begin() { return data_.begin(); }
+	auto end() { return data_.end(); }
+	auto begin() const { return data_.begin(); }
+	auto end() const { return data_.end(); }
+
+	const std::vector<T>& std_vector() const { return data_; }
+
+	friend bool operator==(const vec& a, const vec& b) { return a.data_ == b.data_; }
+
+private:
+	template<class E>
+	void assign(const E& e)
+	{
+		T* out = data_.data();
+		const std::size_t n = data_.size();
+		for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<T>(e[i]);
+	}
+
+	std::vector<T> data_;
+};
+
+// turn operands into expression nodes
+
+template<class T>
+terminal<T> lazy(const std::vector<T>& v) { return terminal<T>(v.data(), v.size()); }
+
+template<class T>
+terminal<T> lazy(const vec<T>& v) { return terminal<T>(v.data(), v.size()); }
+
+template<class T>
+decltype(auto) as_expr(const T& x)
+{
+	if constexpr (is_expression_v<T>) return (x);
+	else if constexpr (std::is_arithmetic_v<T>) return scalar<T>(x);
+	else return lazy(x);
+}
+
+template<class T>
+using as_expr_t = std::decay_t<decltype(as_expr(std::declval<const T&>()))>;
+
+template<class T>
+struct is_operand : std::bool_constant<is_expression_v<T>> {};
+
+template<class T>
+struct is_operand<vec<T>> : std::true_type {};
+
+template<class L, class R>
+constexpr bool enable_operator_v = is_operand<std::decay_t<L>>::value || is_operand<std::decay_t<R>>::value;
+
+// operators, an expression or a vec on at least one side
+
+#define PLUTO_EXPRESSION_OPERATOR(SYMBOL, OP)										\
+template<class L, class R, std::enable_if_t<enable_operator_v<L, R>, int> = 0>		\
+binary<OP, as_expr_t<L>, as_expr_t<R>> operator SYMBOL(const L& l, const R& r)		\
+{																					\
+	return { as_expr(l), as_expr(r) };												\
+}
+
+PLUTO_EXPRESSION_OPERATOR(+, plus)
+PLUTO_EXPRESSION_OPERATOR(-, minus)
+PLUTO_EXPRESSION_OPERATOR(*, multiplies)
+PLUTO_EXPRESSION_OPERATOR(/, divides)
+
+#undef PLUTO_EXPRESSION_OPERATOR
+
+template<class E, std::enable_if_t<is_operand<std::decay_t<E>>::value, int> = 0>
+unary<negate, as_expr_t<E>> operator-(const E& e)
+{
+	return { negate{}, as_expr(e) };
+}
+
+/* element-wise f(e[i]) */
+template<class F, class E>
+unary<F, as_expr_t<E>> elementwise(F f, const E& e)
+{
+	return { f, as_expr(e) };
+}
+
+/* sum(a, b, c, d) == a + b + c + d, as one flat node */
+template<class... Ts>
+sum_node<as_expr_t<Ts>...> sum(const Ts&... ts)
+{
+	static_assert(sizeof...(Ts) > 0);
+	return sum_node<as_expr_t<Ts>...>(as_expr(ts)...);
+}
+
+/* evaluate into a vec of the promoted element type */
+template<class E>
+vec<value_t<as_expr_t<E>>> eval(const E& e)
+{
+	return vec<value_t<as_expr_t<E>>>(as_expr(e));
+}
+
+} // expression_template
+} // cxx17
+} // pluto
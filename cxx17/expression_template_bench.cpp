@@ -0,0 +1,82 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 14:20:33
+ * @brief
+ */
+
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "expression_template.h"
+
+using namespace std;
+using namespace pluto::cxx17::expression_template;
+
+namespace naive
+{
+
+/* what an eager std::vector operator does : a loop and a temporary */
+template<class T, class Op>
+vector<T> apply(const vector<T>& a, const vector<T>& b, Op op)
+{
+	vector<T> r(a.size());
+	for (size_t i = 0; i < a.size(); ++i) r[i] = op(a[i], b[i]);
+	return r;
+}
+
+} // naive
+
+static void BM_Naive_Temporaries(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	vector<float> a(n, 1.0f), b(n, 2.0f), c(n, 3.0f), d(n, 4.0f);
+	for (auto _ : state)
+	{
+		// a + b + c * d
+		auto r = naive::apply(naive::apply(a, b, std::plus<>{}), naive::apply(c, d, std::multiplies<>{}), std::plus<>{});
+		benchmark::DoNotOptimize(r.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Expression_Template(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	vec<float> a(n, 1.0f), b(n, 2.0f), c(n, 3.0f), d(n, 4.0f);
+	for (auto _ : state)
+	{
+		vec<float> r = a + b + c * d;
+		benchmark::DoNotOptimize(r.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Expression_Template_Reuse(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	vec<float> a(n, 1.0f), b(n, 2.0f), c(n, 3.0f), d(n, 4.0f), r(n);
+	for (auto _ : state)
+	{
+		r = a + b + c * d;
+		benchmark::DoNotOptimize(r.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Hand_Written(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	vector<float> a(n, 1.0f), b(n, 2.0f), c(n, 3.0f), d(n, 4.0f), r(n);
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < n; ++i) r[i] = a[i] + b[i] + c[i] * d[i];
+		benchmark::DoNotOptimize(r.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Naive_Temporaries)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Expression_Template)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Expression_Template_Reuse)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Hand_Written)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
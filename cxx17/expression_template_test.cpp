@@ -0,0 +1,99 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 14:20:33
+ * @brief
+ */
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <type_traits>
+#include <gtest/gtest.h>
+
+#include "expression_template.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::expression_template;
+
+TEST(PLUTO, CXX17_EXPRESSION_TEMPLATE) {
+
+	{
+		vec<int> a{ 1, 2, 3 }, b{ 10, 20, 30 }, c{ 2, 2, 2 }, d{ 3, 4, 5 };
+
+		// nothing is computed here, e is a tree of references
+		auto e = a + b + c * d;
+		static_assert(!std::is_same_v<decltype(e), vec<int>>);
+
+		vec<int> r = e;
+		EXPECT_EQ((vec<int>{ 17, 30, 43 }), r);
+
+		TEST_COUT;
+		for (int i : r) cout << i << ' ';   // 17 30 43
+		cout << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// promotion follows return_type_deduction::add
+		vec<short> s{ 1, 2, 3 };
+		vec<float> f{ 0.5f, 0.5f, 0.5f };
+		vec<double> d{ 1.0, 1.0, 1.0 };
+
+		static_assert(std::is_same_v<value_t<decltype(s + f)>, float>);
+		static_assert(std::is_same_v<value_t<decltype(s + s)>, int>);
+		static_assert(std::is_same_v<value_t<decltype(s * d)>, double>);
+		static_assert(std::is_same_v<value_t<decltype(s + f)>,
+			decltype(pluto::cxx11::return_type_deduction::add(short{}, 1.0f))>);
+
+		auto r = eval(s + f);
+		EXPECT_EQ((vec<float>{ 1.5f, 2.5f, 3.5f }), r);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		vec<double> a{ 1, 4, 9 };
+		std::vector<double> plain{ 1, 1, 1 };
+
+		// scalars broadcast, std::vector operands join through lazy()
+		vec<double> r = (a - 1.0) / 2.0 + lazy(plain);
+		EXPECT_EQ((vec<double>{ 1, 2.5, 5 }), r);
+
+		r = -a + elementwise([](double x) { return std::sqrt(x); }, a);
+		EXPECT_EQ((vec<double>{ 0, -2, -6 }), r);
+
+		// the fold expression node
+		r = sum(a, a, plain, 1.0);
+		EXPECT_EQ((vec<double>{ 4, 10, 20 }), r);
+
+		// reading and writing the same vec is fine, element i only uses i
+		r += a;
+		r *= 2.0;
+		EXPECT_EQ((vec<double>{ 10, 28, 58 }), r);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// an empty vec is an operand of length 0, not a scalar
+		static_assert(is_broadcast_v<decltype(scalar<int>(1) + 2)>);
+		static_assert(!is_broadcast_v<decltype(vec<int>() + 2)>);
+		vec<int> empty;
+		EXPECT_EQ(0u, (empty + 1).size());
+		EXPECT_EQ(0u, sum(1, empty, 2).size());
+		EXPECT_EQ(0u, eval(empty * 2).size());
+
+		// assigning a different length fills a new buffer, the same length writes in place
+		vec<int> a{ 1, 2, 3 };
+		vec<int> r;
+		r = a + a;
+		EXPECT_EQ((vec<int>{ 2, 4, 6 }), r);
+		const int* data = r.data();
+		r = sum(lazy(r.std_vector()), 1) * 10 + r;
+		EXPECT_EQ((vec<int>{ 32, 54, 76 }), r);
+		EXPECT_EQ(data, r.data());
+	}
+}
@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 10:41:05
+ * @brief
+ */
+
+#include "flat_map.h"
@@ -0,0 +1,431 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 10:41:05
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace flat
+{
+
+/*
+ * flat_set / flat_map keep their elements in one sorted std::vector
+ * instead of a red-black tree. Lookup is a binary search over contiguous
+ * memory and iteration is a plain array walk, both far friendlier to the
+ * cache than chasing std::set nodes. The price is insertion: a single
+ * insert shifts the tail of the vector.
+ *
+ * That price is paid once per batch with insert_all / insert_range:
+ *
+ *	1) the batch is sorted (stable, so the first of equal keys wins,
+ *	   like a sequence of single inserts would),
+ *	2) duplicates inside the batch and keys already present are dropped,
+ *	3) storage is reserved once and the survivors are appended,
+ *	4) one linear std::inplace_merge restores the order.
+ *
+ * Compare with fold_expression::insert_all, which does one node
+ * allocation per argument and stops at the first duplicate:
+ *
+ *		flat_set<int> s{ 1, 2, 3 };
+ *		auto ok = s.insert_all(7, 2, 8); // ok == 0b101, s == {1, 2, 3, 7, 8}
+ *
+ * Bit i of the returned mask tells whether argument i was inserted.
+ *
+ * Keys are never writable through an iterator, the order find / insert /
+ * erase rely on would break: a flat_set hands out const iterators only,
+ * like std::set, and a flat_map iterator dereferences to a
+ * std::pair<const Key&, T&>, like C++23 std::flat_map, so
+ *
+ *		m.begin()->second = 1;	// fine
+ *		m.begin()->first = 7;	// does not compile
+ *		for (auto [k, v] : m) v *= 2;
+ */
+
+namespace detail
+{
+
+struct identity_key
+{
+	template<class T>
+	const T& operator()(const T& v) const { return v; }
+};
+
+struct first_key
+{
+	template<class P>
+	const typename P::first_type& operator()(const P& v) const { return v.first; }
+};
+
+/*
+ * flat_map::iterator: random access over the vector of pairs, but *it is
+ * a pair of references with a const key.
+ */
+template<class Key, class T>
+class pair_ref_iterator
+{
+	using base = typename std::vector<std::pair<Key, T>>::iterator;
+	using const_base = typename std::vector<std::pair<Key, T>>::const_iterator;
+
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::pair<Key, T>;
+	using difference_type = std::ptrdiff_t;
+	using reference = std::pair<const Key&, T&>;
+
+	/* it->second needs an address, the pair of references lives in here */
+	class pointer
+	{
+	public:
+		explicit pointer(reference r) : ref_(r) {}
+		const reference* operator->() const { return &ref_; }
+
+	private:
+		reference ref_;
+	};
+
+	pair_ref_iterator() = default;
+	explicit pair_ref_iterator(base it) : it_(it) {}
+
+	/* e.g. for erase(const_iterator) */
+	operator const_base() const { return it_; }
+
+	reference operator*() const { return { it_->first, it_->second }; }
+	pointer operator->() const { return pointer(**this); }
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	pair_ref_iterator& operator++() { ++it_; return *this; }
+	pair_ref_iterator& operator--() { --it_; return *this; }
+	pair_ref_iterator operator++(int) { return pair_ref_iterator(it_++); }
+	pair_ref_iterator operator--(int) { return pair_ref_iterator(it_--); }
+	pair_ref_iterator& operator+=(difference_type n) { it_ += n; return *this; }
+	pair_ref_iterator& operator-=(difference_type n) { it_ -= n; return *this; }
+
+	friend pair_ref_iterator operator+(pair_ref_iterator a, difference_type n) { return a += n; }
+	friend pair_ref_iterator operator+(difference_type n, pair_ref_iterator a) { return a += n; }
+	friend pair_ref_iterator operator-(pair_ref_iterator a, difference_type n) { return a -= n; }
+	friend difference_type operator-(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ - b.it_; }
+
+	friend bool operator==(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ == b.it_; }
+	friend bool operator!=(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ != b.it_; }
+	friend bool operator<(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ < b.it_; }
+	friend bool operator>(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ > b.it_; }
+	friend bool operator<=(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ <= b.it_; }
+	friend bool operator>=(const pair_ref_iterator& a, const pair_ref_iterator& b) { return a.it_ >= b.it_; }
+
+private:
+	base it_{};
+};
+
+/* Iterator is what the non-const members hand out, built from a vector iterator */
+template<class Key, class Value, class KeyOf, class Compare, class Iterator>
+class flat_tree
+{
+public:
+	using key_type = Key;
+	using value_type = Value;
+	using key_compare = Compare;
+	using container_type = std::vector<Value>;
+	using size_type = std::size_t;
+	using iterator = Iterator;
+	using const_iterator = typename container_type::const_iterator;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	flat_tree() = default;
+
+	explicit flat_tree(const Compare& comp) : comp_(comp) {}
+
+	template<class It>
+	flat_tree(It first, It last, const Compare& comp = Compare()) : comp_(comp)
+	{
+		insert_range(first, last);
+	}
+
+	flat_tree(std::initializer_list<Value> il, const Compare& comp = Compare())
+		: flat_tree(il.begin(), il.end(), comp) {}
+
+	iterator begin() noexcept { return iterator(data_.begin()); }
+	iterator end() noexcept { return iterator(data_.end()); }
+	const_iterator begin() const noexcept { return data_.begin(); }
+	const_iterator end() const noexcept { return data_.end(); }
+	const_iterator cbegin() const noexcept { return data_.cbegin(); }
+	const_iterator cend() const noexcept { return data_.cend(); }
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	bool empty() const noexcept { return data_.empty(); }
+	size_type size() const noexcept { return data_.size(); }
+	size_type capacity() const noexcept { return data_.capacity(); }
+	void reserve(size_type n) { data_.reserve(n); }
+	void shrink_to_fit() { data_.shrink_to_fit(); }
+	void clear() noexcept { data_.clear(); }
+
+	key_compare key_comp() const { return comp_; }
+
+	/* the underlying sorted vector, e.g. for std::span or memcpy */
+	const container_type& sequence() const noexcept { return data_; }
+
+	iterator lower_bound(const Key& k)
+	{
+		return iterator(base_lower_bound(k));
+	}
+
+	const_iterator lower_bound(const Key& k) const
+	{
+		return std::lower_bound(data_.begin(), data_.end(), k, key_less());
+	}
+
+	iterator upper_bound(const Key& k)
+	{
+		return iterator(std::upper_bound(data_.begin(), data_.end(), k, less_key()));
+	}
+
+	const_iterator upper_bound(const Key& k) const
+	{
+		return std::upper_bound(data_.begin(), data_.end(), k, less_key());
+	}
+
+	std::pair<iterator, iterator> equal_range(const Key& k)
+	{
+		return { lower_bound(k), upper_bound(k) };
+	}
+
+	std::pair<const_iterator, const_iterator> equal_range(const Key& k) const
+	{
+		return { lower_bound(k), upper_bound(k) };
+	}
+
+	iterator find(const Key& k)
+	{
+		auto it = lower_bound(k);
+		return it != end() && !comp_(k, KeyOf()(*it)) ? it : end();
+	}
+
+	const_iterator find(const Key& k) const
+	{
+		auto it = lower_bound(k);
+		return it != end() && !comp_(k, KeyOf()(*it)) ? it : end();
+	}
+
+	bool contains(const Key& k) const { return find(k) != end(); }
+
+	size_type count(const Key& k) const { return contains(k) ? 1 : 0; }
+
+	std::pair<iterator, bool> insert(const Value& v) { return emplace(v); }
+
+	std::pair<iterator, bool> insert(Value&& v) { return emplace(std::move(v)); }
+
+	template<class... Args>
+	std::pair<iterator, bool> emplace(Args&&... args)
+	{
+		Value v(std::forward<Args>(args)...);
+		auto it = base_lower_bound(KeyOf()(v));
+		if (it != data_.end() && !comp_(KeyOf()(v), KeyOf()(*it))) return { iterator(it), false };
+		return { iterator(data_.insert(it, std::move(v))), true };
+	}
+
+	/*
+	 * Bulk insert of [first, last), one reserve, one sort, one merge.
+	 * Element i of the result tells whether the i-th value was inserted.
+	 */
+	template<class It>
+	std::vector<bool> insert_range(It first, It last)
+	{
+		std::vector<Value> batch(first, last);
+		std::vector<bool> ok(batch.size());
+		merge_batch(batch, [&ok](std::size_t i) { ok[i] = true; });
+		return ok;
+	}
+
+	/* variadic bulk insert, bit i is set if argument i was inserted */
+	template<class... Ts>
+	std::bitset<sizeof...(Ts)> insert_all(Ts&&... ts)
+	{
+		static_assert((std::is_constructible_v<Value, Ts&&> && ...));
+
+		std::vector<Value> batch;
+		batch.reserve(sizeof...(Ts));
+		(batch.emplace_back(std::forward<Ts>(ts)), ...);
+
+		std::bitset<sizeof...(Ts)> ok;
+		merge_batch(batch, [&ok](std::size_t i) { ok.set(i); });
+		return ok;
+	}
+
+	iterator erase(const_iterator pos) { return iterator(data_.erase(pos)); }
+
+	iterator erase(const_iterator first, const_iterator last) { return iterator(data_.erase(first, last)); }
+
+	size_type erase(const Key& k)
+	{
+		auto it = std::as_const(*this).find(k);
+		if (it == cend()) return 0;
+		data_.erase(it);
+		return 1;
+	}
+
+	void swap(flat_tree& other) noexcept
+	{
+		using std::swap;
+		swap(data_, other.data_);
+		swap(comp_, other.comp_);
+	}
+
+	friend bool operator==(const flat_tree& a, const flat_tree& b) { return a.data_ == b.data_; }
+	friend bool operator!=(const flat_tree& a, const flat_tree& b) { return a.data_ != b.data_; }
+
+protected:
+	typename container_type::iterator base_lower_bound(const Key& k)
+	{
+		return std::lower_bound(data_.begin(), data_.end(), k, key_less());
+	}
+
+	/* value < key, for lower_bound */
+	auto key_less() const
+	{
+		return [this](const Value& v, const Key& k) { return comp_(KeyOf()(v), k); };
+	}
+
+	/* key < value, for upper_bound */
+	auto less_key() const
+	{
+		return [this](const Key& k, const Value& v) { return comp_(k, KeyOf()(v)); };
+	}
+
+	template<class Mark>
+	void merge_batch(std::vector<Value>& batch, Mark mark)
+	{
+		const std::size_t n = batch.size();
+		if (n == 0) return;
+
+		auto value_less = [this](const Value& a, const Value& b) {
+			return comp_(KeyOf()(a), KeyOf()(b));
+		};
+
+		// 1) sort the batch through an index, so results map back to arguments
+		std::vector<std::size_t> order(n);
+		std::iota(order.begin(), order.end(), std::size_t{ 0 });
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+			return value_less(batch[a], batch[b]);
+		});
+
+		// 2) keep the first of equal keys and drop keys we already hold,
+		//    the cursor into data_ only moves forward
+		std::vector<std::size_t> accepted;
+		accepted.reserve(n);
+		auto cursor = data_.begin();
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			const Value& v = batch[order[j]];
+			if (j > 0 && !value_less(batch[order[j - 1]], v)) continue;
+
+			cursor = std::lower_bound(cursor, data_.end(), KeyOf()(v), key_less());
+			if (cursor != data_.end() && !comp_(KeyOf()(v), KeyOf()(*cursor))) continue;
+
+			accepted.push_back(order[j]);
+		}
+
+		if (accepted.empty()) return;
+
+		// 3) grow once, geometrically so a stream of small batches stays
+		//    amortised, and append the survivors, already sorted
+		const std::size_t old_size = data_.size();
+		if (old_size + accepted.size() > data_.capacity())
+		{
+			data_.reserve(std::max(old_size + accepted.size(), 2 * data_.capacity()));
+		}
+		for (std::size_t i : accepted)
+		{
+			data_.push_back(std::move(batch[i]));
+			mark(i);
+		}
+
+		// 4) one linear merge, skipped when the batch sorts after everything
+		auto mid = data_.begin() + static_cast<std::ptrdiff_t>(old_size);
+		if (old_size != 0 && value_less(*mid, *(mid - 1)))
+		{
+			std::inplace_merge(data_.begin(), mid, data_.end(), value_less);
+		}
+	}
+
+	container_type data_;
+	Compare comp_;
+};
+
+} // detail
+
+template<class Key, class Compare = std::less<Key>>
+class flat_set : public detail::flat_tree<Key, Key, detail::identity_key, Compare,
+	typename std::vector<Key>::const_iterator>
+{
+	using base = detail::flat_tree<Key, Key, detail::identity_key, Compare,
+		typename std::vector<Key>::const_iterator>;
+
+public:
+	using base::base;
+};
+
+template<class Key, class T, class Compare = std::less<Key>>
+class flat_map : public detail::flat_tree<Key, std::pair<Key, T>, detail::first_key, Compare,
+	detail::pair_ref_iterator<Key, T>>
+{
+	using base = detail::flat_tree<Key, std::pair<Key, T>, detail::first_key, Compare,
+		detail::pair_ref_iterator<Key, T>>;
+
+public:
+	using mapped_type = T;
+	using typename base::iterator;
+
+	using base::base;
+
+	template<class... Args>
+	std::pair<iterator, bool> try_emplace(const Key& k, Args&&... args)
+	{
+		auto it = this->base_lower_bound(k);
+		if (it != this->data_.end() && !this->comp_(k, it->first)) return { iterator(it), false };
+		it = this->data_.emplace(it, std::piecewise_construct,
+			std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Args>(args)...));
+		return { iterator(it), true };
+	}
+
+	T& operator[](const Key& k) { return try_emplace(k).first->second; }
+
+	T& at(const Key& k)
+	{
+		auto it = this->find(k);
+		if (it == this->end()) throw std::out_of_range("flat_map::at");
+		return it->second;
+	}
+
+	const T& at(const Key& k) const
+	{
+		auto it = this->find(k);
+		if (it == this->end()) throw std::out_of_range("flat_map::at");
+		return it->second;
+	}
+};
+
+} // flat
+} // cxx17
+} // pluto
@@ -0,0 +1,97 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 10:41:05
+ * @brief
+ */
+
+#include <set>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+
+#include "flat_map.h"
+#include "fold_expression.h"
+
+using namespace std;
+using namespace pluto::cxx17::flat;
+
+namespace
+{
+
+vector<uint32_t> random_keys(size_t n, uint32_t seed)
+{
+	std::mt19937 gen(seed);
+	vector<uint32_t> keys(n);
+	for (auto& k : keys) k = gen();
+	return keys;
+}
+
+} // namespace
+
+template<class Set>
+static void BM_Lookup(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	auto keys = random_keys(n, 1);
+	Set s(keys.begin(), keys.end());
+	auto probes = random_keys(1 << 16, 2);
+	for (size_t i = 0; i < probes.size(); i += 2) probes[i] = keys[i % n];
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(s.find(probes[i++ & 0xffff]));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+template<class Set>
+static void BM_Iterate(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	auto keys = random_keys(n, 1);
+	Set s(keys.begin(), keys.end());
+
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (auto k : s) sum += k;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(s.size()));
+}
+
+static void BM_InsertAll_StdSet(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		std::set<int> s;
+		for (int i = 0; i < 1024; i += 8)
+		{
+			pluto::cxx17::fold_expression::insert_all(s, i + 7, i + 3, i + 5, i + 1, i + 6, i + 2, i + 4, i);
+		}
+		benchmark::DoNotOptimize(s);
+	}
+}
+
+static void BM_InsertAll_FlatSet(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		flat_set<int> s;
+		for (int i = 0; i < 1024; i += 8)
+		{
+			s.insert_all(i + 7, i + 3, i + 5, i + 1, i + 6, i + 2, i + 4, i);
+		}
+		benchmark::DoNotOptimize(s);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_Lookup, std::set<uint32_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Lookup, flat_set<uint32_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, std::set<uint32_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, flat_set<uint32_t>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_InsertAll_StdSet);
+BENCHMARK(BM_InsertAll_FlatSet);
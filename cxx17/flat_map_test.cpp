@@ -0,0 +1,151 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 10:41:05
+ * @brief
+ */
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "flat_map.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::flat;
+
+namespace
+{
+
+template<class It, class V, class = void>
+struct can_assign_element : std::false_type {};
+
+template<class It, class V>
+struct can_assign_element<It, V, std::void_t<decltype(*std::declval<It>() = std::declval<V>())>> : std::true_type {};
+
+template<class It, class K, class = void>
+struct can_assign_key : std::false_type {};
+
+template<class It, class K>
+struct can_assign_key<It, K, std::void_t<decltype(std::declval<It>()->first = std::declval<K>())>> : std::true_type {};
+
+template<class It, class T, class = void>
+struct can_assign_mapped : std::false_type {};
+
+template<class It, class T>
+struct can_assign_mapped<It, T, std::void_t<decltype(std::declval<It>()->second = std::declval<T>())>> : std::true_type {};
+
+} // namespace
+
+TEST(PLUTO, CXX17_FLAT_MAP) {
+
+	{
+		flat_set<int> s{ 1, 2, 3 };
+
+		// all new, the batch sorts after the existing keys
+		EXPECT_EQ(0b111u, s.insert_all(4, 5, 6).to_ulong());
+
+		// unlike insert_all(set, ...) we keep going after the duplicate 2
+		auto ok = s.insert_all(7, 2, 8);
+		TEST_COUT << ok << endl; // 101
+		EXPECT_EQ(0b101u, ok.to_ulong());
+		EXPECT_EQ((vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8 }), s.sequence());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// a stream of small batches grows the storage geometrically
+		flat_set<int> s;
+		size_t reallocations = 0;
+		size_t capacity = s.capacity();
+		for (int i = 0; i < 1000; ++i)
+		{
+			s.insert_all(2 * i, 2 * i + 1);
+			if (s.capacity() != capacity) ++reallocations;
+			capacity = s.capacity();
+		}
+		EXPECT_EQ(2000u, s.size());
+		EXPECT_LE(reallocations, 12u);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// duplicates inside the batch : the first one wins
+		flat_set<int> s{ 10, 20 };
+		vector<int> batch{ 15, 5, 15, 20, 25, 5 };
+		auto ok = s.insert_range(batch.begin(), batch.end());
+		EXPECT_EQ((vector<bool>{ true, true, false, false, true, false }), ok);
+		EXPECT_EQ((vector<int>{ 5, 10, 15, 20, 25 }), s.sequence());
+
+		TEST_COUT;
+		for (int i : s) cout << i << ' ';
+		cout << endl;
+
+		EXPECT_TRUE(s.contains(15));
+		EXPECT_FALSE(s.contains(16));
+		EXPECT_EQ(1u, s.erase(15));
+		EXPECT_EQ(0u, s.erase(15));
+		EXPECT_EQ(20, *s.upper_bound(10));
+		EXPECT_FALSE(s.insert(20).second);
+		EXPECT_TRUE(s.insert(0).second);
+		EXPECT_EQ(0, *s.begin());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		flat_set<int, std::greater<int>> s{ 1, 3, 2 };
+		EXPECT_EQ((vector<int>{ 3, 2, 1 }), s.sequence());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		flat_map<string, int> m;
+		m["b"] = 2;
+		m["a"] = 1;
+		auto ok = m.insert_all(pair<string, int>{ "c", 3 }, pair<string, int>{ "a", 100 });
+		EXPECT_EQ(0b01u, ok.to_ulong());
+		EXPECT_EQ(1, m.at("a"));
+		EXPECT_EQ(3, m.at("c"));
+		EXPECT_THROW(m.at("z"), std::out_of_range);
+		EXPECT_FALSE(m.try_emplace("b", 20).second);
+
+		TEST_COUT;
+		for (auto [k, v] : m) cout << k << ':' << v << ' ';
+		cout << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// keys are read only through every iterator, mapped values are not
+		static_assert(!can_assign_element<flat_set<int>::iterator, int>::value);
+		static_assert(!can_assign_element<flat_set<int>::reverse_iterator, int>::value);
+		static_assert(!can_assign_key<flat_map<int, int>::iterator, int>::value);
+		static_assert(!can_assign_key<flat_map<int, int>::const_iterator, int>::value);
+		static_assert(can_assign_mapped<flat_map<int, int>::iterator, int>::value);
+		static_assert(!can_assign_mapped<flat_map<int, int>::const_iterator, int>::value);
+
+		flat_map<int, int> m{ { 1, 10 }, { 5, 50 }, { 3, 30 } };
+		m.begin()->second = 11;
+		for (auto [k, v] : m) v += k;
+		(*m.find(5)).second *= 2;
+		EXPECT_EQ((vector<pair<int, int>>{ { 1, 12 }, { 3, 33 }, { 5, 110 } }), m.sequence());
+
+		EXPECT_EQ(5, m.rbegin()->first);
+		EXPECT_EQ(3, (m.end() - 2)->first);
+		EXPECT_EQ(3, m.begin()[1].first);
+
+		auto next = m.erase(m.find(3));
+		EXPECT_EQ(5, next->first);
+		EXPECT_EQ(1u, m.erase(1));
+		EXPECT_EQ((vector<pair<int, int>>{ { 5, 110 } }), m.sequence());
+	}
+}
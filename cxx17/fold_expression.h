@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <vector>
 #include <type_traits>
 
@@ -53,7 +55,19 @@ template<class T, class... Args>
 void push_back_vec(std::vector<T>& v, Args&&... args)
 {
 	static_assert((std::is_constructible_v<T, Args&&> && ...));
-	(v.push_back(std::forward<Args>(args)), ...);
+	if constexpr (sizeof...(Args) != 0)
+	{
+		if (v.capacity() - v.size() >= sizeof...(Args))
+		{
+			(v.push_back(std::forward<Args>(args)), ...);
+			return;
+		}
+		// an argument may be an element of v: build the new elements
+		// before growing, so none of them is read from a released buffer
+		T tail[] = { T(std::forward<Args>(args))... };
+		v.reserve(std::max(v.size() + sizeof...(Args), 2 * v.capacity()));
+		v.insert(v.end(), std::make_move_iterator(std::begin(tail)), std::make_move_iterator(std::end(tail)));
+	}
 }
 
 // (2) ( ... op pack )
@@ -0,0 +1,82 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:09:26
+ * @brief
+ */
+
+#include <set>
+#include <unordered_set>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "fold_expression.h"
+
+using namespace std;
+using namespace pluto::cxx17::fold_expression;
+
+/* count(range, a, b, c) walks the range once per value */
+static void BM_Count(benchmark::State& state)
+{
+	vector<int> v(static_cast<size_t>(state.range(0)));
+	for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(i % 10);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(count(v, 1, 3, 5));
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+/* the same question answered in a single pass */
+static void BM_Count_OnePass(benchmark::State& state)
+{
+	vector<int> v(static_cast<size_t>(state.range(0)));
+	for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(i % 10);
+	for (auto _ : state)
+	{
+		auto n = std::count_if(v.begin(), v.end(), [](int x) { return x == 1 || x == 3 || x == 5; });
+		benchmark::DoNotOptimize(n);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+template<class Set>
+static void BM_InsertAll(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Set s;
+		benchmark::DoNotOptimize(insert_all(s, 6, 2, 45, 12, 7, 9, 31, 4));
+	}
+	state.SetItemsProcessed(state.iterations() * 8);
+}
+
+/* push_back_vec grows once for the pack, then moves the new elements in */
+static void BM_PushBackVec(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		vector<int> v;
+		push_back_vec(v, 6, 2, 45, 12, 7, 9, 31, 4);
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * 8);
+}
+
+static void BM_PushBack_NoReserve(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		vector<int> v;
+		for (int x : { 6, 2, 45, 12, 7, 9, 31, 4 }) v.push_back(x);
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * 8);
+}
+
+BENCHMARK(BM_Count)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Count_OnePass)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_InsertAll, set<int>);
+BENCHMARK_TEMPLATE(BM_InsertAll, unordered_set<int>);
+BENCHMARK(BM_PushBackVec);
+BENCHMARK(BM_PushBack_NoReserve);
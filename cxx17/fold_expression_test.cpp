@@ -5,6 +5,7 @@
  * @brief  
  */
 
+#include <string>
 #include <vector>
 #include <iostream>
 #include <gtest/gtest.h>
@@ -27,6 +28,17 @@ TEST(PLUTO, CXX17_FOLDER_EXPRESSION) {
 
 	TEST_COUT_DELIMITER;
 
+	{
+		// the arguments may be elements of v itself, longer than SSO
+		vector<string> v{ string(64, 'a') };
+		v.shrink_to_fit();
+		push_back_vec(v, v[0], v[0], v[0]);
+		ASSERT_EQ(4u, v.size());
+		for (const string& s : v) EXPECT_EQ(string(64, 'a'), s);
+	}
+
+	TEST_COUT_DELIMITER;
+
 	{
 		// within all(), the unary left fold expands as
 			// return ((true && true) && true) && false;
@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 01:52:19
+ * @brief
+ */
+
+#include "message_queue.h"
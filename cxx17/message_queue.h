@@ -0,0 +1,425 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 01:52:19
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace message_queue
+{
+
+/*
+ * Bounded lock-free queues for passing messages, typically a variant
+ * like std::variant<int, float, std::string>, between threads:
+ *
+ *		mpsc_queue<std::variant<int, float, std::string>, 1024> q;
+ *
+ *		// any number of producers
+ *		q.push(42);
+ *		q.push(std::string("hello"));
+ *
+ *		// one consumer, each message goes straight into the visitor
+ *		q.consume(variant::AddVisitor{});
+ *
+ * Messages are stored inline in a ring of slots, each slot aligned to a
+ * cache line of its own, so a producer writing slot i + 1 does not
+ * invalidate the line the consumer is reading slot i from. Capacity is
+ * a power of two and fixed; a full queue makes try_push() fail and
+ * push() wait.
+ *
+ * consume() calls the visitor on the message where it lies in the slot
+ * (std::visit for variants, a plain call otherwise), destroys it and
+ * frees the slot: no copy into a temporary, no std::optional. The
+ * visitor may take its argument by reference and move out of it.
+ *
+ * spsc_queue is for exactly one producer and one consumer: the two
+ * sides only share the head and tail indices, each keeps a cached copy
+ * of the other's so it touches the other's cache line once per wrap,
+ * not once per message. Batches publish the tail / head once.
+ *
+ * mpsc_queue lets producers race for a position with a CAS on the
+ * tail, then mark the slot ready by its sequence number (Vyukov's
+ * bounded queue, with a single consumer the head needs no CAS).
+ * push_n() claims a run of slots with one CAS, so a batch must be of
+ * messages that cannot throw on the way in, e.g. T itself.
+ *
+ * Compared with std::queue under a std::mutex there is no lock, no
+ * allocation per message (std::deque allocates chunks) and no
+ * condition variable; the price is a fixed capacity and spinning when
+ * the queue is full or empty.
+ */
+
+inline constexpr std::size_t cache_line = 64;
+
+namespace detail
+{
+
+template<class T>
+struct is_variant : std::false_type {};
+
+template<class... Ts>
+struct is_variant<std::variant<Ts...>> : std::true_type {};
+
+template<class T, class Visitor>
+void dispatch(T& message, Visitor& visitor)
+{
+	if constexpr (is_variant<T>::value) std::visit(visitor, message);
+	else visitor(message);
+}
+
+/* raw storage for one message, the object's lifetime is managed by the queue */
+template<class T>
+struct storage
+{
+	alignas(T) unsigned char bytes[sizeof(T)];
+
+	T& get() { return *std::launder(reinterpret_cast<T*>(bytes)); }
+
+	template<class... Args>
+	void construct(Args&&... args) { ::new (static_cast<void*>(bytes)) T(std::forward<Args>(args)...); }
+
+	void destroy() { get().~T(); }
+};
+
+template<class T>
+struct alignas(cache_line) spsc_slot
+{
+	storage<T> value;
+};
+
+template<class T>
+struct alignas(cache_line) mpsc_slot
+{
+	std::atomic<std::size_t> sequence;	// == position: free, == position + 1: holds the message
+	storage<T> value;
+};
+
+/* frees the slot even if the visitor throws */
+template<class Release>
+struct release_guard
+{
+	Release release;
+	~release_guard() { release(); }
+};
+
+template<class Release>
+release_guard(Release) -> release_guard<Release>;
+
+inline void backoff(unsigned& spins)
+{
+	if (++spins > 64) std::this_thread::yield();
+}
+
+} // detail
+
+template<class T, std::size_t Capacity>
+class spsc_queue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static_assert(std::is_nothrow_move_constructible_v<T>, "messages are moved into the slots");
+
+public:
+	spsc_queue() : slots_(new detail::spsc_slot<T>[Capacity]) {}
+
+	~spsc_queue()
+	{
+		// whatever was not consumed
+		const std::size_t tail = tail_.load(std::memory_order_acquire);
+		for (std::size_t h = head_.load(std::memory_order_relaxed); h != tail; ++h) at(h).destroy();
+	}
+
+	spsc_queue(const spsc_queue&) = delete;
+	spsc_queue& operator=(const spsc_queue&) = delete;
+
+	static constexpr std::size_t capacity() { return Capacity; }
+
+	// producer
+
+	template<class... Args>
+	bool try_emplace(Args&&... args)
+	{
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - cached_head_ == Capacity)
+		{
+			cached_head_ = head_.load(std::memory_order_acquire);
+			if (tail - cached_head_ == Capacity) return false;
+		}
+		at(tail).construct(std::forward<Args>(args)...);
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* v is only moved from when the push succeeds */
+	template<class U>
+	bool try_push(U&& v) { return try_emplace(std::forward<U>(v)); }
+
+	template<class U>
+	void push(U&& v)
+	{
+		for (unsigned spins = 0; !try_emplace(std::forward<U>(v));) detail::backoff(spins);
+	}
+
+	/* moves the first n messages of first in, all or none; one release store for the batch */
+	template<class It>
+	bool try_push_n(It first, std::size_t n)
+	{
+		static_assert(std::is_nothrow_constructible_v<T, decltype(std::move(*first))>,
+			"try_push_n: a message that throws half way would leave the batch unpublished, convert to T first");
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (Capacity - (tail - cached_head_) < n)
+		{
+			cached_head_ = head_.load(std::memory_order_acquire);
+			if (Capacity - (tail - cached_head_) < n) return false;
+		}
+		for (std::size_t i = 0; i < n; ++i, ++first) at(tail + i).construct(std::move(*first));
+		tail_.store(tail + n, std::memory_order_release);
+		return true;
+	}
+
+	// consumer
+
+	/* visit up to max messages in order; returns how many */
+	template<class Visitor>
+	std::size_t consume(Visitor&& visitor, std::size_t max = ~std::size_t{ 0 })
+	{
+		return drain([&visitor](T& message) { detail::dispatch(message, visitor); }, max);
+	}
+
+	template<class Visitor>
+	bool consume_one(Visitor&& visitor) { return consume(visitor, 1) == 1; }
+
+	std::optional<T> try_pop()
+	{
+		std::optional<T> out;
+		drain([&out](T& message) { out.emplace(std::move(message)); }, 1);
+		return out;
+	}
+
+	/* a snapshot, exact only when called by one of the two sides while the other is idle */
+	std::size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+
+	bool empty() const { return size() == 0; }
+
+private:
+	detail::storage<T>& at(std::size_t position) { return slots_[position & (Capacity - 1)].value; }
+
+	/* f(T&) on up to max messages, at most one acquire load of the tail and one release store of the head */
+	template<class F>
+	std::size_t drain(F&& f, std::size_t max)
+	{
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		if (cached_tail_ - head < max) cached_tail_ = tail_.load(std::memory_order_acquire);
+		const std::size_t n = std::min(cached_tail_ - head, max);
+		std::size_t done = 0;
+		detail::release_guard publish{ [&] { head_.store(head + done, std::memory_order_release); } };
+		while (done < n)
+		{
+			detail::storage<T>& s = at(head + done);
+			detail::release_guard destroy{ [&] {
+				s.destroy();
+				++done;
+			} };
+			f(s.get());
+		}
+		return done;
+	}
+
+	std::unique_ptr<detail::spsc_slot<T>[]> slots_;
+
+	alignas(cache_line) std::atomic<std::size_t> tail_{ 0 };
+	std::size_t cached_head_ = 0;	// producer's view of head_
+
+	alignas(cache_line) std::atomic<std::size_t> head_{ 0 };
+	std::size_t cached_tail_ = 0;	// consumer's view of tail_
+};
+
+template<class T, std::size_t Capacity>
+class mpsc_queue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static_assert(std::is_nothrow_move_constructible_v<T>, "messages are moved into the slots");
+
+public:
+	mpsc_queue() : slots_(new detail::mpsc_slot<T>[Capacity])
+	{
+		for (std::size_t i = 0; i < Capacity; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~mpsc_queue()
+	{
+		drain([](T&) {}, ~std::size_t{ 0 });
+	}
+
+	mpsc_queue(const mpsc_queue&) = delete;
+	mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+	static constexpr std::size_t capacity() { return Capacity; }
+
+	// producers, any number of threads
+
+	/*
+	 * A slot is claimed before the message is built in it, so building
+	 * must not throw: arguments that could throw are turned into a T
+	 * first and moved in.
+	 */
+	template<class... Args>
+	bool try_emplace(Args&&... args)
+	{
+		if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+		{
+			std::size_t position;
+			if (!claim(1, position)) return false;
+			publish(position, std::forward<Args>(args)...);
+			return true;
+		}
+		else
+		{
+			return try_emplace(T(std::forward<Args>(args)...));
+		}
+	}
+
+	/* v is only moved from when the push succeeds */
+	template<class U>
+	bool try_push(U&& v) { return try_emplace(std::forward<U>(v)); }
+
+	template<class U>
+	void push(U&& v)
+	{
+		if constexpr (std::is_nothrow_constructible_v<T, U&&>)
+		{
+			for (unsigned spins = 0; !try_emplace(std::forward<U>(v));) detail::backoff(spins);
+		}
+		else
+		{
+			push(T(std::forward<U>(v)));	// build it once, not on every attempt
+		}
+	}
+
+	/* moves the first n messages of first in, all or none, n <= Capacity; one CAS for the batch */
+	template<class It>
+	bool try_push_n(It first, std::size_t n)
+	{
+		// the slots are claimed before the messages are built: one that throws would stall the consumer
+		static_assert(std::is_nothrow_constructible_v<T, decltype(std::move(*first))>,
+			"try_push_n: a message that throws half way would leave the batch unpublished, convert to T first");
+		std::size_t position;
+		if (n == 0) return true;
+		if (!claim(n, position)) return false;
+		for (std::size_t i = 0; i < n; ++i, ++first) publish(position + i, std::move(*first));
+		return true;
+	}
+
+	template<class It>
+	void push_n(It first, std::size_t n)
+	{
+		for (unsigned spins = 0; !try_push_n(first, n);) detail::backoff(spins);
+	}
+
+	// the consumer, one thread
+
+	/* visit up to max messages in order; stops at the first slot not published yet */
+	template<class Visitor>
+	std::size_t consume(Visitor&& visitor, std::size_t max = ~std::size_t{ 0 })
+	{
+		return drain([&visitor](T& message) { detail::dispatch(message, visitor); }, max);
+	}
+
+	template<class Visitor>
+	bool consume_one(Visitor&& visitor) { return consume(visitor, 1) == 1; }
+
+	std::optional<T> try_pop()
+	{
+		std::optional<T> out;
+		drain([&out](T& message) { out.emplace(std::move(message)); }, 1);
+		return out;
+	}
+
+	/* consumer side: nothing published at the head */
+	bool empty() const
+	{
+		return slots_[head_ & (Capacity - 1)].sequence.load(std::memory_order_acquire) != head_ + 1;
+	}
+
+private:
+	/*
+	 * Reserve n consecutive positions. The consumer frees slots in order,
+	 * so when the last of the n is free, all of them are.
+	 */
+	bool claim(std::size_t n, std::size_t& position)
+	{
+		if (n > Capacity) return false;
+		position = tail_.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const std::size_t last = position + n - 1;
+			const std::size_t sequence = slots_[last & (Capacity - 1)].sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::ptrdiff_t>(sequence - last);
+			if (diff == 0)
+			{
+				if (tail_.compare_exchange_weak(position, position + n, std::memory_order_relaxed)) return true;
+			}
+			else if (diff < 0)
+			{
+				return false;	// the consumer has not freed it yet: full
+			}
+			else
+			{
+				position = tail_.load(std::memory_order_relaxed);	// another producer took it
+			}
+		}
+	}
+
+	template<class F>
+	std::size_t drain(F&& f, std::size_t max)
+	{
+		std::size_t done = 0;
+		for (; done < max; ++done)
+		{
+			detail::mpsc_slot<T>& s = slots_[head_ & (Capacity - 1)];
+			if (s.sequence.load(std::memory_order_acquire) != head_ + 1) break;
+
+			detail::release_guard release{ [&] {
+				s.value.destroy();
+				s.sequence.store(head_ + Capacity, std::memory_order_release);
+				++head_;
+			} };
+			f(s.value.get());
+		}
+		return done;
+	}
+
+	template<class... Args>
+	void publish(std::size_t position, Args&&... args)
+	{
+		detail::mpsc_slot<T>& s = slots_[position & (Capacity - 1)];
+		s.value.construct(std::forward<Args>(args)...);
+		s.sequence.store(position + 1, std::memory_order_release);
+	}
+
+	std::unique_ptr<detail::mpsc_slot<T>[]> slots_;
+
+	alignas(cache_line) std::atomic<std::size_t> tail_{ 0 };	// shared by the producers
+	alignas(cache_line) std::size_t head_ = 0;					// the consumer's alone
+};
+
+} // message_queue
+} // cxx17
+} // pluto
@@ -0,0 +1,214 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 02:44:10
+ * @brief
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "message_queue.h"
+#include "common/latency_histogram.h"
+
+using namespace std;
+using namespace pluto::cxx17::message_queue;
+
+namespace
+{
+
+using clock_type = chrono::steady_clock;
+using event = variant<int, float, string, clock_type::time_point>;
+
+constexpr int messages_per_iteration = 1 << 17;
+constexpr size_t queue_capacity = 1024;
+
+/* the reference: std::queue under a mutex, popped one message at a time */
+class locked_queue
+{
+public:
+	void push(event e)
+	{
+		lock_guard<mutex> lock(mutex_);
+		queue_.push(std::move(e));
+	}
+
+	template<class Visitor>
+	size_t consume(Visitor&& visitor)
+	{
+		size_t n = 0;
+		for (;;)
+		{
+			event e;
+			{
+				lock_guard<mutex> lock(mutex_);
+				if (queue_.empty()) return n;
+				e = std::move(queue_.front());
+				queue_.pop();
+			}
+			std::visit(visitor, e);
+			++n;
+		}
+	}
+
+private:
+	mutex mutex_;
+	queue<event> queue_;
+};
+
+/* a mix of alternatives, short strings stay in the SSO buffer */
+event make_event(int i)
+{
+	switch (i % 3)
+	{
+	case 0: return i;
+	case 1: return static_cast<float>(i);
+	default: return string("evt");
+	}
+}
+
+struct sum_visitor
+{
+	long long& sum;
+
+	void operator()(int i) const { sum += i; }
+	void operator()(float f) const { sum += static_cast<long long>(f); }
+	void operator()(const string& s) const { sum += static_cast<long long>(s.size()); }
+	void operator()(clock_type::time_point) const { ++sum; }
+};
+
+/* state.range(0) producers split the messages, the benchmark thread consumes */
+template<class Queue>
+void run_producers(Queue& q, int producers, int messages, bool stamped, pluto::latency::histogram* latency)
+{
+	vector<thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&q, p, producers, messages, stamped] {
+			for (int i = p; i < messages; i += producers)
+			{
+				if (stamped) q.push(clock_type::now());
+				else q.push(make_event(i));
+			}
+		});
+	}
+
+	long long sum = 0;
+	int received = 0;
+	auto visitor = [&](auto& m) {
+		if constexpr (is_same_v<decay_t<decltype(m)>, clock_type::time_point>)
+		{
+			if (latency != nullptr)
+			{
+				latency->record(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(clock_type::now() - m).count()));
+			}
+		}
+		sum_visitor{ sum }(m);
+	};
+	while (received < messages)
+	{
+		const size_t n = q.consume(visitor);
+		if (n == 0) this_thread::yield();
+		received += static_cast<int>(n);
+	}
+	for (auto& t : threads) t.join();
+	benchmark::DoNotOptimize(sum);
+}
+
+template<class Queue>
+void throughput(benchmark::State& state, Queue& q)
+{
+	const int producers = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		run_producers(q, producers, messages_per_iteration, false, nullptr);
+	}
+	state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+}
+
+/* push-to-visit latency while the producers push as fast as they can */
+template<class Queue>
+void latency(benchmark::State& state, Queue& q)
+{
+	const int producers = static_cast<int>(state.range(0));
+	pluto::latency::histogram h;
+	for (auto _ : state)
+	{
+		run_producers(q, producers, messages_per_iteration, true, &h);
+	}
+	const auto s = h.take_snapshot();
+	state.counters["p50_ns"] = static_cast<double>(s.p50());
+	state.counters["p99_ns"] = static_cast<double>(s.p99());
+	state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+}
+
+} // namespace
+
+static void BM_MpscQueueThroughput(benchmark::State& state)
+{
+	static mpsc_queue<event, queue_capacity> q;
+	throughput(state, q);
+}
+
+static void BM_MutexQueueThroughput(benchmark::State& state)
+{
+	static locked_queue q;
+	throughput(state, q);
+}
+
+static void BM_MpscQueueLatency(benchmark::State& state)
+{
+	static mpsc_queue<event, queue_capacity> q;
+	latency(state, q);
+}
+
+static void BM_MutexQueueLatency(benchmark::State& state)
+{
+	static locked_queue q;
+	latency(state, q);
+}
+
+/* one producer, batches of state.range(0) messages each way */
+static void BM_SpscQueueBatch(benchmark::State& state)
+{
+	static spsc_queue<event, queue_capacity> q;
+	const size_t batch = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		thread producer([batch] {
+			vector<event> pending;
+			for (int i = 0; i < messages_per_iteration; ++i)
+			{
+				pending.push_back(make_event(i));
+				if (pending.size() == batch || i == messages_per_iteration - 1)
+				{
+					while (!q.try_push_n(pending.begin(), pending.size())) this_thread::yield();
+					pending.clear();
+				}
+			}
+		});
+		long long sum = 0;
+		for (int received = 0; received < messages_per_iteration;)
+		{
+			const size_t n = q.consume(sum_visitor{ sum }, batch);
+			if (n == 0) this_thread::yield();
+			received += static_cast<int>(n);
+		}
+		producer.join();
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+}
+
+BENCHMARK(BM_MpscQueueThroughput)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MutexQueueThroughput)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MpscQueueLatency)->RangeMultiplier(4)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MutexQueueLatency)->RangeMultiplier(4)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SpscQueueBatch)->Arg(1)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,205 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 02:20:36
+ * @brief
+ */
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "message_queue.h"
+#include "variant.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::message_queue;
+using pluto::cxx17::variant::AddVisitor;
+
+namespace
+{
+
+using event = std::variant<int, float, std::string>;
+
+/* counts live instances, to see that every message is destroyed exactly once */
+struct tracked
+{
+	static inline std::atomic<int> live{ 0 };
+
+	int value;
+
+	explicit tracked(int v) : value(v) { ++live; }
+	tracked(tracked&& other) noexcept : value(other.value) { ++live; }
+	~tracked() { --live; }
+};
+
+/* collects what it is shown, after AddVisitor had its go */
+struct collect
+{
+	vector<string>& out;
+
+	void operator()(int& i) const { AddVisitor{}(i); out.push_back(to_string(i)); }
+	void operator()(float& f) const { AddVisitor{}(f); out.push_back(to_string(f)); }
+	void operator()(string& s) const { AddVisitor{}(s); out.push_back(std::move(s)); }
+};
+
+template<class Queue>
+void single_thread_checks()
+{
+	Queue q;
+	vector<string> seen;
+
+	EXPECT_TRUE(q.empty());
+	EXPECT_EQ(q.consume(collect{ seen }), 0u);
+
+	EXPECT_TRUE(q.try_push(1));
+	EXPECT_TRUE(q.try_emplace(2.5f));
+	EXPECT_TRUE(q.try_emplace(std::in_place_type<string>, "hello"));
+	EXPECT_FALSE(q.empty());
+
+	// the visitor works on the message in the slot, in order
+	EXPECT_EQ(q.consume(collect{ seen }), 3u);
+	EXPECT_EQ(seen, (vector<string>{ "2", to_string(3.5f), "hello !!!" }));
+	EXPECT_TRUE(q.empty());
+
+	// full, then drained in bounded batches across the wrap
+	for (size_t i = 0; i < Queue::capacity(); ++i) EXPECT_TRUE(q.try_push(static_cast<int>(i)));
+	EXPECT_FALSE(q.try_push(-1));
+	seen.clear();
+	EXPECT_EQ(q.consume(collect{ seen }, 5), 5u);
+	vector<event> batch = { 100, 101, 102, 103, 104 };
+	EXPECT_TRUE(q.try_push_n(batch.begin(), batch.size()));
+	EXPECT_FALSE(q.try_push_n(batch.begin(), 1));
+	EXPECT_EQ(q.consume(collect{ seen }), Queue::capacity());
+	ASSERT_EQ(seen.size(), Queue::capacity() + 5);
+	EXPECT_EQ(seen.front(), "1");
+	EXPECT_EQ(seen.back(), "105");
+
+	optional<event> popped = q.try_pop();
+	EXPECT_FALSE(popped.has_value());
+	q.push(string("x"));
+	popped = q.try_pop();
+	ASSERT_TRUE(popped.has_value());
+	EXPECT_EQ(get<string>(*popped), "x");
+}
+
+} // namespace
+
+TEST(PLUTO, CXX17_MESSAGE_QUEUE) {
+
+	single_thread_checks<spsc_queue<event, 16>>();
+	single_thread_checks<mpsc_queue<event, 16>>();
+
+	EXPECT_EQ(sizeof(pluto::cxx17::message_queue::detail::mpsc_slot<event>) % cache_line, 0u);
+
+	{
+		// whatever is left in the queue is destroyed with it
+		{
+			mpsc_queue<tracked, 8> m;
+			spsc_queue<tracked, 8> s;
+			for (int i = 0; i < 5; ++i)
+			{
+				m.push(tracked(i));
+				s.push(tracked(i));
+			}
+			m.consume([](tracked&) {}, 2);
+			s.consume([](tracked&) {}, 2);
+			EXPECT_EQ(tracked::live.load(), 6);
+		}
+		EXPECT_EQ(tracked::live.load(), 0);
+	}
+
+	{
+		// a throwing visitor still frees its slot
+		mpsc_queue<int, 4> q;
+		q.push(1);
+		q.push(2);
+		EXPECT_THROW(q.consume([](int) { throw runtime_error("visitor"); }), runtime_error);
+		EXPECT_EQ(q.try_pop(), optional<int>(2));
+	}
+
+	{
+		// producers race, every producer's messages arrive in its own order, none lost
+		constexpr int producers = 8, per_producer = 50000;
+		mpsc_queue<event, 256> q;
+		vector<thread> threads;
+		for (int p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&q, p] {
+				// runs of four values, alternately as one batch and as four single pushes
+				for (int i = 0; i < per_producer; i += 4)
+				{
+					const int base = p * per_producer + i;
+					if (i / 4 % 2 == 0)
+					{
+						event batch[] = { base, to_string(base + 1), base + 2, base + 3 };
+						q.push_n(batch, 4);
+					}
+					else
+					{
+						q.push(base);
+						q.push(to_string(base + 1));
+						q.push(base + 2);
+						q.push(base + 3);
+					}
+				}
+			});
+		}
+
+		vector<int> next(producers, 0);
+		int bad = 0, received = 0;
+		auto check = [&](int value) {
+			const int p = value / per_producer;
+			bad += value % per_producer != next[p]++;
+			++received;
+		};
+		while (received < producers * per_producer)
+		{
+			const size_t n = q.consume([&](auto& m) {
+				if constexpr (is_same_v<decay_t<decltype(m)>, string>) check(stoi(m));
+				else if constexpr (is_same_v<decay_t<decltype(m)>, int>) check(m);
+				else ++bad;
+			});
+			if (n == 0) this_thread::yield();
+		}
+		for (auto& t : threads) t.join();
+		EXPECT_EQ(bad, 0);
+		EXPECT_EQ(received, producers * per_producer);
+		EXPECT_TRUE(q.empty());
+		TEST_COUT << "received " << received << " messages from " << producers << " producers" << endl;
+	}
+
+	{
+		// one producer, one consumer, strict order
+		constexpr int count = 200000;
+		spsc_queue<event, 64> q;
+		thread producer([&q] {
+			vector<event> batch;
+			for (int i = 0; i < count; ++i)
+			{
+				batch.emplace_back(i);
+				if (batch.size() == 8)
+				{
+					while (!q.try_push_n(batch.begin(), batch.size())) this_thread::yield();
+					batch.clear();
+				}
+			}
+		});
+		int expected = 0, bad = 0;
+		while (expected < count)
+		{
+			const size_t n = q.consume([&](auto& m) {
+				if constexpr (is_same_v<decay_t<decltype(m)>, int>) bad += m != expected;
+				++expected;
+			});
+			if (n == 0) this_thread::yield();
+		}
+		producer.join();
+		EXPECT_EQ(bad, 0);
+	}
+}
@@ -0,0 +1,93 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 19:46:35
+ * @brief
+ */
+
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "optional.h"
+
+using namespace std;
+
+namespace
+{
+
+/* n optionals, range(1) percent of them engaged, in random order */
+template<class T>
+vector<optional<T>> random_optionals(size_t n, int engaged_percent)
+{
+	std::mt19937 gen(1);
+	vector<optional<T>> v(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (static_cast<int>(gen() % 100) >= engaged_percent) continue;
+		if constexpr (is_same_v<T, string>) v[i] = string(24, 'x');
+		else v[i] = static_cast<T>(i);
+	}
+	return v;
+}
+
+} // namespace
+
+static void BM_ValueOr_Int(benchmark::State& state)
+{
+	auto v = random_optionals<int>(4096, static_cast<int>(state.range(0)));
+	for (auto _ : state)
+	{
+		long long sum = 0;
+		for (const auto& o : v) sum += o.value_or(-1);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+/* the same sum written with the explicit has_value() test */
+static void BM_HasValue_Int(benchmark::State& state)
+{
+	auto v = random_optionals<int>(4096, static_cast<int>(state.range(0)));
+	for (auto _ : state)
+	{
+		long long sum = 0;
+		for (const auto& o : v) sum += o.has_value() ? *o : -1;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+/* value_or returns by value, so every call copies either the string or the default */
+static void BM_ValueOr_String(benchmark::State& state)
+{
+	auto v = random_optionals<string>(4096, static_cast<int>(state.range(0)));
+	const string fallback = "none";
+	for (auto _ : state)
+	{
+		size_t len = 0;
+		for (const auto& o : v) len += o.value_or(fallback).size();
+		benchmark::DoNotOptimize(len);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+static void BM_HasValue_String(benchmark::State& state)
+{
+	auto v = random_optionals<string>(4096, static_cast<int>(state.range(0)));
+	const string fallback = "none";
+	for (auto _ : state)
+	{
+		size_t len = 0;
+		for (const auto& o : v) len += (o ? *o : fallback).size();
+		benchmark::DoNotOptimize(len);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+BENCHMARK(BM_ValueOr_Int)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_HasValue_Int)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_ValueOr_String)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_HasValue_String)->Arg(0)->Arg(50)->Arg(100);
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include "optional.h"
+#include "common/alloc_counter.h"
 #include "common/define.h"
 
 using namespace std;
@@ -64,4 +65,18 @@ TEST(PLUTO, CXX17_OPTIONAL) {
 		}
 	}
 
+	TEST_COUT_DELIMITER;
+
+	{
+		// the value lives inside the optional, however large
+		EXPECT_NO_ALLOCATIONS({
+			std::optional<std::array<int, 256>> o;
+			o.emplace();
+			o.reset();
+			o = std::array<int, 256>{};
+			auto copy = o;
+			EXPECT_EQ(o, copy);
+		});
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 09:12:40
+ * @brief
+ */
+
+#include "parallel_fold.h"
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace parallel
+{
+
+namespace
+{
+
+/* index of the pool queue owned by the current thread, if any */
+thread_local work_stealing_pool* tls_pool = nullptr;
+thread_local std::size_t tls_index = 0;
+
+} // namespace
+
+work_stealing_pool::work_stealing_pool(std::size_t threads)
+{
+	threads = std::max<std::size_t>(threads, 1);
+
+	for (std::size_t i = 0; i < threads; ++i)
+	{
+		queues_.push_back(std::make_unique<task_queue>());
+	}
+
+	for (std::size_t i = 0; i < threads; ++i)
+	{
+		threads_.emplace_back([this, i] { worker_loop(i); });
+	}
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		stop_ = true;
+	}
+	sleep_cv_.notify_all();
+
+	for (auto& t : threads_) t.join();
+}
+
+void work_stealing_pool::submit(std::function<void()> task)
+{
+	// workers push onto their own deque, other threads spread round-robin
+	std::size_t index = tls_pool == this
+		? tls_index
+		: next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+	// count the task before it becomes visible, so a thief popping it
+	// right away can never decrement pending_ below zero
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		++pending_;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+		queues_[index]->tasks.push_back(std::move(task));
+	}
+	sleep_cv_.notify_one();
+}
+
+bool work_stealing_pool::pop_local(std::size_t index, std::function<void()>& task)
+{
+	auto& q = *queues_[index];
+	std::lock_guard<std::mutex> lock(q.mutex);
+	if (q.tasks.empty()) return false;
+	task = std::move(q.tasks.back());
+	q.tasks.pop_back();
+	return true;
+}
+
+bool work_stealing_pool::steal(std::size_t thief, std::function<void()>& task)
+{
+	for (std::size_t i = 1; i <= queues_.size(); ++i)
+	{
+		auto& q = *queues_[(thief + i) % queues_.size()];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (q.tasks.empty()) continue;
+		task = std::move(q.tasks.front());
+		q.tasks.pop_front();
+		return true;
+	}
+	return false;
+}
+
+bool work_stealing_pool::try_run_one()
+{
+	std::function<void()> task;
+	bool found = tls_pool == this
+		? pop_local(tls_index, task) || steal(tls_index, task)
+		: steal(0, task);
+	if (!found) return false;
+
+	--pending_;
+	task();
+	return true;
+}
+
+void work_stealing_pool::worker_loop(std::size_t index)
+{
+	tls_pool = this;
+	tls_index = index;
+
+	for (;;)
+	{
+		if (try_run_one()) continue;
+
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
+		sleep_cv_.wait(lock, [this] { return stop_ || pending_ > 0; });
+		if (stop_ && pending_ == 0) return;
+	}
+}
+
+work_stealing_pool& work_stealing_pool::instance()
+{
+	static work_stealing_pool pool;
+	return pool;
+}
+
+} // parallel
+} // cxx17
+} // pluto
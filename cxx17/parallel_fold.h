@@ -0,0 +1,238 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 09:12:40
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace parallel
+{
+
+/*
+ * A binary left fold (init op ... op pack) is a sequential reduction:
+ * ((((init op E1) op E2) op ...) op EN). When op is associative the
+ * parentheses may be moved freely, so the range can be cut into
+ * chunks, every chunk reduced on its own, and the partial results
+ * combined afterwards:
+ *
+ *		init op ((E1 op E2) op (E3 op E4))
+ *
+ * Associative is NOT commutative. String concatenation or matrix
+ * product are associative but the operands must stay in order. That
+ * is why we can not simply forward to std::reduce (which may reorder
+ * operands arbitrarily): chunks here are contiguous, and partials are
+ * combined pairwise in a tree that keeps left operands on the left.
+ *
+ * Folds like left_sub, (... - args), are not associative at all:
+ * (a - b) - c != a - (b - c). They still parallelize if a separate
+ * associative combine and an identity are given, such that
+ *
+ *		combine(acc, fold(identity, op, chunk)) == fold(acc, op, chunk)
+ *
+ * For subtraction: op = minus, combine = plus, identity = 0, because
+ * a - b - c == a + ((0 - b) - c).
+ */
+
+/*
+ * Work-stealing pool : every worker owns a deque. A worker pops tasks
+ * from the back of its own deque (LIFO, cache friendly) and, when that
+ * runs dry, steals from the front of the other deques (FIFO, oldest and
+ * usually biggest piece of work). A thread waiting for its tasks does
+ * not block, it helps by running queued tasks itself.
+ */
+class work_stealing_pool
+{
+public:
+	explicit work_stealing_pool(std::size_t threads = std::thread::hardware_concurrency());
+	~work_stealing_pool();
+
+	work_stealing_pool(const work_stealing_pool&) = delete;
+	work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+	/* number of worker threads */
+	std::size_t size() const { return threads_.size(); }
+
+	void submit(std::function<void()> task);
+
+	/* run one queued task on the calling thread, false if none found */
+	bool try_run_one();
+
+	/* process wide pool, sized to the number of hardware threads */
+	static work_stealing_pool& instance();
+
+private:
+	struct task_queue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	void worker_loop(std::size_t index);
+	bool pop_local(std::size_t index, std::function<void()>& task);
+	bool steal(std::size_t thief, std::function<void()>& task);
+
+	std::vector<std::unique_ptr<task_queue>> queues_;
+	std::vector<std::thread> threads_;
+	std::atomic<std::size_t> next_queue_{ 0 };
+	std::atomic<std::size_t> pending_{ 0 };
+	std::atomic<bool> stop_{ false };
+	std::mutex sleep_mutex_;
+	std::condition_variable sleep_cv_;
+};
+
+namespace detail
+{
+
+/* below this many elements per chunk, the task overhead dominates */
+constexpr std::size_t min_grain = 1 << 14;
+
+/*
+ * Split [first, last) into contiguous chunks, fold each chunk on the
+ * pool, then combine the partials pairwise, level by level:
+ *
+ *		p0 p1 p2 p3 p4  ->  (p0 p1) (p2 p3) p4  ->  ((p0 p1) (p2 p3)) p4
+ *
+ * identity : nullptr makes chunk folds start with their first element,
+ *			  which requires op to be associative (3 argument form).
+ *			  Otherwise they start with *identity (5 argument form).
+ */
+template<class It, class T, class Op, class Combine>
+T fold_chunks(work_stealing_pool& pool, It first, It last, T init,
+	Op& op, Combine& combine, const T* identity)
+{
+	static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+		typename std::iterator_traits<It>::iterator_category>,
+		"parallel_fold requires a random access range");
+
+	const std::size_t n = static_cast<std::size_t>(last - first);
+	const std::size_t max_chunks = (pool.size() + 1) * 4;
+	const std::size_t chunks = std::min(max_chunks, n / min_grain);
+
+	if (chunks < 2)
+	{
+		for (; first != last; ++first) init = op(std::move(init), *first);
+		return init;
+	}
+
+	std::vector<std::optional<T>> partials(chunks);
+	std::vector<std::exception_ptr> errors(chunks);
+	std::latch done(static_cast<std::ptrdiff_t>(chunks));
+
+	for (std::size_t c = 0; c < chunks; ++c)
+	{
+		pool.submit([&, c] {
+			try
+			{
+				It b = first + static_cast<std::ptrdiff_t>(n * c / chunks);
+				It e = first + static_cast<std::ptrdiff_t>(n * (c + 1) / chunks);
+				T acc = identity ? *identity : T(*b++);
+				for (; b != e; ++b) acc = op(std::move(acc), *b);
+				partials[c].emplace(std::move(acc));
+			}
+			catch (...)
+			{
+				errors[c] = std::current_exception();
+			}
+			done.count_down();
+		});
+	}
+
+	while (!done.try_wait())
+	{
+		if (!pool.try_run_one()) std::this_thread::yield();
+	}
+
+	for (auto& e : errors)
+	{
+		if (e) std::rethrow_exception(e);
+	}
+
+	for (std::size_t step = 1; step < chunks; step *= 2)
+	{
+		for (std::size_t i = 0; i + step < chunks; i += step * 2)
+		{
+			partials[i].emplace(combine(std::move(*partials[i]), std::move(*partials[i + step])));
+		}
+	}
+
+	return combine(std::move(init), std::move(*partials[0]));
+}
+
+template<class R>
+constexpr bool is_pool_v = std::is_same_v<std::decay_t<R>, work_stealing_pool>;
+
+} // detail
+
+/*
+ * (init op ... op range) on all cores, op must be associative.
+ *
+ *		std::vector<std::string> words{ "a", "b", "c" };
+ *		parallel_fold(words, std::string{}, std::plus<>{}); // "abc"
+ */
+template<class R, class T, class Op>
+	requires (!detail::is_pool_v<R>)
+T parallel_fold(work_stealing_pool& pool, const R& range, T init, Op op)
+{
+	return detail::fold_chunks(pool, std::begin(range), std::end(range),
+		std::move(init), op, op, static_cast<const T*>(nullptr));
+}
+
+template<class R, class T, class Op>
+	requires (!detail::is_pool_v<R>)
+T parallel_fold(const R& range, T init, Op op)
+{
+	return parallel_fold(work_stealing_pool::instance(), range, std::move(init), op);
+}
+
+/*
+ * (init op ... op range) on all cores for a non-associative op, see
+ * the left_sub discussion above.
+ *
+ *		parallel_fold(v, 2, std::minus<>{}, std::plus<>{}); // left_sub(2, v...)
+ */
+template<class R, class T, class Op, class Combine>
+	requires (!detail::is_pool_v<R>)
+T parallel_fold(work_stealing_pool& pool, const R& range, T init, Op op,
+	Combine combine, T identity = T{})
+{
+	return detail::fold_chunks(pool, std::begin(range), std::end(range),
+		std::move(init), op, combine, &identity);
+}
+
+template<class R, class T, class Op, class Combine>
+	requires (!detail::is_pool_v<R>)
+T parallel_fold(const R& range, T init, Op op, Combine combine, T identity = T{})
+{
+	return parallel_fold(work_stealing_pool::instance(), range, std::move(init),
+		op, combine, std::move(identity));
+}
+
+} // parallel
+} // cxx17
+
+using cxx17::parallel::parallel_fold;
+
+} // pluto
@@ -0,0 +1,91 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 09:12:40
+ * @brief
+ */
+
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+
+#include "parallel_fold.h"
+
+using namespace std;
+using namespace pluto::cxx17::parallel;
+
+namespace
+{
+
+const vector<int32_t>& input(size_t n)
+{
+	static vector<int32_t> v;
+	if (v.size() != n)
+	{
+		v.assign(n, 0);
+		std::iota(v.begin(), v.end(), 0);
+	}
+	return v;
+}
+
+} // namespace
+
+static void BM_Fold_Sequential(benchmark::State& state)
+{
+	const auto& v = input(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), int64_t{ 0 }));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int32_t));
+}
+
+/* range(1) is the worker count, throughput should grow with it */
+static void BM_ParallelFold_Sum(benchmark::State& state)
+{
+	const auto& v = input(static_cast<size_t>(state.range(0)));
+	work_stealing_pool pool(static_cast<size_t>(state.range(1)));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(parallel_fold(pool, v, int64_t{ 0 }, std::plus<>{}));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int32_t));
+}
+
+static void BM_ParallelFold_LeftSub(benchmark::State& state)
+{
+	const auto& v = input(static_cast<size_t>(state.range(0)));
+	work_stealing_pool pool(static_cast<size_t>(state.range(1)));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(parallel_fold(pool, v, int64_t{ 0 }, std::minus<>{}, std::plus<>{}));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ScalingArgs(benchmark::internal::Benchmark* b)
+{
+	const int64_t hw = std::max(1u, std::thread::hardware_concurrency());
+
+	// the 1G element (4 GB) input only runs with -DPLUTO_BENCH_HUGE
+#ifdef PLUTO_BENCH_HUGE
+	const int64_t sizes[] = { 1 << 24, 1 << 30 };
+#else
+	const int64_t sizes[] = { 1 << 24 };
+#endif
+
+	for (int64_t n : sizes)
+	{
+		for (int64_t t = 1; t < hw; t *= 2) b->Args({ n, t });
+		b->Args({ n, hw });
+	}
+	b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_Fold_Sequential)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelFold_Sum)->Apply(ScalingArgs);
+BENCHMARK(BM_ParallelFold_LeftSub)->Apply(ScalingArgs);
@@ -0,0 +1,75 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 09:12:40
+ * @brief
+ */
+
+#include <vector>
+#include <string>
+#include <numeric>
+#include <functional>
+#include <stdexcept>
+#include <iostream>
+#include <gtest/gtest.h>
+
+#include "parallel_fold.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::parallel;
+
+TEST(PLUTO, CXX17_PARALLEL_FOLD) {
+
+	work_stealing_pool pool(4);
+
+	{
+		vector<long long> v(1 << 20);
+		std::iota(v.begin(), v.end(), 1);
+		long long expected = std::accumulate(v.begin(), v.end(), 10LL);
+		EXPECT_EQ(expected, parallel_fold(pool, v, 10LL, std::plus<>{}));
+		EXPECT_EQ(expected, pluto::parallel_fold(v, 10LL, std::plus<>{}));
+		TEST_COUT << parallel_fold(pool, v, 10LL, std::plus<>{}) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// associative but not commutative, operands have to stay in order
+		vector<string> v(1 << 16);
+		for (size_t i = 0; i < v.size(); ++i) v[i] = string(1, char('a' + i % 26));
+		string expected = std::accumulate(v.begin(), v.end(), string(">"));
+		EXPECT_EQ(expected, parallel_fold(pool, v, string(">"), std::plus<>{}));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// left_sub : ((2 - v0) - v1) - ... needs combine = plus
+		vector<int> v(1 << 20, 3);
+		int expected = std::accumulate(v.begin(), v.end(), 2, std::minus<>{});
+		EXPECT_EQ(expected, parallel_fold(pool, v, 2, std::minus<>{}, std::plus<>{}));
+		TEST_COUT << parallel_fold(pool, v, 2, std::minus<>{}, std::plus<>{}) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// small ranges are folded on the calling thread
+		vector<int> v{ 3, 4 };
+		EXPECT_EQ(-5, parallel_fold(pool, v, 2, std::minus<>{}, std::plus<>{}));
+		EXPECT_EQ(24, parallel_fold(pool, v, 2, std::multiplies<>{}));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		vector<int> v(1 << 20, 1);
+		v[v.size() / 2 + 1] = -1;
+		auto checked = [](int acc, int x) {
+			if (x < 0) throw std::invalid_argument("x");
+			return acc + x;
+		};
+		EXPECT_THROW(parallel_fold(pool, v, 0, checked), std::invalid_argument);
+	}
+}
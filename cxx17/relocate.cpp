@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 17:26:40
+ * @brief
+ */
+
+#include "relocate.h"
@@ -0,0 +1,154 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 17:26:40
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace relocation
+{
+
+/*
+ * When a container grows it moves every element into the new buffer and
+ * destroys the old one, element by element:
+ *
+ *		for (i = 0; i < n; ++i) {
+ *			new (fresh + i) T(std::move(old[i]));
+ *			old[i].~T();
+ *		}
+ *
+ * For most types that pair of calls does nothing but copy the bytes, the
+ * moved-from object is never looked at again. Such a type is trivially
+ * relocatable and the whole loop is one memcpy. The helpers below pick
+ * the fast path with if constexpr, the same way f(T t) in
+ * cxx20/constexpr.h picks a branch per type:
+ *
+ *		relocate(first, last, dest)			move + destroy, or memmove
+ *		uninitialized_move_n(first, n, dest)	move construct, or memcpy
+ *		bulk_copy(first, last, dest)		copy assign, or memmove
+ *
+ * is_trivially_relocatable<T> holds for trivially copyable types and for
+ * types whose move constructor and destructor are both trivial, which
+ * takes in std::tuple and std::pair of scalars (their assignment is user
+ * provided, so they are not trivially copyable and std::vector moves
+ * them one at a time). It carries over to tuple, pair and array members.
+ *
+ * Other types opt in with PLUTO_TRIVIALLY_RELOCATABLE(type). That is a
+ * promise that no member points into the object itself: unique_ptr,
+ * shared_ptr or a libc++ std::string are fine, but libstdc++'s
+ * std::string keeps a pointer to its own inline buffer and must NOT be
+ * relocated with memcpy.
+ */
+
+template<class T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T> ||
+	(std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>)> {};
+
+template<class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+template<class... Ts>
+struct is_trivially_relocatable<std::tuple<Ts...>> : std::bool_constant<(is_trivially_relocatable_v<Ts> && ...)> {};
+
+template<class A, class B>
+struct is_trivially_relocatable<std::pair<A, B>>
+	: std::bool_constant<is_trivially_relocatable_v<A> && is_trivially_relocatable_v<B>> {};
+
+template<class T, std::size_t N>
+struct is_trivially_relocatable<std::array<T, N>> : std::bool_constant<is_trivially_relocatable_v<T>> {};
+
+/*
+ * Move [first, last) into the uninitialized storage at dest and end the
+ * lifetime of the sources. Returns the end of the new range. The ranges
+ * may overlap only when T is trivially relocatable.
+ */
+template<class T>
+T* relocate(T* first, T* last, T* dest)
+{
+	const std::size_t n = static_cast<std::size_t>(last - first);
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		if (n != 0) std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+		return dest + n;
+	}
+	else
+	{
+		T* end = std::uninitialized_move(first, last, dest);
+		std::destroy(first, last);
+		return end;
+	}
+}
+
+/* std::uninitialized_move_n, one memcpy for trivially copyable T */
+template<class T>
+std::pair<T*, T*> uninitialized_move_n(T* first, std::size_t n, T* dest)
+{
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		if (n != 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+		return { first + n, dest + n };
+	}
+	else
+	{
+		return std::uninitialized_move_n(first, n, dest);
+	}
+}
+
+/*
+ * std::copy into constructed elements. Contiguous ranges of the same
+ * trivially copyable type become one memmove, anything else falls back
+ * to std::copy.
+ */
+template<class InIt, class OutIt>
+OutIt bulk_copy(InIt first, InIt last, OutIt dest)
+{
+	using in_t = typename std::iterator_traits<InIt>::value_type;
+	using out_t = typename std::iterator_traits<OutIt>::value_type;
+
+	if constexpr (std::contiguous_iterator<InIt> && std::contiguous_iterator<OutIt> &&
+		std::is_same_v<in_t, out_t> && std::is_trivially_copyable_v<in_t>)
+	{
+		const auto n = last - first;
+		if (n != 0)
+		{
+			std::memmove(static_cast<void*>(std::to_address(dest)),
+				static_cast<const void*>(std::to_address(first)), static_cast<std::size_t>(n) * sizeof(in_t));
+		}
+		return dest + n;
+	}
+	else
+	{
+		return std::copy(first, last, dest);
+	}
+}
+
+} // relocation
+} // cxx17
+
+using cxx17::relocation::is_trivially_relocatable;
+using cxx17::relocation::is_trivially_relocatable_v;
+using cxx17::relocation::relocate;
+using cxx17::relocation::uninitialized_move_n;
+using cxx17::relocation::bulk_copy;
+
+} // pluto
+
+/* opt a type in to memcpy relocation, use at global scope */
+#define PLUTO_TRIVIALLY_RELOCATABLE(...)													\
+template<> struct pluto::cxx17::relocation::is_trivially_relocatable<__VA_ARGS__> : std::true_type {}
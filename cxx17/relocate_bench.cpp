@@ -0,0 +1,110 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 17:26:40
+ * @brief
+ */
+
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "relocate.h"
+#include "small_vector.h"
+
+using namespace std;
+
+namespace
+{
+
+using row = tuple<int, double, int>;
+
+/* a record that owns a buffer, opted in below */
+struct record
+{
+	int id = 0;
+	unique_ptr<int[]> payload;
+
+	record() = default;
+	explicit record(int i) : id(i), payload(new int[2]{ i, i }) {}
+};
+
+} // namespace
+
+PLUTO_TRIVIALLY_RELOCATABLE(record);
+
+/*
+ * Grow a buffer by doubling, the way a vector does, and relocate the
+ * elements either one by one (move + destroy) or with pluto::relocate.
+ */
+template<class T, bool Fast>
+static void BM_Relocate(benchmark::State& state)
+{
+	const size_t n = static_cast<size_t>(state.range(0));
+	allocator<T> alloc;
+	for (auto _ : state)
+	{
+		size_t cap = 1, size = 0;
+		T* data = alloc.allocate(cap);
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (size == cap)
+			{
+				T* fresh = alloc.allocate(cap * 2);
+				if constexpr (Fast)
+				{
+					pluto::relocate(data, data + size, fresh);
+				}
+				else
+				{
+					uninitialized_move(data, data + size, fresh);
+					destroy(data, data + size);
+				}
+				alloc.deallocate(data, cap);
+				data = fresh;
+				cap *= 2;
+			}
+			::new (static_cast<void*>(data + size++)) T(static_cast<int>(i), 0, 0);
+		}
+		benchmark::DoNotOptimize(data);
+		destroy(data, data + size);
+		alloc.deallocate(data, cap);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+/* push_back growth, std::vector moves the tuples one at a time */
+template<class Vec>
+static void BM_Growth(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vec v;
+		for (int i = 0; i < n; ++i) v.emplace_back(i, i * 0.5, -i);
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* records holding a unique_ptr, moved one by one unless opted in */
+template<class Vec>
+static void BM_Growth_Record(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vec v;
+		for (int i = 0; i < n; ++i) v.emplace_back(i);
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_Relocate, row, false)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Relocate, row, true)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Growth, vector<row>)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Growth, pluto::small_vector<row, 1>)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Growth_Record, vector<record>)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth_Record, pluto::small_vector<record, 1>)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
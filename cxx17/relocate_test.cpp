@@ -0,0 +1,140 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 17:26:40
+ * @brief
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "relocate.h"
+#include "small_vector.h"
+#include "common/define.h"
+
+using namespace std;
+
+namespace {
+
+/* owns its buffer through a unique_ptr, nothing points back into it */
+struct record
+{
+	int id = 0;
+	unique_ptr<int[]> payload;
+
+	record() = default;
+	explicit record(int i) : id(i), payload(new int[4]{ i, i, i, i }) {}
+};
+
+/* counts move constructions, to see which path ran */
+struct counted
+{
+	static inline int moves = 0;
+	int v = 0;
+
+	counted(int x) : v(x) {}
+	counted(counted&& o) noexcept : v(o.v) { ++moves; }
+	counted& operator=(counted&&) = default;
+	~counted() {}
+};
+
+} // namespace
+
+PLUTO_TRIVIALLY_RELOCATABLE(record);
+
+TEST(PLUTO, CXX17_RELOCATE) {
+
+	{
+		// what counts as trivially relocatable
+		static_assert(pluto::is_trivially_relocatable_v<int>);
+		static_assert(pluto::is_trivially_relocatable_v<tuple<int, double, int>>);
+		static_assert(!is_trivially_copyable_v<tuple<int, double, int>>);
+		static_assert(pluto::is_trivially_relocatable_v<pair<tuple<int, char>, array<float, 3>>>);
+		static_assert(!pluto::is_trivially_relocatable_v<unique_ptr<int>>);
+		static_assert(!pluto::is_trivially_relocatable_v<counted>);
+
+		// opted in, and carried into tuple members
+		static_assert(pluto::is_trivially_relocatable_v<record>);
+		static_assert(pluto::is_trivially_relocatable_v<tuple<int, record>>);
+		static_assert(!pluto::is_trivially_relocatable_v<tuple<int, counted>>);
+
+		TEST_COUT << boolalpha << pluto::is_trivially_relocatable_v<tuple<int, double, int>> << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// memmove path, the sources are simply forgotten
+		alignas(record) unsigned char from[sizeof(record) * 3], to[sizeof(record) * 3];
+		record* src = reinterpret_cast<record*>(from);
+		record* dst = reinterpret_cast<record*>(to);
+		for (int i = 0; i < 3; ++i) ::new (src + i) record(i + 1);
+
+		record* end = pluto::relocate(src, src + 3, dst);
+		EXPECT_EQ(dst + 3, end);
+		for (int i = 0; i < 3; ++i)
+		{
+			EXPECT_EQ(i + 1, dst[i].id);
+			EXPECT_EQ(i + 1, dst[i].payload[3]);
+		}
+		destroy(dst, end);
+
+		// element-wise path
+		counted::moves = 0;
+		alignas(counted) unsigned char cfrom[sizeof(counted) * 2], cto[sizeof(counted) * 2];
+		counted* csrc = reinterpret_cast<counted*>(cfrom);
+		counted* cdst = reinterpret_cast<counted*>(cto);
+		::new (csrc) counted(7);
+		::new (csrc + 1) counted(8);
+		pluto::relocate(csrc, csrc + 2, cdst);
+		EXPECT_EQ(2, counted::moves);
+		EXPECT_EQ(8, cdst[1].v);
+		destroy(cdst, cdst + 2);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		vector<int> a{ 1, 2, 3, 4, 5 }, b(5);
+		EXPECT_EQ(b.end(), pluto::bulk_copy(a.begin(), a.end(), b.begin()));
+		EXPECT_EQ(a, b);
+
+		// overlapping, shift left by one
+		pluto::bulk_copy(a.begin() + 1, a.end(), a.begin());
+		EXPECT_EQ((vector<int>{ 2, 3, 4, 5, 5 }), a);
+
+		vector<string> s{ "x", "y" }, t(2);
+		pluto::bulk_copy(s.begin(), s.end(), t.begin());
+		EXPECT_EQ(s, t);
+
+		int raw[3] = { 4, 5, 6 };
+		alignas(int) unsigned char buf[sizeof(raw)];
+		auto [in, out] = pluto::uninitialized_move_n(raw, 3, reinterpret_cast<int*>(buf));
+		EXPECT_EQ(raw + 3, in);
+		EXPECT_EQ(6, *(out - 1));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// small_vector grows through relocate
+		pluto::small_vector<record, 2> v;
+		for (int i = 0; i < 100; ++i) v.emplace_back(i);
+		for (int i = 0; i < 100; ++i) EXPECT_EQ(i, v[i].payload[0]);
+
+		pluto::small_vector<record, 4> inl;
+		inl.emplace_back(1);
+		inl.emplace_back(2);
+		auto moved = std::move(inl);
+		EXPECT_TRUE(inl.empty());
+		EXPECT_EQ(2, moved[1].payload[2]);
+
+		pluto::small_vector<tuple<int, double, int>, 1> t;
+		for (int i = 0; i < 50; ++i) t.emplace_back(i, i * 0.5, -i);
+		EXPECT_EQ(make_tuple(49, 24.5, -49), t.back());
+	}
+}
@@ -0,0 +1,481 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 03:18:25
+ * @brief
+ */
+
+#include "shm_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <new>
+#include <system_error>
+#include <thread>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace shm_ring
+{
+namespace detail
+{
+
+namespace
+{
+
+constexpr std::uint64_t magic = 0x676e6972'6f74756cull;	// "lutoring"
+constexpr std::uint32_t layout_version = 1;
+
+enum slot_state : std::uint32_t
+{
+	slot_free,
+	slot_attaching,	// being set up, the producer ignores it
+	slot_active,
+};
+
+/* one consumer's cursor, a cache line of its own */
+struct alignas(64) consumer_slot
+{
+	std::atomic<std::uint32_t> state;
+	std::atomic<std::int32_t> pid;
+	std::atomic<std::uint64_t> read_pos;
+};
+
+/*
+ * The start of the shared memory object, the data follows. Every field
+ * is a number or an atomic, no pointers: each process maps the object
+ * at a different address. The futex words are 32 bits, as futex(2)
+ * wants them.
+ */
+struct shared_header
+{
+	std::atomic<std::uint64_t> magic;		// stored last by the producer, when the rest is ready
+	std::uint32_t version;
+	std::int32_t producer_pid;
+	std::uint64_t signature;
+	std::uint64_t capacity;
+	std::atomic<std::uint32_t> closed;
+
+	alignas(64) std::atomic<std::uint64_t> write_pos;
+	std::atomic<std::uint32_t> data_seq;		// futex: bumped after a publish when readers sleep
+	std::atomic<std::uint32_t> readers_waiting;
+
+	alignas(64) std::atomic<std::uint32_t> space_seq;	// futex: bumped after a release when the writer sleeps
+	std::atomic<std::uint32_t> writer_waiting;
+
+	consumer_slot consumers[max_consumers];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+	"shared atomics must be lock free to work across processes");
+
+constexpr std::size_t data_offset = align_up(sizeof(shared_header), 64);
+
+/* sleep slices, so a dead peer is noticed while waiting */
+constexpr std::chrono::milliseconds wait_slice{ 100 };
+
+std::string full_name(const std::string& name)
+{
+	return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+[[noreturn]] void fail(const std::string& what)
+{
+	throw std::system_error(errno, std::generic_category(), "shm_ring: " + what);
+}
+
+#if defined(__linux__)
+
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::nanoseconds timeout)
+{
+	const auto s = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+	timespec ts{ static_cast<time_t>(s.count()), static_cast<long>((timeout - s).count()) };
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word)
+{
+	syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+bool process_alive(std::int32_t pid)
+{
+	return pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/* a finished ring is at name, its producer has not closed it and is still running */
+bool has_live_producer(const std::string& name)
+{
+	const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0) return false;
+	void* p = MAP_FAILED;
+	struct stat st;
+	if (fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(shared_header))
+	{
+		p = mmap(nullptr, sizeof(shared_header), PROT_READ, MAP_SHARED, fd, 0);
+	}
+	close(fd);
+	if (p == MAP_FAILED) return false;
+
+	const shared_header& h = *static_cast<const shared_header*>(p);
+	const bool live = h.magic.load(std::memory_order_acquire) == magic && h.closed.load() == 0 && process_alive(h.producer_pid);
+	munmap(p, sizeof(shared_header));
+	return live;
+}
+
+#endif
+
+} // namespace
+
+/* the mapped object: header and data */
+class mapping
+{
+public:
+#if defined(__linux__)
+	mapping(const std::string& name, std::size_t bytes, bool create) : name_(full_name(name))
+	{
+		int fd;
+		if (create)
+		{
+			if (has_live_producer(name_))
+			{
+				errno = EEXIST;
+				fail(name_ + " already has a running producer");
+			}
+			shm_unlink(name_.c_str());	// a stale ring of a producer that is gone
+			fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0) fail("shm_open " + name_);
+			if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			{
+				close(fd);
+				shm_unlink(name_.c_str());
+				fail("ftruncate " + name_);
+			}
+		}
+		else
+		{
+			fd = shm_open(name_.c_str(), O_RDWR, 0);
+			if (fd < 0) fail("shm_open " + name_);
+			struct stat st;
+			if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < data_offset)
+			{
+				close(fd);
+				errno = EINVAL;
+				fail(name_ + " is not a ring");
+			}
+			bytes = static_cast<std::size_t>(st.st_size);
+		}
+
+		void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) fail("mmap " + name_);
+		base_ = static_cast<char*>(p);
+		bytes_ = bytes;
+		owner_ = create;
+	}
+
+	~mapping()
+	{
+		munmap(base_, bytes_);
+		if (owner_) shm_unlink(name_.c_str());
+	}
+#else
+	mapping(const std::string& name, std::size_t, bool) : name_(full_name(name))
+	{
+		errno = ENOSYS;
+		fail("shared memory rings need Linux");
+	}
+
+	~mapping() = default;
+#endif
+
+	mapping(const mapping&) = delete;
+	mapping& operator=(const mapping&) = delete;
+
+	shared_header& header() { return *reinterpret_cast<shared_header*>(base_); }
+	char* data() { return base_ + data_offset; }
+	std::size_t bytes() const { return bytes_; }
+
+private:
+	std::string name_;
+	char* base_ = nullptr;
+	std::size_t bytes_ = 0;
+	bool owner_ = false;
+};
+
+#if defined(__linux__)
+
+ring_producer::ring_producer(const std::string& name, std::size_t capacity, std::uint64_t signature)
+{
+	if (capacity < 4096 || (capacity & (capacity - 1)) != 0) throw std::invalid_argument("shm_ring: capacity must be a power of two >= 4096");
+	map_ = new mapping(name, data_offset + capacity, true);
+
+	// the object comes zero filled from ftruncate, placement new makes the atomics official
+	shared_header& h = *new (&map_->header()) shared_header{};
+	h.version = layout_version;
+	h.producer_pid = static_cast<std::int32_t>(getpid());
+	h.signature = signature;
+	h.capacity = capacity;
+	h.magic.store(magic, std::memory_order_release);
+	cached_limit_ = capacity;
+}
+
+ring_producer::~ring_producer()
+{
+	shared_header& h = map_->header();
+	h.closed.store(1);
+	h.data_seq.fetch_add(1);
+	futex_wake(h.data_seq);
+	delete map_;
+}
+
+std::size_t ring_producer::consumers() const
+{
+	std::size_t n = 0;
+	for (const auto& c : map_->header().consumers) n += c.state.load() == slot_active;
+	return n;
+}
+
+std::size_t ring_producer::capacity() const
+{
+	return static_cast<std::size_t>(map_->header().capacity);
+}
+
+/* the oldest position any consumer still reads, write_pos_ if there is none */
+std::uint64_t ring_producer::slowest_consumer()
+{
+	std::uint64_t slowest = write_pos_;
+	for (auto& c : map_->header().consumers)
+	{
+		if (c.state.load() == slot_active) slowest = std::min(slowest, c.read_pos.load());
+	}
+	return slowest;
+}
+
+/* consumers that died without closing, stop waiting for them */
+void ring_producer::drop_dead_consumers()
+{
+	for (auto& c : map_->header().consumers)
+	{
+		if (c.state.load() == slot_active && !process_alive(c.pid.load())) c.state.store(slot_free);
+	}
+}
+
+bool ring_producer::room_for(std::uint64_t end)
+{
+	if (end <= cached_limit_) return true;
+	cached_limit_ = slowest_consumer() + capacity();
+	return end <= cached_limit_;
+}
+
+char* ring_producer::reserve(std::size_t n, bool wait)
+{
+	shared_header& h = map_->header();
+	const std::size_t cap = capacity();
+	const std::size_t size = align_up(sizeof(record_header) + n, 8);
+	const std::size_t room = cap - static_cast<std::size_t>(write_pos_ & (cap - 1));
+	const std::uint64_t end = write_pos_ + (room < size ? room + size : size);
+
+	while (!room_for(end))
+	{
+		if (!wait) return nullptr;
+
+		// announce, then look again: a consumer releasing in between either sees writer_waiting or bumped space_seq
+		h.writer_waiting.fetch_add(1);
+		const std::uint32_t seq = h.space_seq.load();
+		if (!room_for(end))
+		{
+			drop_dead_consumers();
+			futex_wait(h.space_seq, seq, wait_slice);
+		}
+		h.writer_waiting.fetch_sub(1);
+	}
+
+	std::uint64_t pos = write_pos_;
+	if (room < size)
+	{
+		const record_header pad{ static_cast<std::uint32_t>(room), skip_record };
+		std::memcpy(map_->data() + (pos & (cap - 1)), &pad, sizeof(pad));
+		pos += room;
+	}
+	const record_header rh{ static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(n) };
+	char* p = map_->data() + (pos & (cap - 1));
+	std::memcpy(p, &rh, sizeof(rh));
+	pending_ = pos + size;
+	return p + sizeof(record_header);
+}
+
+void ring_producer::commit()
+{
+	shared_header& h = map_->header();
+	write_pos_ = pending_;
+	h.write_pos.store(write_pos_, std::memory_order_release);
+
+	// the store above and the load below must not pass each other, see ring_consumer::next
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (h.readers_waiting.load(std::memory_order_relaxed) != 0)
+	{
+		h.data_seq.fetch_add(1);
+		futex_wake(h.data_seq);
+	}
+}
+
+ring_consumer::ring_consumer(const std::string& name, std::uint64_t signature) : map_(new mapping(name, 0, false))
+{
+	shared_header& h = map_->header();
+	if (h.magic.load(std::memory_order_acquire) != magic || h.version != layout_version
+		|| map_->bytes() < data_offset + h.capacity)
+	{
+		delete map_;
+		errno = EINVAL;
+		fail(name + " is not a ring, or not ready yet");
+	}
+	if (h.signature != signature)
+	{
+		delete map_;
+		errno = EINVAL;
+		fail(name + " carries a different record type");
+	}
+
+	for (slot_ = 0; slot_ < max_consumers; ++slot_)
+	{
+		consumer_slot& c = h.consumers[slot_];
+		std::uint32_t expected = slot_free;
+		if (!c.state.compare_exchange_strong(expected, slot_attaching)) continue;
+
+		/*
+		 * Start at the current end. The cursor is published as active
+		 * before write_pos is read again, so the producer either sees this
+		 * consumer or had not yet written past the position read here.
+		 */
+		c.pid.store(static_cast<std::int32_t>(getpid()));
+		c.read_pos.store(h.write_pos.load());
+		c.state.store(slot_active);
+		read_pos_ = h.write_pos.load();
+		c.read_pos.store(read_pos_);
+		return;
+	}
+
+	delete map_;
+	errno = EBUSY;
+	fail(name + " has max_consumers consumers already");
+}
+
+ring_consumer::~ring_consumer()
+{
+	shared_header& h = map_->header();
+	h.consumers[slot_].state.store(slot_free);
+	if (h.writer_waiting.load() != 0)
+	{
+		h.space_seq.fetch_add(1);
+		futex_wake(h.space_seq);
+	}
+	delete map_;
+}
+
+bool ring_consumer::closed() const
+{
+	shared_header& h = map_->header();
+	return h.closed.load() != 0 || !process_alive(h.producer_pid);
+}
+
+void ring_consumer::release()
+{
+	if (pending_ == 0) return;
+	shared_header& h = map_->header();
+	read_pos_ += pending_;
+	pending_ = 0;
+	h.consumers[slot_].read_pos.store(read_pos_, std::memory_order_release);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (h.writer_waiting.load(std::memory_order_relaxed) != 0)
+	{
+		h.space_seq.fetch_add(1);
+		futex_wake(h.space_seq);
+	}
+}
+
+const char* ring_consumer::next(std::size_t& length, std::chrono::nanoseconds timeout)
+{
+	release();
+
+	shared_header& h = map_->header();
+	const std::size_t cap = static_cast<std::size_t>(h.capacity);
+	const auto deadline = timeout == std::chrono::nanoseconds::max()
+		? std::chrono::steady_clock::time_point::max()
+		: std::chrono::steady_clock::now() + timeout;
+
+	for (;;)
+	{
+		while (h.write_pos.load(std::memory_order_acquire) != read_pos_)
+		{
+			const char* p = map_->data() + (read_pos_ & (cap - 1));
+			record_header rh;
+			std::memcpy(&rh, p, sizeof(rh));
+			if (rh.length == skip_record)
+			{
+				read_pos_ += rh.size;	// the padding is not worth a release of its own
+				continue;
+			}
+			pending_ = rh.size;
+			length = rh.length;
+			return p + sizeof(record_header);
+		}
+
+		if (closed() || timeout == std::chrono::nanoseconds::zero()) return nullptr;
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= deadline) return nullptr;
+
+		// a short spin first, a record is often only a moment away
+		bool arrived = false;
+		for (int i = 0; i < 256 && !arrived; ++i)
+		{
+			arrived = h.write_pos.load(std::memory_order_acquire) != read_pos_;
+			if (!arrived) std::this_thread::yield();
+		}
+		if (arrived) continue;
+
+		h.readers_waiting.fetch_add(1);
+		const std::uint32_t seq = h.data_seq.load();
+		if (h.write_pos.load() == read_pos_ && h.closed.load() == 0)
+		{
+			futex_wait(h.data_seq, seq, std::min<std::chrono::nanoseconds>(deadline - now, wait_slice));
+		}
+		h.readers_waiting.fetch_sub(1);
+	}
+}
+
+#else
+
+ring_producer::ring_producer(const std::string& name, std::size_t, std::uint64_t) : map_(new mapping(name, 0, true)) {}
+ring_producer::~ring_producer() { delete map_; }
+char* ring_producer::reserve(std::size_t, bool) { return nullptr; }
+void ring_producer::commit() {}
+std::size_t ring_producer::consumers() const { return 0; }
+std::size_t ring_producer::capacity() const { return 0; }
+
+ring_consumer::ring_consumer(const std::string& name, std::uint64_t) : map_(new mapping(name, 0, false)) {}
+ring_consumer::~ring_consumer() { delete map_; }
+bool ring_consumer::closed() const { return true; }
+void ring_consumer::release() {}
+const char* ring_consumer::next(std::size_t&, std::chrono::nanoseconds) { return nullptr; }
+
+#endif
+
+} // detail
+} // shm_ring
+} // cxx17
+} // pluto
@@ -0,0 +1,524 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 03:18:25
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace shm_ring
+{
+
+/*
+ * Records between processes through shared memory. One producer process
+ * writes tuple / variant shaped records into a ring in a POSIX shared
+ * memory object (shm_open + mmap); any number of consumer processes, up
+ * to max_consumers, each read every record:
+ *
+ *		// process A
+ *		shm_ring::producer<std::tuple<double, char, std::string>> out("/quotes", 1 << 20);
+ *		out.write(std::tuple{ 101.25, 'B', std::string("EURUSD") });
+ *		out.emplace(101.5, 'S', "EURUSD");	// no std::string built on the way
+ *
+ *		// process B
+ *		shm_ring::consumer<std::tuple<double, char, std::string>> in("/quotes");
+ *		while (auto r = in.read())
+ *		{
+ *			auto [price, side, symbol] = *r;	// double, char, std::string_view into the ring
+ *		}
+ *
+ * Compared with a socket there is no syscall per record and one copy,
+ * the producer's encode into the ring; the consumer reads in place.
+ *
+ * Encoding. A record is a fixed part, laid out like a C struct of its
+ * fields, followed by a variable area for the characters of its strings.
+ * A string field holds {offset, length}, the offset counted from the
+ * start of the record, never a pointer, so the bytes mean the same in
+ * every process whatever address the ring is mapped at. Tuples are their
+ * fields in order, each at its natural alignment; a variant is a uint32
+ * index followed by room for the largest alternative. Both nest.
+ * Arithmetic and enum fields are stored as is: producer and consumer
+ * must be the same build for the same machine, which the ring checks
+ * with a signature of the record type taken at open().
+ *
+ * Reading. read() returns a view: scalar fields come out by value,
+ * strings as std::string_view pointing into the shared memory, tuples as
+ * tuple_view (structured bindings work), variants as variant_view with
+ * index() / get<I>() / visit(). A view stays valid until the next
+ * read(), or release(): until then the producer may not overwrite it.
+ *
+ * Flow control. The producer never overruns the slowest consumer; when
+ * the ring is full write() waits and try_write() fails. Waiting on both
+ * sides is a futex on a word in the shared header, so an idle consumer
+ * sleeps in the kernel instead of spinning, and the wake-up syscall is
+ * only made when somebody is actually asleep. A consumer sees the
+ * records written after it opened the ring. A consumer that dies without
+ * closing is noticed by the producer (its pid is gone) and dropped, so
+ * it cannot stall the ring forever; consumers in turn notice a producer
+ * that is gone.
+ *
+ * Linux only; elsewhere opening a ring throws std::system_error.
+ */
+
+inline constexpr std::size_t max_consumers = 16;
+
+namespace detail
+{
+
+constexpr std::size_t align_up(std::size_t n, std::size_t a) { return (n + a - 1) / a * a; }
+
+constexpr std::uint64_t mix(std::uint64_t h, std::uint64_t v)
+{
+	// FNV-1a over the 8 bytes of v
+	for (int i = 0; i < 8; ++i)
+	{
+		h ^= (v >> (8 * i)) & 0xff;
+		h *= 0x100000001b3ull;
+	}
+	return h;
+}
+
+/*
+ * wire<T> describes how a field of type T is laid out:
+ *
+ *	size, align		of the fixed part
+ *	signature()		identifies the layout, checked when a consumer opens the ring
+ *	extra(v)		bytes v needs in the variable area
+ *	write(...)		encodes v at record + at, strings go to record + tail
+ *	read(...)		the value, or a view of it, from record + at
+ */
+template<class T, class = void>
+struct wire
+{
+	static_assert(sizeof(T) == 0, "shm_ring: fields must be arithmetic, enum, std::string, std::tuple or std::variant");
+};
+
+template<class T>
+struct wire<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+{
+	static constexpr std::size_t size = sizeof(T);
+	static constexpr std::size_t align = alignof(T);
+
+	using view = T;
+
+	static constexpr std::uint64_t signature()
+	{
+		return mix(mix(0xcbf29ce484222325ull, 'a'), sizeof(T) * 4 + std::is_floating_point_v<T> * 2 + std::is_signed_v<T>);
+	}
+
+	template<class U>
+	static std::size_t extra(const U&) { return 0; }
+
+	template<class U>
+	static void write(char* record, std::size_t at, const U& v, std::size_t&)
+	{
+		const T t = static_cast<T>(v);
+		std::memcpy(record + at, &t, sizeof(T));
+	}
+
+	static view read(const char* record, std::size_t at)
+	{
+		T t;
+		std::memcpy(&t, record + at, sizeof(T));
+		return t;
+	}
+};
+
+/* {offset, length} in the fixed part, the characters in the variable area */
+struct string_ref
+{
+	std::uint32_t offset;
+	std::uint32_t length;
+};
+
+template<class T>
+struct wire<T, std::enable_if_t<std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>>>
+{
+	static constexpr std::size_t size = sizeof(string_ref);
+	static constexpr std::size_t align = alignof(string_ref);
+
+	using view = std::string_view;
+
+	static constexpr std::uint64_t signature() { return mix(0xcbf29ce484222325ull, 's'); }
+
+	template<class U>
+	static std::size_t extra(const U& v) { return std::string_view(v).size(); }
+
+	template<class U>
+	static void write(char* record, std::size_t at, const U& v, std::size_t& tail)
+	{
+		const std::string_view s(v);
+		const string_ref ref{ static_cast<std::uint32_t>(tail), static_cast<std::uint32_t>(s.size()) };
+		std::memcpy(record + at, &ref, sizeof(ref));
+		if (!s.empty()) std::memcpy(record + tail, s.data(), s.size());	// an empty view may hold nullptr
+		tail += s.size();
+	}
+
+	static view read(const char* record, std::size_t at)
+	{
+		string_ref ref;
+		std::memcpy(&ref, record + at, sizeof(ref));
+		return { record + ref.offset, ref.length };
+	}
+};
+
+template<class... Ts>
+class tuple_view;
+
+template<class... Ts>
+class variant_view;
+
+template<class... Ts>
+struct wire<std::tuple<Ts...>>
+{
+	static constexpr std::size_t align = std::max({ std::size_t{ 1 }, wire<Ts>::align... });
+
+	/* where each field starts in the fixed part */
+	static constexpr std::array<std::size_t, sizeof...(Ts)> offsets = [] {
+		std::array<std::size_t, sizeof...(Ts)> out{};
+		std::size_t at = 0, i = 0;
+		((out[i++] = at = align_up(at, wire<Ts>::align), at += wire<Ts>::size), ...);
+		return out;
+	}();
+
+	static constexpr std::size_t size = [] {
+		std::size_t at = 0;
+		((at = align_up(at, wire<Ts>::align) + wire<Ts>::size), ...);
+		return align_up(at, align);
+	}();
+
+	using view = tuple_view<Ts...>;
+
+	static constexpr std::uint64_t signature()
+	{
+		std::uint64_t h = mix(0xcbf29ce484222325ull, 't');
+		((h = mix(h, wire<Ts>::signature())), ...);
+		return mix(h, sizeof...(Ts));
+	}
+
+	template<class U>
+	static std::size_t extra(const U& v)
+	{
+		static_assert(std::tuple_size_v<U> == sizeof...(Ts), "shm_ring: the tuple written has a different number of fields");
+		return std::apply([](const auto&... fields) {
+			return (std::size_t{ 0 } + ... + wire<Ts>::extra(fields));
+		}, v);
+	}
+
+	template<class U>
+	static void write(char* record, std::size_t at, const U& v, std::size_t& tail)
+	{
+		std::apply([&](const auto&... fields) {
+			std::size_t i = 0;
+			(wire<Ts>::write(record, at + offsets[i++], fields, tail), ...);
+		}, v);
+	}
+
+	static view read(const char* record, std::size_t at) { return view(record, at); }
+};
+
+template<class... Ts>
+struct wire<std::variant<Ts...>>
+{
+	static constexpr std::size_t align = std::max({ alignof(std::uint32_t), wire<Ts>::align... });
+	static constexpr std::size_t payload = align_up(sizeof(std::uint32_t), align);
+	static constexpr std::size_t size = align_up(payload + std::max({ std::size_t{ 0 }, wire<Ts>::size... }), align);
+
+	using view = variant_view<Ts...>;
+
+	static constexpr std::uint64_t signature()
+	{
+		std::uint64_t h = mix(0xcbf29ce484222325ull, 'v');
+		((h = mix(h, wire<Ts>::signature())), ...);
+		return mix(h, sizeof...(Ts));
+	}
+
+	/* U is the variant itself or exactly one of its alternatives */
+	template<class U>
+	static std::size_t extra(const U& v)
+	{
+		if constexpr (std::is_same_v<U, std::variant<Ts...>>)
+		{
+			return std::visit([](const auto& alt) { return extra(alt); }, v);
+		}
+		else
+		{
+			return wire<std::variant_alternative_t<index_of<U>(), std::variant<Ts...>>>::extra(v);
+		}
+	}
+
+	template<class U>
+	static void write(char* record, std::size_t at, const U& v, std::size_t& tail)
+	{
+		if constexpr (std::is_same_v<U, std::variant<Ts...>>)
+		{
+			std::visit([&](const auto& alt) { write(record, at, alt, tail); }, v);
+		}
+		else
+		{
+			constexpr std::uint32_t index = index_of<U>();
+			std::memcpy(record + at, &index, sizeof(index));
+			wire<std::variant_alternative_t<index, std::variant<Ts...>>>::write(record, at + payload, v, tail);
+		}
+	}
+
+	static view read(const char* record, std::size_t at) { return view(record, at); }
+
+	template<class U>
+	static constexpr std::uint32_t index_of()
+	{
+		constexpr bool match[] = { std::is_same_v<U, Ts>... };
+		static_assert(std::count(std::begin(match), std::end(match), true) == 1,
+			"shm_ring: write the variant, or a type that is exactly one of its alternatives");
+		return static_cast<std::uint32_t>(std::find(std::begin(match), std::end(match), true) - std::begin(match));
+	}
+};
+
+template<class... Ts>
+class tuple_view
+{
+public:
+	tuple_view(const char* record, std::size_t at) : record_(record), at_(at) {}
+
+	template<std::size_t I>
+	auto get() const
+	{
+		using field = std::tuple_element_t<I, std::tuple<Ts...>>;
+		return wire<field>::read(record_, at_ + wire<std::tuple<Ts...>>::offsets[I]);
+	}
+
+private:
+	const char* record_;
+	std::size_t at_;
+};
+
+template<class... Ts>
+class variant_view
+{
+public:
+	variant_view(const char* record, std::size_t at) : record_(record), at_(at)
+	{
+		std::memcpy(&index_, record + at, sizeof(index_));
+	}
+
+	std::size_t index() const { return index_; }
+
+	template<std::size_t I>
+	auto get() const
+	{
+		using alternative = std::variant_alternative_t<I, std::variant<Ts...>>;
+		if (index_ != I) throw std::bad_variant_access();
+		return wire<alternative>::read(record_, at_ + wire<std::variant<Ts...>>::payload);
+	}
+
+	/* f(view of the active alternative) */
+	template<class F>
+	decltype(auto) visit(F&& f) const
+	{
+		return visit_at(std::forward<F>(f), std::index_sequence_for<Ts...>{});
+	}
+
+private:
+	template<class F, std::size_t... I>
+	decltype(auto) visit_at(F&& f, std::index_sequence<I...>) const
+	{
+		using result = std::common_type_t<decltype(f(std::declval<typename wire<Ts>::view>()))...>;
+		using entry = result (*)(const variant_view&, F&);
+		static constexpr entry table[] = {
+			[](const variant_view& v, F& f) -> result { return f(v.template get<I>()); }...
+		};
+		return table[index_](*this, f);
+	}
+
+	const char* record_;
+	std::size_t at_;
+	std::uint32_t index_;
+};
+
+template<std::size_t I, class... Ts>
+auto get(const tuple_view<Ts...>& v) { return v.template get<I>(); }
+
+template<std::size_t I, class... Ts>
+auto get(const variant_view<Ts...>& v) { return v.template get<I>(); }
+
+// the byte ring in the shared memory object, shm_ring.cpp
+
+/* record header in the ring: size is a multiple of 8 and includes the header */
+struct record_header
+{
+	std::uint32_t size;
+	std::uint32_t length;	// payload bytes, skip_record: padding up to the end of the ring
+};
+
+inline constexpr std::uint32_t skip_record = ~std::uint32_t{ 0 };
+
+class mapping;
+
+class ring_producer
+{
+public:
+	ring_producer(const std::string& name, std::size_t capacity, std::uint64_t signature);
+	~ring_producer();
+
+	ring_producer(const ring_producer&) = delete;
+	ring_producer& operator=(const ring_producer&) = delete;
+
+	/* room for a payload of n bytes, 8-aligned; nullptr if full and !wait */
+	char* reserve(std::size_t n, bool wait);
+	void commit();
+
+	std::size_t consumers() const;
+	std::size_t capacity() const;
+
+private:
+	bool room_for(std::uint64_t end);
+	std::uint64_t slowest_consumer();
+	void drop_dead_consumers();
+
+	mapping* map_;
+	std::uint64_t write_pos_ = 0;
+	std::uint64_t pending_ = 0;
+	std::uint64_t cached_limit_ = 0;	// write_pos_ may go up to here without looking at the consumers
+};
+
+class ring_consumer
+{
+public:
+	ring_consumer(const std::string& name, std::uint64_t signature);
+	~ring_consumer();
+
+	ring_consumer(const ring_consumer&) = delete;
+	ring_consumer& operator=(const ring_consumer&) = delete;
+
+	/* the next payload and its length, waiting up to timeout; nullptr on timeout or when the producer is gone */
+	const char* next(std::size_t& length, std::chrono::nanoseconds timeout);
+
+	/* let the producer reuse the record next() returned last */
+	void release();
+
+	bool closed() const;
+
+private:
+	mapping* map_;
+	std::size_t slot_;
+	std::uint64_t read_pos_ = 0;
+	std::uint32_t pending_ = 0;
+};
+
+} // detail
+
+template<class Record>
+class producer
+{
+	static_assert(detail::wire<Record>::align <= 8, "shm_ring: records are 8-byte aligned in the ring");
+
+public:
+	/*
+	 * creates the shared memory object, replacing a stale one of the same
+	 * name; throws std::system_error (EEXIST) if its producer is still running
+	 */
+	explicit producer(const std::string& name, std::size_t capacity = std::size_t{ 1 } << 20)
+		: ring_(name, capacity, detail::wire<Record>::signature()) {}
+
+	/* value is a Record, or anything encoding like one (a tuple of string_views for a tuple of strings, ...) */
+	template<class U>
+	void write(const U& value) { put(value, true); }
+
+	template<class U>
+	bool try_write(const U& value) { return put(value, false); }
+
+	/* the fields of a tuple record, written without building the tuple */
+	template<class... Args>
+	void emplace(const Args&... args) { put(std::forward_as_tuple(args...), true); }
+
+	std::size_t consumers() const { return ring_.consumers(); }
+
+private:
+	template<class U>
+	bool put(const U& value, bool wait)
+	{
+		using w = detail::wire<Record>;
+		const std::size_t length = w::size + w::extra(value);
+		if (length > ring_.capacity() / 2 - sizeof(detail::record_header)) throw std::length_error("shm_ring: record larger than half the ring");
+
+		char* record = ring_.reserve(length, wait);
+		if (record == nullptr) return false;
+		std::size_t tail = w::size;
+		w::write(record, 0, value, tail);
+		ring_.commit();
+		return true;
+	}
+
+	detail::ring_producer ring_;
+};
+
+template<class Record>
+class consumer
+{
+public:
+	using view = typename detail::wire<Record>::view;
+
+	/* attaches to an existing ring; throws if there is none, it is full of consumers, or holds another record type */
+	explicit consumer(const std::string& name) : ring_(name, detail::wire<Record>::signature()) {}
+
+	/*
+	 * The next record, waiting for it as long as the producer is alive.
+	 * Releases the previous view. Empty once the producer has closed the
+	 * ring and everything was read.
+	 */
+	std::optional<view> read() { return read_for(std::chrono::nanoseconds::max()); }
+
+	/* as read(), empty after timeout */
+	std::optional<view> read_for(std::chrono::nanoseconds timeout)
+	{
+		std::size_t length;
+		const char* record = ring_.next(length, timeout);
+		if (record == nullptr) return std::nullopt;
+		return detail::wire<Record>::read(record, 0);
+	}
+
+	std::optional<view> try_read() { return read_for(std::chrono::nanoseconds::zero()); }
+
+	/* done with the current view before the next read */
+	void release() { ring_.release(); }
+
+	/* the producer is gone; records still in the ring can be read */
+	bool closed() const { return ring_.closed(); }
+
+private:
+	detail::ring_consumer ring_;
+};
+
+} // shm_ring
+} // cxx17
+} // pluto
+
+// structured bindings for tuple_view
+template<class... Ts>
+struct std::tuple_size<pluto::cxx17::shm_ring::detail::tuple_view<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template<std::size_t I, class... Ts>
+struct std::tuple_element<I, pluto::cxx17::shm_ring::detail::tuple_view<Ts...>>
+{
+	using type = typename pluto::cxx17::shm_ring::detail::wire<std::tuple_element_t<I, std::tuple<Ts...>>>::view;
+};
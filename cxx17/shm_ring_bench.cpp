@@ -0,0 +1,132 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:37:12
+ * @brief
+ */
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "shm_ring.h"
+
+using namespace std;
+using namespace pluto::cxx17;
+
+#if defined(__linux__)
+
+namespace
+{
+
+using quote = tuple<double, char, string>;
+
+constexpr int records_per_iteration = 1 << 16;
+
+const string symbols[] = { "EURUSD", "USDJPY", "GBPUSD", "AUDUSD-LONGER-SYMBOL-NAME" };
+
+/* the socket side: double, char, uint32 length, the characters */
+void send_quote(int fd, double price, char side, const string& symbol)
+{
+	char buf[64];
+	const auto n = static_cast<uint32_t>(symbol.size());
+	memcpy(buf, &price, 8);
+	buf[8] = side;
+	memcpy(buf + 9, &n, 4);
+	memcpy(buf + 13, symbol.data(), n);
+	(void)!write(fd, buf, 13 + n);
+}
+
+bool read_exact(int fd, char* p, size_t n)
+{
+	while (n != 0)
+	{
+		const ssize_t r = read(fd, p, n);
+		if (r <= 0) return false;
+		p += r;
+		n -= static_cast<size_t>(r);
+	}
+	return true;
+}
+
+} // namespace
+
+/* the producer on a thread, the benchmark thread reads; the same path as between processes */
+static void BM_ShmRingQuotes(benchmark::State& state)
+{
+	const string name = "/pluto_shm_ring_bench_" + to_string(getpid());
+	shm_ring::producer<quote> out(name, 1 << 20);
+	shm_ring::consumer<quote> in(name);
+
+	for (auto _ : state)
+	{
+		thread producer([&out] {
+			for (int i = 0; i < records_per_iteration; ++i) out.emplace(i * 0.5, 'B', symbols[i & 3]);
+		});
+		double sum = 0;
+		size_t chars = 0;
+		for (int i = 0; i < records_per_iteration; ++i)
+		{
+			auto r = in.read();
+			sum += r->get<0>();
+			chars += r->get<2>().size();
+		}
+		producer.join();
+		benchmark::DoNotOptimize(sum);
+		benchmark::DoNotOptimize(chars);
+	}
+	state.SetItemsProcessed(state.iterations() * records_per_iteration);
+}
+
+/* the same records through an AF_UNIX socket pair: a write per record, the reader copies out */
+static void BM_SocketPairQuotes(benchmark::State& state)
+{
+	int fds[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+	{
+		state.SkipWithError("socketpair failed");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		thread producer([fd = fds[0]] {
+			for (int i = 0; i < records_per_iteration; ++i) send_quote(fd, i * 0.5, 'B', symbols[i & 3]);
+		});
+		double sum = 0;
+		size_t chars = 0;
+		char head[13];
+		string symbol;
+		for (int i = 0; i < records_per_iteration; ++i)
+		{
+			if (!read_exact(fds[1], head, sizeof(head))) break;
+			double price;
+			uint32_t n;
+			memcpy(&price, head, 8);
+			memcpy(&n, head + 9, 4);
+			symbol.resize(n);
+			if (!read_exact(fds[1], symbol.data(), n)) break;
+			sum += price;
+			chars += symbol.size();
+		}
+		producer.join();
+		benchmark::DoNotOptimize(sum);
+		benchmark::DoNotOptimize(chars);
+	}
+	state.SetItemsProcessed(state.iterations() * records_per_iteration);
+	close(fds[0]);
+	close(fds[1]);
+}
+
+BENCHMARK(BM_ShmRingQuotes)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SocketPairQuotes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+#endif
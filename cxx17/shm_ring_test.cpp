@@ -0,0 +1,194 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:02:51
+ * @brief
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "shm_ring.h"
+#include "common/child_process.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17;
+
+#if defined(__linux__)
+
+namespace
+{
+
+using quote = tuple<double, char, string>;
+using message = variant<int, double, string, tuple<int, string>>;
+
+/* the record the producer writes as number i, both processes compute it */
+quote make_quote(int i)
+{
+	return { i * 0.25, "BS"[i % 2], string(static_cast<size_t>(i % 97), static_cast<char>('a' + i % 26)) };
+}
+
+constexpr int cross_process_records = 200000;
+constexpr const char* child_env = "PLUTO_SHM_RING_CHILD";
+
+/* what the child process does: read every record, exit with 1 if one was wrong or missing */
+int run_child(const char* name)
+{
+	shm_ring::consumer<quote> in(name);
+	int count = 0, bad = 0;
+	while (auto r = in.read())
+	{
+		const auto [price, side, symbol] = *r;
+		const quote expected = make_quote(count++);
+		bad += price != get<0>(expected) || side != get<1>(expected) || symbol != get<2>(expected);
+	}
+	return bad != 0 || count != cross_process_records;	// the exit status keeps only 8 bits of a count
+}
+
+} // namespace
+
+TEST(PLUTO, CXX17_SHM_RING) {
+
+	if (const char* name = getenv(child_env)) std::_Exit(run_child(name));
+
+	const string name = "/pluto_shm_ring_test_" + to_string(getpid());
+
+	{
+		// tuple records, read in place
+		shm_ring::producer<quote> out(name, 4096);
+		shm_ring::consumer<quote> in(name);
+		EXPECT_EQ(out.consumers(), 1u);
+		EXPECT_FALSE(in.try_read().has_value());
+
+		out.write(quote{ 101.25, 'B', "EURUSD" });
+		out.emplace(101.5, 'S', "USDJPY");	// from a string literal, no std::string
+		out.emplace(0.0, 'B', string_view());
+
+		auto r = in.read();
+		ASSERT_TRUE(r.has_value());
+		EXPECT_EQ(r->get<0>(), 101.25);
+		EXPECT_EQ(r->get<1>(), 'B');
+		EXPECT_EQ(r->get<2>(), "EURUSD");
+
+		r = in.read();
+		ASSERT_TRUE(r.has_value());
+		auto [price, side, symbol] = *r;
+		static_assert(is_same_v<decltype(symbol), string_view>);
+		EXPECT_EQ(price, 101.5);
+		EXPECT_EQ(side, 'S');
+		EXPECT_EQ(symbol, "USDJPY");
+
+		r = in.read();
+		ASSERT_TRUE(r.has_value());
+		EXPECT_TRUE(r->get<2>().empty());
+		EXPECT_FALSE(in.try_read().has_value());
+
+		// the type is checked when attaching
+		using other_record = tuple<double, char, int>;
+		EXPECT_THROW(shm_ring::consumer<other_record>{ name }, system_error);
+
+		// a second producer does not take over a ring whose producer is running
+		try
+		{
+			shm_ring::producer<quote> twin(name, 4096);
+			ADD_FAILURE() << "the ring of a running producer was replaced";
+		}
+		catch (const system_error& e)
+		{
+			EXPECT_EQ(e.code(), errc::file_exists);
+		}
+		shm_ring::consumer<quote> again(name);
+		out.emplace(1.0, 'B', "GBPUSD");
+		EXPECT_EQ(in.read()->get<2>(), "GBPUSD");
+		EXPECT_EQ(again.read()->get<2>(), "GBPUSD");
+	}
+
+	EXPECT_THROW(shm_ring::consumer<quote>{ name }, system_error);	// the producer removed it
+
+	{
+		// variant records, nested tuple included
+		shm_ring::producer<message> out(name, 4096);
+		shm_ring::consumer<message> in(name);
+		out.write(message(7));
+		out.write(2.5);
+		out.write(string("text"));
+		out.write(tuple<int, string>(3, "abc"));
+
+		string seen;
+		auto show = [&seen](const auto& v) {
+			using T = decay_t<decltype(v)>;
+			if constexpr (is_same_v<T, int> || is_same_v<T, double>) seen += to_string(v) + ";";
+			else if constexpr (is_same_v<T, string_view>) seen += string(v) + ";";
+			else seen += to_string(v.template get<0>()) + "/" + string(v.template get<1>()) + ";";
+		};
+		while (auto r = in.try_read()) r->visit(show);
+		EXPECT_EQ(seen, "7;2.500000;text;3/abc;");
+
+		out.write(message(1));
+		auto r = in.read();
+		ASSERT_TRUE(r.has_value());
+		EXPECT_EQ(r->index(), 0u);
+		EXPECT_EQ(r->get<0>(), 1);
+		EXPECT_THROW(r->get<2>(), bad_variant_access);
+	}
+
+	{
+		// a small ring, wrapping thousands of times, the writer held back by two consumers
+		constexpr int records = 100000;
+		shm_ring::producer<quote> out(name, 4096);
+		shm_ring::consumer<quote> in1(name), in2(name);
+		auto check = [](shm_ring::consumer<quote>& in, int& bad) {
+			for (int i = 0; i < records; ++i)
+			{
+				auto r = in.read();
+				if (!r) { bad += records - i; return; }
+				const quote expected = make_quote(i);
+				bad += r->get<0>() != get<0>(expected) || r->get<2>() != get<2>(expected);
+			}
+		};
+		int bad1 = 0, bad2 = 0;
+		thread t1(check, ref(in1), ref(bad1)), t2(check, ref(in2), ref(bad2));
+		for (int i = 0; i < records; ++i) out.write(make_quote(i));
+		t1.join();
+		t2.join();
+		EXPECT_EQ(bad1, 0);
+		EXPECT_EQ(bad2, 0);
+	}
+
+	{
+		// two processes: this one writes, a copy of this test binary reads
+		optional<shm_ring::producer<quote>> out(in_place, name, 1 << 16);
+
+		const int child = pluto::child_process::spawn_self("PLUTO.CXX17_SHM_RING", string(child_env) + "=" + name);
+		ASSERT_GT(child, 0);
+
+		for (int i = 0; i < 1000 && out->consumers() == 0; ++i) this_thread::sleep_for(chrono::milliseconds(10));
+		ASSERT_EQ(out->consumers(), 1u);
+
+		const auto start = chrono::steady_clock::now();
+		for (int i = 0; i < cross_process_records; ++i) out->write(make_quote(i));
+		const auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+		// closing the ring ends the child's read loop
+		out.reset();
+
+		EXPECT_EQ(pluto::child_process::wait(child, chrono::seconds(60)), 0);
+		TEST_COUT << cross_process_records << " records to another process in " << ms << " ms" << endl;
+	}
+}
+
+#endif
@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 13:05:52
+ * @brief
+ */
+
+#include "small_vector.h"
@@ -0,0 +1,515 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 13:05:52
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "relocate.h"
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace small_vector_ns
+{
+
+/*
+ * small_vector<T, N> is a std::vector that keeps its first N elements
+ * inside the object itself, the same small buffer trick std::any and
+ * std::string use. Only when the (N+1)-th element arrives does it
+ * allocate, and from then on it behaves like a normal vector.
+ *
+ * Most of our argument lists are short:
+ *
+ *		std::vector<int> v;
+ *		push_back_vec(v, 6, 2, 45, 12);		// heap allocation
+ *
+ *		small_vector<int, 8> s;
+ *		push_back_vec(s, 6, 2, 45, 12);		// no allocation at all
+ *
+ * push_back_vec / append check the capacity once for the whole pack and
+ * then construct every argument in place, there is no per-element
+ * "size == capacity ?" test like in a fold of push_back.
+ *
+ * Growing relocates the elements with pluto::relocate, a single memcpy
+ * for trivially relocatable types (see relocate.h).
+ *
+ * Unlike std::vector, moving a small_vector whose elements are inline
+ * moves the elements one by one, and iterators are invalidated by
+ * swap and move.
+ */
+
+template<class T, std::size_t N>
+class small_vector
+{
+	static_assert(N > 0, "use std::vector for N == 0");
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	static constexpr size_type inline_capacity = N;
+
+	small_vector() noexcept : data_(inline_data()), size_(0), capacity_(N) {}
+
+	explicit small_vector(size_type count) : small_vector()
+	{
+		resize(count);
+	}
+
+	small_vector(size_type count, const T& value) : small_vector()
+	{
+		assign(count, value);
+	}
+
+	template<class It, class = typename std::iterator_traits<It>::iterator_category>
+	small_vector(It first, It last) : small_vector()
+	{
+		assign(first, last);
+	}
+
+	small_vector(std::initializer_list<T> il) : small_vector(il.begin(), il.end()) {}
+
+	small_vector(const small_vector& other) : small_vector(other.begin(), other.end()) {}
+
+	small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		: small_vector()
+	{
+		steal(std::move(other));
+	}
+
+	~small_vector()
+	{
+		std::destroy_n(data_, size_);
+		release();
+	}
+
+	small_vector& operator=(const small_vector& other)
+	{
+		if (this != &other) assign(other.begin(), other.end());
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			clear();
+			release();
+			data_ = inline_data();
+			capacity_ = N;
+			steal(std::move(other));
+		}
+		return *this;
+	}
+
+	small_vector& operator=(std::initializer_list<T> il)
+	{
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const T& value)
+	{
+		T copy(value); // value may live in *this
+		clear();
+		reserve(count);
+		std::uninitialized_fill_n(data_, count, copy);
+		size_ = count;
+	}
+
+	template<class It, class = typename std::iterator_traits<It>::iterator_category>
+	void assign(It first, It last)
+	{
+		clear();
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<It>::iterator_category>)
+		{
+			reserve(static_cast<size_type>(std::distance(first, last)));
+		}
+		for (; first != last; ++first) emplace_back(*first);
+	}
+
+	// element access
+
+	reference operator[](size_type i) noexcept { return data_[i]; }
+	const_reference operator[](size_type i) const noexcept { return data_[i]; }
+
+	reference at(size_type i)
+	{
+		if (i >= size_) throw std::out_of_range("small_vector::at");
+		return data_[i];
+	}
+
+	const_reference at(size_type i) const
+	{
+		if (i >= size_) throw std::out_of_range("small_vector::at");
+		return data_[i];
+	}
+
+	reference front() noexcept { return data_[0]; }
+	const_reference front() const noexcept { return data_[0]; }
+	reference back() noexcept { return data_[size_ - 1]; }
+	const_reference back() const noexcept { return data_[size_ - 1]; }
+	T* data() noexcept { return data_; }
+	const T* data() const noexcept { return data_; }
+
+	// iterators
+
+	iterator begin() noexcept { return data_; }
+	iterator end() noexcept { return data_ + size_; }
+	const_iterator begin() const noexcept { return data_; }
+	const_iterator end() const noexcept { return data_ + size_; }
+	const_iterator cbegin() const noexcept { return data_; }
+	const_iterator cend() const noexcept { return data_ + size_; }
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	// capacity
+
+	bool empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+	size_type capacity() const noexcept { return capacity_; }
+	size_type max_size() const noexcept { return std::allocator_traits<std::allocator<T>>::max_size(alloc_type()); }
+
+	/* true while the elements live in the object itself */
+	bool is_inline() const noexcept { return data_ == inline_data(); }
+
+	void reserve(size_type n)
+	{
+		if (n > capacity_) reallocate(n, 0, [](T*) {});
+	}
+
+	void shrink_to_fit()
+	{
+		if (is_inline() || size_ == capacity_) return;
+
+		small_vector tmp(std::make_move_iterator(begin()), std::make_move_iterator(end()));
+		*this = std::move(tmp);
+	}
+
+	// modifiers
+
+	void clear() noexcept
+	{
+		std::destroy_n(data_, size_);
+		size_ = 0;
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template<class... Args>
+	reference emplace_back(Args&&... args)
+	{
+		if (size_ == capacity_)
+		{
+			// build the new element first, args may refer into *this
+			reallocate(grow_to(size_ + 1), 1, [&](T* slot) {
+				::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+			});
+			++size_;
+		}
+		else
+		{
+			::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+			++size_;
+		}
+		return back();
+	}
+
+	/*
+	 * Append every argument, the variadic form of push_back. Capacity is
+	 * checked once, then ( construct(args), ... ) runs without branches.
+	 */
+	template<class... Args>
+	void append(Args&&... args)
+	{
+		static_assert((std::is_constructible_v<T, Args&&> && ...));
+
+		constexpr size_type count = sizeof...(Args);
+		if (size_ + count > capacity_)
+		{
+			reallocate(grow_to(size_ + count), count, [&](T* slot) {
+				construct_pack(slot, std::forward<Args>(args)...);
+			});
+		}
+		else
+		{
+			construct_pack(data_ + size_, std::forward<Args>(args)...);
+		}
+		size_ += count;
+	}
+
+	void pop_back() noexcept
+	{
+		--size_;
+		std::destroy_at(data_ + size_);
+	}
+
+	template<class... Args>
+	iterator emplace(const_iterator pos, Args&&... args)
+	{
+		const size_type index = static_cast<size_type>(pos - begin());
+		emplace_back(std::forward<Args>(args)...);
+		std::rotate(begin() + index, end() - 1, end());
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+
+	iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+	iterator insert(const_iterator pos, size_type count, const T& value)
+	{
+		const size_type index = static_cast<size_type>(pos - begin());
+		const size_type old_size = size_;
+		T copy(value);
+		reserve_for(size_ + count);
+		std::uninitialized_fill_n(data_ + size_, count, copy);
+		size_ += count;
+		std::rotate(begin() + index, begin() + old_size, end());
+		return begin() + index;
+	}
+
+	template<class It, class = typename std::iterator_traits<It>::iterator_category>
+	iterator insert(const_iterator pos, It first, It last)
+	{
+		const size_type index = static_cast<size_type>(pos - begin());
+		const size_type old_size = size_;
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<It>::iterator_category>)
+		{
+			reserve_for(size_ + static_cast<size_type>(std::distance(first, last)));
+		}
+		for (; first != last; ++first) emplace_back(*first);
+		std::rotate(begin() + index, begin() + old_size, end());
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator pos, std::initializer_list<T> il)
+	{
+		return insert(pos, il.begin(), il.end());
+	}
+
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		iterator f = begin() + (first - cbegin());
+		iterator l = begin() + (last - cbegin());
+		if (f != l)
+		{
+			iterator new_end = std::move(l, end(), f);
+			std::destroy(new_end, end());
+			size_ = static_cast<size_type>(new_end - begin());
+		}
+		return f;
+	}
+
+	void resize(size_type n)
+	{
+		if (n < size_)
+		{
+			erase(begin() + n, end());
+			return;
+		}
+		reserve_for(n);
+		std::uninitialized_value_construct_n(data_ + size_, n - size_);
+		size_ = n;
+	}
+
+	void resize(size_type n, const T& value)
+	{
+		if (n < size_)
+		{
+			erase(begin() + n, end());
+			return;
+		}
+		insert(end(), n - size_, value);
+	}
+
+	void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		small_vector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	friend void swap(small_vector& a, small_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+	friend bool operator==(const small_vector& a, const small_vector& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	friend auto operator<=>(const small_vector& a, const small_vector& b)
+	{
+		return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+private:
+	using alloc_type = std::allocator<T>;
+
+	T* inline_data() noexcept { return std::launder(reinterpret_cast<T*>(inline_)); }
+	const T* inline_data() const noexcept { return std::launder(reinterpret_cast<const T*>(inline_)); }
+
+	size_type grow_to(size_type required) const noexcept
+	{
+		return std::max(required, capacity_ * 2);
+	}
+
+	/* reserve() for the growing modifiers: geometric, so repeated small inserts stay amortised O(1) */
+	void reserve_for(size_type required)
+	{
+		if (required > capacity_) reserve(grow_to(required));
+	}
+
+	/*
+	 * Construct the arguments into consecutive slots. If one throws, the
+	 * ones already built are destroyed before the exception goes on, so
+	 * the caller only has to give the storage back.
+	 */
+	template<class... Args>
+	static void construct_pack(T* slot, Args&&... args)
+	{
+		size_type built = 0;
+		try
+		{
+			((::new (static_cast<void*>(slot + built)) T(std::forward<Args>(args)), ++built), ...);
+		}
+		catch (...)
+		{
+			std::destroy_n(slot, built);
+			throw;
+		}
+	}
+
+	/*
+	 * Move to a heap buffer of new_cap elements. fill constructs the
+	 * filled elements that go right after the current ones, it runs
+	 * before the old elements are moved so it may still read them.
+	 */
+	template<class Fill>
+	void reallocate(size_type new_cap, size_type filled, Fill fill)
+	{
+		alloc_type alloc;
+		T* fresh = alloc.allocate(new_cap);
+		try
+		{
+			fill(fresh + size_);
+		}
+		catch (...)
+		{
+			alloc.deallocate(fresh, new_cap);
+			throw;
+		}
+
+		if constexpr (relocation::is_trivially_relocatable_v<T>)
+		{
+			// one memcpy, and the old elements need no destructor calls
+			relocation::relocate(data_, data_ + size_, fresh);
+		}
+		else
+		{
+			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+			{
+				std::uninitialized_move_n(data_, size_, fresh);
+			}
+			else
+			{
+				try
+				{
+					std::uninitialized_copy_n(data_, size_, fresh);
+				}
+				catch (...)
+				{
+					std::destroy_n(fresh + size_, filled);
+					alloc.deallocate(fresh, new_cap);
+					throw;
+				}
+			}
+			std::destroy_n(data_, size_);
+		}
+
+		release();
+		data_ = fresh;
+		capacity_ = new_cap;
+	}
+
+	void release() noexcept
+	{
+		if (!is_inline()) alloc_type().deallocate(data_, capacity_);
+	}
+
+	/* *this is empty and inline */
+	void steal(small_vector&& other)
+	{
+		if (other.is_inline() && relocation::is_trivially_relocatable_v<T>)
+		{
+			relocation::relocate(other.data_, other.data_ + other.size_, data_);
+			size_ = other.size_;
+			other.size_ = 0;
+		}
+		else if (other.is_inline())
+		{
+			std::uninitialized_move_n(other.data_, other.size_, data_);
+			size_ = other.size_;
+			other.clear();
+		}
+		else
+		{
+			data_ = other.data_;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.data_ = other.inline_data();
+			other.size_ = 0;
+			other.capacity_ = N;
+		}
+	}
+
+	T* data_;
+	size_type size_;
+	size_type capacity_;
+	alignas(T) unsigned char inline_[sizeof(T) * N];
+};
+
+/* push_back_vec for small_vector, a single capacity check for the pack */
+template<class T, std::size_t N, class... Args>
+void push_back_vec(small_vector<T, N>& v, Args&&... args)
+{
+	v.append(std::forward<Args>(args)...);
+}
+
+} // small_vector_ns
+} // cxx17
+
+using cxx17::small_vector_ns::small_vector;
+
+} // pluto
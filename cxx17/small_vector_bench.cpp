@@ -0,0 +1,71 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 13:05:52
+ * @brief
+ */
+
+#include <vector>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "small_vector.h"
+#include "fold_expression.h"
+
+using namespace std;
+using namespace pluto::cxx17::small_vector_ns;
+
+/* build a list of range(0) elements and drop it again */
+template<class Vec>
+static void BM_Churn(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vec v;
+		for (int i = 0; i < n; ++i) v.push_back(i);
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<class Vec>
+static void BM_Churn_String(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vec v;
+		for (int i = 0; i < n; ++i) v.emplace_back("x");
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_PushBackVec_Vector(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		vector<int> v;
+		pluto::cxx17::fold_expression::push_back_vec(v, 6, 2, 45, 12, 7, 9);
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+static void BM_PushBackVec_SmallVector(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		small_vector<int, 8> v;
+		push_back_vec(v, 6, 2, 45, 12, 7, 9);
+		benchmark::DoNotOptimize(v.data());
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_Churn, vector<int>)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(BM_Churn, small_vector<int, 8>)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(BM_Churn, small_vector<int, 32>)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(BM_Churn_String, vector<string>)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(BM_Churn_String, small_vector<string, 8>)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(BM_PushBackVec_Vector);
+BENCHMARK(BM_PushBackVec_SmallVector);
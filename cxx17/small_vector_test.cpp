@@ -0,0 +1,163 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 13:05:52
+ * @brief
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "small_vector.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::small_vector_ns;
+
+namespace
+{
+
+/* counts live objects, constructing from 0 throws */
+struct counted
+{
+	static inline int live = 0;
+
+	int value;
+
+	counted(int v) : value(v)
+	{
+		if (v == 0) throw std::runtime_error("zero");
+		++live;
+	}
+	counted(const counted& other) : value(other.value) { ++live; }
+	~counted() { --live; }
+};
+
+} // namespace
+
+TEST(PLUTO, CXX17_SMALL_VECTOR) {
+
+	{
+		small_vector<int, 8> v;
+		push_back_vec(v, 6, 2, 45, 12);
+		EXPECT_TRUE(v.is_inline());
+		EXPECT_EQ(4u, v.size());
+		TEST_COUT;
+		for (int i : v) cout << i << ' ';   //6 2 45 12
+		cout << endl;
+
+		// the 9th element spills to the heap
+		push_back_vec(v, 1, 2, 3, 4, 5);
+		EXPECT_FALSE(v.is_inline());
+		EXPECT_EQ((small_vector<int, 8>{ 6, 2, 45, 12, 1, 2, 3, 4, 5 }), v);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		small_vector<string, 2> v{ "a", "b" };
+
+		// the argument refers into v while v reallocates
+		v.push_back(v[0]);
+		v.append(v[1], "d", string("e"));
+		EXPECT_EQ((small_vector<string, 2>{ "a", "b", "a", "b", "d", "e" }), v);
+
+		v.insert(v.begin() + 1, "x");
+		v.erase(v.begin() + 3, v.begin() + 5);
+		EXPECT_EQ((small_vector<string, 2>{ "a", "x", "b", "d", "e" }), v);
+
+		v.insert(v.begin(), 2, "y");
+		vector<string> tail{ "1", "2" };
+		v.insert(v.end(), tail.begin(), tail.end());
+		EXPECT_EQ((small_vector<string, 2>{ "y", "y", "a", "x", "b", "d", "e", "1", "2" }), v);
+
+		v.resize(3);
+		EXPECT_EQ((small_vector<string, 2>{ "y", "y", "a" }), v);
+		v.resize(4, "z");
+		EXPECT_EQ("z", v.back());
+		EXPECT_THROW(v.at(4), std::out_of_range);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// insert and resize grow like emplace_back, a few reallocations for many small steps
+		small_vector<int, 4> v;
+		const int one[] = { 1 };
+		size_t reallocations = 0;
+		size_t capacity = v.capacity();
+		for (int i = 0; i < 3000; ++i)
+		{
+			if (i % 3 == 0) v.insert(v.end(), 1, i);
+			else if (i % 3 == 1) v.insert(v.begin(), begin(one), end(one));
+			else v.resize(v.size() + 1);
+			if (v.capacity() != capacity) ++reallocations;
+			capacity = v.capacity();
+		}
+		EXPECT_EQ(3000u, v.size());
+		EXPECT_LE(reallocations, 12u);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// copy and move, both inline and on the heap
+		small_vector<string, 4> small{ "a", "b" };
+		small_vector<string, 4> big{ "a", "b", "c", "d", "e" };
+
+		auto small_copy = small;
+		auto big_copy = big;
+		EXPECT_EQ(small, small_copy);
+		EXPECT_EQ(big, big_copy);
+
+		const string* heap = big.data();
+		auto moved = std::move(big);
+		EXPECT_EQ(heap, moved.data());
+		EXPECT_TRUE(big.empty());
+
+		swap(moved, small_copy);
+		EXPECT_EQ(5u, small_copy.size());
+		EXPECT_EQ(2u, moved.size());
+		EXPECT_TRUE(moved < small_copy); // "a" "b" < "a" "b" "c" ...
+
+		small_copy.resize(2);
+		small_copy.shrink_to_fit();
+		EXPECT_TRUE(small_copy.is_inline());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// move-only elements
+		small_vector<unique_ptr<int>, 1> v;
+		v.push_back(make_unique<int>(1));
+		v.emplace_back(new int(2));
+		v.emplace(v.begin(), new int(0));
+		EXPECT_EQ(0, *v[0]);
+		EXPECT_EQ(2, *v.back());
+		v.pop_back();
+		EXPECT_EQ(2u, v.size());
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// a throwing element in append leaves nothing behind, inline or while reallocating
+		small_vector<counted, 4> v{ 1, 2 };
+		EXPECT_THROW(v.append(3, 0), std::runtime_error);
+		EXPECT_EQ(2u, v.size());
+		EXPECT_EQ(2, counted::live);
+		EXPECT_THROW(v.append(3, 4, 5, 0), std::runtime_error);
+		EXPECT_EQ(2u, v.size());
+		EXPECT_TRUE(v.is_inline());
+		EXPECT_EQ(2, counted::live);
+		v.append(3, 4, 5);
+		EXPECT_EQ(5u, v.size());
+		EXPECT_EQ(5, counted::live);
+	}
+	EXPECT_EQ(0, counted::live);
+}
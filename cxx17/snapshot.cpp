@@ -0,0 +1,29 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:12:36
+ * @brief
+ */
+
+#include "snapshot.h"
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace snapshot
+{
+namespace detail
+{
+
+std::size_t reader_stripe() noexcept
+{
+	static std::atomic<std::size_t> next{ 0 };
+	thread_local const std::size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % reader_stripes;
+	return stripe;
+}
+
+} // detail
+} // snapshot
+} // cxx17
+} // pluto
@@ -0,0 +1,354 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:12:36
+ * @brief
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace snapshot
+{
+
+/*
+ * Read-mostly values published by a writer to many reader threads,
+ * e.g. a configuration tuple or a student's score record:
+ *
+ *		atomic_snapshot<std::tuple<int, double, char>> score;
+ *
+ *		score.store({ 1001, 92.5, 'A' });		// writer
+ *		auto [id, points, grade] = score.load();	// any reader
+ *
+ * atomic_snapshot is a seqlock. The writer makes the sequence number
+ * odd, writes the value and makes it even again; a reader copies the
+ * value between two reads of the sequence number and retries if they
+ * differ or are odd. Readers never write to shared memory, so they do
+ * not bounce a cache line between each other the way a std::mutex, a
+ * std::shared_mutex or the reference count of std::atomic<std::shared_ptr>
+ * does, and reads scale with the number of cores. A reader only
+ * retries while a store overlaps it. Stores are serialised by the
+ * sequence number itself.
+ *
+ * The value is copied byte by byte with relaxed atomic loads, so T must
+ * be copyable as bytes: trivially copy constructible and trivially
+ * destructible. That admits std::tuple, std::pair and std::optional of
+ * scalars, which are not trivially copyable (their assignment is user
+ * provided) but whose copy constructor is.
+ *
+ * rcu_snapshot is for everything else, std::string and friends. It
+ * keeps two copies of the value: readers pin the current one and read
+ * it in place, the writer builds the next value in the other buffer
+ * once the last reader of that buffer has left, then flips the index.
+ * Readers announce themselves on one of several counters picked by
+ * thread, so they rarely share a cache line; the writer waits, not the
+ * readers. A reader that keeps a read_guard alive holds back the second
+ * store after the one that retired its buffer, so keep guards short.
+ */
+
+inline constexpr std::size_t cache_line = 64;
+
+template<class T>
+struct is_bitwise_copyable : std::bool_constant<std::is_trivially_copy_constructible_v<T> &&
+	std::is_trivially_destructible_v<T>> {};
+
+template<class T>
+inline constexpr bool is_bitwise_copyable_v = is_bitwise_copyable<T>::value;
+
+template<class T>
+class atomic_snapshot
+{
+	static_assert(is_bitwise_copyable_v<T>, "atomic_snapshot<T> copies T as bytes, use rcu_snapshot<T>");
+	static_assert(alignof(T) <= alignof(std::uint64_t), "over-aligned T is not supported");
+
+	static constexpr std::size_t words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+public:
+	atomic_snapshot() noexcept(std::is_nothrow_default_constructible_v<T>) : atomic_snapshot(T{}) {}
+
+	explicit atomic_snapshot(const T& value) noexcept
+	{
+		write(value);
+	}
+
+	atomic_snapshot(const atomic_snapshot&) = delete;
+	atomic_snapshot& operator=(const atomic_snapshot&) = delete;
+
+	/* a consistent copy of the value last stored */
+	T load() const noexcept
+	{
+		for (;;)
+		{
+			if (auto value = try_load()) return *value;
+			std::this_thread::yield();
+		}
+	}
+
+	/* one attempt, nullopt when it raced with a store */
+	std::optional<T> try_load() const noexcept
+	{
+		alignas(T) std::uint64_t copy[words];
+		const std::uint64_t before = seq_.load(std::memory_order_acquire);
+		if (before & 1) return std::nullopt;
+		for (std::size_t i = 0; i < words; ++i)
+		{
+			copy[i] = data_[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (seq_.load(std::memory_order_relaxed) != before) return std::nullopt;
+		return *std::launder(reinterpret_cast<const T*>(copy));
+	}
+
+	void store(const T& value) noexcept
+	{
+		lock();
+		write(value);
+		unlock();
+	}
+
+	/* store f(old value), atomically with respect to other stores */
+	template<class F>
+	void update(F&& f)
+	{
+		lock();
+		try
+		{
+			const T value = std::forward<F>(f)(current());
+			write(value);
+		}
+		catch (...)
+		{
+			unlock();
+			throw;
+		}
+		unlock();
+	}
+
+	/* number of stores finished so far, cheap for a reader to poll for changes */
+	std::uint64_t version() const noexcept
+	{
+		return seq_.load(std::memory_order_acquire) / 2;
+	}
+
+private:
+	/* writers take the lock by moving the sequence number from even to odd */
+	void lock() noexcept
+	{
+		std::uint64_t s = seq_.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			if ((s & 1) == 0 && seq_.compare_exchange_weak(s, s + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+			std::this_thread::yield();
+			s = seq_.load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	void unlock() noexcept
+	{
+		seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/* only called with the lock held, nobody else writes */
+	T current() const noexcept
+	{
+		alignas(T) std::uint64_t copy[words];
+		for (std::size_t i = 0; i < words; ++i)
+		{
+			copy[i] = data_[i].load(std::memory_order_relaxed);
+		}
+		return *std::launder(reinterpret_cast<const T*>(copy));
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// the payload of an empty std::optional is copied along, uninitialised and unread
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+	void write(const T& value) noexcept
+	{
+		std::uint64_t copy[words] = {};
+		std::memcpy(copy, std::addressof(value), sizeof(T));
+		for (std::size_t i = 0; i < words; ++i)
+		{
+			data_[i].store(copy[i], std::memory_order_relaxed);
+		}
+	}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+	alignas(cache_line) std::atomic<std::uint64_t> seq_{ 0 };
+	alignas(cache_line) std::atomic<std::uint64_t> data_[words];
+};
+
+namespace detail
+{
+
+inline constexpr std::size_t reader_stripes = 16;
+
+/* spreads threads over the stripes, assigned once per thread */
+std::size_t reader_stripe() noexcept;
+
+struct alignas(cache_line) reader_count
+{
+	std::atomic<std::uint32_t> n{ 0 };
+};
+
+} // detail
+
+template<class T>
+class rcu_snapshot
+{
+	struct buffer
+	{
+		detail::reader_count readers[detail::reader_stripes];
+		std::optional<T> value;
+
+		bool idle() const noexcept
+		{
+			for (const auto& r : readers)
+			{
+				if (r.n.load(std::memory_order_seq_cst) != 0) return false;
+			}
+			return true;
+		}
+	};
+
+public:
+	/* pins the buffer it points into, the value stays put while it lives */
+	class read_guard
+	{
+	public:
+		read_guard(read_guard&& other) noexcept : count_(std::exchange(other.count_, nullptr)), value_(other.value_) {}
+		read_guard(const read_guard&) = delete;
+		read_guard& operator=(const read_guard&) = delete;
+
+		~read_guard()
+		{
+			if (count_ != nullptr) count_->fetch_sub(1, std::memory_order_release);
+		}
+
+		const T& operator*() const noexcept { return *value_; }
+		const T* operator->() const noexcept { return value_; }
+
+	private:
+		friend class rcu_snapshot;
+
+		read_guard(std::atomic<std::uint32_t>* count, const T* value) noexcept : count_(count), value_(value) {}
+
+		std::atomic<std::uint32_t>* count_;
+		const T* value_;
+	};
+
+	rcu_snapshot() : rcu_snapshot(T{}) {}
+
+	explicit rcu_snapshot(T value)
+	{
+		buffers_[0].value.emplace(std::move(value));
+	}
+
+	rcu_snapshot(const rcu_snapshot&) = delete;
+	rcu_snapshot& operator=(const rcu_snapshot&) = delete;
+
+	read_guard read() const noexcept
+	{
+		const std::size_t stripe = detail::reader_stripe();
+		for (;;)
+		{
+			const unsigned i = current_.load(std::memory_order_seq_cst);
+			auto& count = buffers_[i].readers[stripe].n;
+			count.fetch_add(1, std::memory_order_seq_cst);
+			/*
+			 * the writer may have started on this buffer between the two
+			 * loads, it checked for readers before our increment, so the
+			 * index has moved on and we try again on the other buffer
+			 */
+			if (current_.load(std::memory_order_seq_cst) == i)
+			{
+				return read_guard(&count, &*buffers_[i].value);
+			}
+			count.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	/* calls f on the current value in place, returns what f returns */
+	template<class F>
+	decltype(auto) read(F&& f) const
+	{
+		const read_guard guard = read();
+		return std::forward<F>(f)(*guard);
+	}
+
+	T load() const
+	{
+		return *read();
+	}
+
+	void store(T value)
+	{
+		std::lock_guard<std::mutex> lock(writer_);
+		publish(std::move(value));
+	}
+
+	/* builds the new value in the spare buffer, no temporary to move from */
+	template<class... Args>
+	void emplace(Args&&... args)
+	{
+		std::lock_guard<std::mutex> lock(writer_);
+		publish(std::forward<Args>(args)...);
+	}
+
+	/* store f(old value), atomically with respect to other stores */
+	template<class F>
+	void update(F&& f)
+	{
+		std::lock_guard<std::mutex> lock(writer_);
+		const unsigned i = current_.load(std::memory_order_relaxed);
+		publish(std::forward<F>(f)(std::as_const(*buffers_[i].value)));
+	}
+
+	std::uint64_t version() const noexcept
+	{
+		return version_.load(std::memory_order_acquire);
+	}
+
+private:
+	template<class... Args>
+	void publish(Args&&... args)
+	{
+		const unsigned next = current_.load(std::memory_order_relaxed) ^ 1u;
+		buffer& b = buffers_[next];
+		while (!b.idle()) std::this_thread::yield();
+		b.value.reset();
+		b.value.emplace(std::forward<Args>(args)...);
+		version_.fetch_add(1, std::memory_order_relaxed);
+		current_.store(next, std::memory_order_seq_cst);
+	}
+
+	mutable buffer buffers_[2];
+	alignas(cache_line) std::atomic<unsigned> current_{ 0 };
+	std::atomic<std::uint64_t> version_{ 0 };
+	std::mutex writer_;
+};
+
+} // snapshot
+} // cxx17
+} // pluto
@@ -0,0 +1,115 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:50:18
+ * @brief
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
+#include <benchmark/benchmark.h>
+
+#include "snapshot.h"
+
+using namespace std;
+using namespace pluto::cxx17::snapshot;
+
+namespace
+{
+
+using score = tuple<uint32_t, double, uint64_t>;
+
+/* benchmark thread 0 stores once every this many reads, the rest only read */
+constexpr int store_every = 1024;
+
+/* the reference: the value behind a std::shared_mutex */
+template<class T>
+class locked_value
+{
+public:
+	explicit locked_value(T value) : value_(std::move(value)) {}
+
+	T load() const
+	{
+		shared_lock<shared_mutex> lock(mutex_);
+		return value_;
+	}
+
+	template<class F>
+	decltype(auto) read(F&& f) const
+	{
+		shared_lock<shared_mutex> lock(mutex_);
+		return std::forward<F>(f)(value_);
+	}
+
+	void store(T value)
+	{
+		unique_lock<shared_mutex> lock(mutex_);
+		value_ = std::move(value);
+	}
+
+private:
+	mutable shared_mutex mutex_;
+	T value_;
+};
+
+const string config_text(48, 'c');
+
+template<class Value>
+void read_scores(benchmark::State& state, Value& v)
+{
+	uint32_t i = 0;
+	for (auto _ : state)
+	{
+		if (state.thread_index() == 0 && ++i % store_every == 0) v.store(score{ i, i * 0.5, i });
+		benchmark::DoNotOptimize(v.load());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* reads the string in place, the usual way to look at a config value */
+template<class Value>
+void read_config(benchmark::State& state, Value& v)
+{
+	int i = 0;
+	for (auto _ : state)
+	{
+		if (state.thread_index() == 0 && ++i % store_every == 0) v.store(config_text);
+		benchmark::DoNotOptimize(v.read([](const string& s) { return s.size(); }));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void BM_SeqlockScoreRead(benchmark::State& state)
+{
+	static atomic_snapshot<score> v;
+	read_scores(state, v);
+}
+
+static void BM_SharedMutexScoreRead(benchmark::State& state)
+{
+	static locked_value<score> v{ score{} };
+	read_scores(state, v);
+}
+
+static void BM_RcuConfigRead(benchmark::State& state)
+{
+	static rcu_snapshot<string> v{ config_text };
+	read_config(state, v);
+}
+
+static void BM_SharedMutexConfigRead(benchmark::State& state)
+{
+	static locked_value<string> v{ config_text };
+	read_config(state, v);
+}
+
+BENCHMARK(BM_SeqlockScoreRead)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_SharedMutexScoreRead)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_RcuConfigRead)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_SharedMutexConfigRead)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,183 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 04:31:52
+ * @brief
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "snapshot.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::snapshot;
+
+namespace
+{
+
+/* id, score and a checksum of the two, a torn read breaks the checksum */
+using score = tuple<uint32_t, double, uint64_t>;
+
+score make_score(uint32_t i)
+{
+	const double points = i * 0.5;
+	return { i, points, i * 2654435761u + static_cast<uint64_t>(points * 2) };
+}
+
+bool consistent(const score& s)
+{
+	const auto& [id, points, check] = s;
+	return check == id * 2654435761u + static_cast<uint64_t>(points * 2);
+}
+
+/* a run of one repeated letter, as long as the letter's offset from 'a' plus one */
+string make_text(int i)
+{
+	const char c = static_cast<char>('a' + i % 26);
+	return string(static_cast<size_t>(c - 'a' + 1) * 8, c);
+}
+
+bool consistent(const string& s)
+{
+	return !s.empty() && s.size() == static_cast<size_t>(s[0] - 'a' + 1) * 8 &&
+		s.find_first_not_of(s[0]) == string::npos;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX17_SNAPSHOT) {
+
+	static_assert(is_bitwise_copyable_v<score>);
+	static_assert(is_bitwise_copyable_v<optional<pair<int, float>>>);
+	static_assert(!is_bitwise_copyable_v<string>);
+
+	/* seqlock, one thread */
+	{
+		atomic_snapshot<score> s;
+		EXPECT_EQ(s.load(), score{});
+		EXPECT_EQ(s.version(), 0u);
+
+		s.store(make_score(7));
+		EXPECT_EQ(s.load(), make_score(7));
+		EXPECT_EQ(s.version(), 1u);
+
+		s.update([](score old) { return make_score(get<0>(old) + 1); });
+		EXPECT_EQ(get<0>(s.load()), 8u);
+		EXPECT_EQ(s.version(), 2u);
+
+		EXPECT_THROW(s.update([](const score&) -> score { throw 1; }), int);
+		EXPECT_EQ(get<0>(s.load()), 8u);
+		EXPECT_TRUE(s.try_load().has_value());
+
+		atomic_snapshot<optional<pair<int, float>>> o;
+		EXPECT_FALSE(o.load().has_value());
+		o.store(pair{ 3, 1.5f });
+		EXPECT_EQ(o.load(), (pair{ 3, 1.5f }));
+		o.store(nullopt);
+		EXPECT_FALSE(o.load().has_value());
+	}
+
+	/* seqlock, readers never see a torn value while two writers store */
+	{
+		atomic_snapshot<score> s(make_score(0));
+		atomic<bool> stop{ false };
+		atomic<int> torn{ 0 };
+		atomic<long> reads{ 0 };
+
+		vector<thread> readers;
+		for (int r = 0; r < 4; ++r)
+		{
+			readers.emplace_back([&] {
+				while (!stop.load(memory_order_relaxed))
+				{
+					const score v = s.load();
+					if (!consistent(v)) ++torn;
+					reads.fetch_add(1, memory_order_relaxed);
+					this_thread::yield();
+				}
+			});
+		}
+		vector<thread> writers;
+		for (uint32_t w = 0; w < 2; ++w)
+		{
+			writers.emplace_back([&, w] {
+				for (uint32_t i = 0; i < 20000; ++i)
+				{
+					s.store(make_score(i * 2 + w));
+					if (i % 64 == 0) this_thread::yield();
+				}
+			});
+		}
+		for (auto& t : writers) t.join();
+		stop = true;
+		for (auto& t : readers) t.join();
+
+		EXPECT_EQ(torn.load(), 0);
+		EXPECT_EQ(s.version(), 40000u);
+		TEST_COUT << "seqlock reads while storing: " << reads.load() << endl;
+	}
+
+	/* rcu, one thread */
+	{
+		rcu_snapshot<string> s("config v1");
+		EXPECT_EQ(s.load(), "config v1");
+		EXPECT_EQ(s.read([](const string& v) { return v.size(); }), 9u);
+
+		{
+			auto guard = s.read();
+			s.store("config v2");
+			/* the guard pins the old buffer, the store went to the other one */
+			EXPECT_EQ(*guard, "config v1");
+			EXPECT_EQ(s.load(), "config v2");
+		}
+		s.emplace(5, 'x');
+		EXPECT_EQ(s.load(), "xxxxx");
+		s.update([](const string& old) { return old + "y"; });
+		EXPECT_EQ(s.load(), "xxxxxy");
+		EXPECT_EQ(s.version(), 3u);
+
+		rcu_snapshot<vector<int>> v;
+		EXPECT_TRUE(v.load().empty());
+		v.store({ 1, 2, 3 });
+		EXPECT_EQ(v.read()->size(), 3u);
+	}
+
+	/* rcu, readers always see a whole string while a writer replaces it */
+	{
+		rcu_snapshot<string> s(make_text(0));
+		atomic<bool> stop{ false };
+		atomic<int> torn{ 0 };
+
+		vector<thread> readers;
+		for (int r = 0; r < 4; ++r)
+		{
+			readers.emplace_back([&] {
+				while (!stop.load(memory_order_relaxed))
+				{
+					if (!s.read([](const string& v) { return consistent(v); })) ++torn;
+					if (!consistent(s.load())) ++torn;
+					this_thread::yield();
+				}
+			});
+		}
+		for (int i = 1; i <= 20000; ++i)
+		{
+			s.store(make_text(i));
+			if (i % 64 == 0) this_thread::yield();
+		}
+		stop = true;
+		for (auto& t : readers) t.join();
+
+		EXPECT_EQ(torn.load(), 0);
+		EXPECT_EQ(s.load(), make_text(20000));
+	}
+}
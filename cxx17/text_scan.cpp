@@ -0,0 +1,362 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 06:14:03
+ * @brief
+ */
+
+#include "text_scan.h"
+
+#include <charconv>
+#include <limits>
+
+#if PLUTO_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace text_scan
+{
+
+namespace
+{
+
+enum class kind
+{
+	digit,
+	non_digit,
+	set,
+};
+
+struct query
+{
+	const byte_set* set;
+};
+
+namespace scalar
+{
+
+inline bool is_digit(char c)
+{
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+template<kind K>
+bool hit(char c, const query& q)
+{
+	if constexpr (K == kind::digit) return is_digit(c);
+	if constexpr (K == kind::non_digit) return !is_digit(c);
+	if constexpr (K == kind::set) return q.set->contains(c);
+}
+
+template<kind K>
+std::size_t find(const char* p, std::size_t n, const query& q)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (hit<K>(p[i], q)) return i;
+	}
+	return n;
+}
+
+/* last digit of the first run ending in an odd (odd = 1) or even (odd = 0) digit, from on */
+std::size_t find_number_end(const char* p, std::size_t n, std::size_t from, unsigned odd)
+{
+	for (std::size_t i = from; i < n; ++i)
+	{
+		if (is_digit(p[i]) && (i + 1 == n || !is_digit(p[i + 1])) && (static_cast<unsigned>(p[i]) & 1) == odd)
+		{
+			return i;
+		}
+	}
+	return n;
+}
+
+} // scalar
+
+#if PLUTO_SIMD_X86
+
+/*
+ * The scanners are the same for every instruction set, only the block
+ * width and the classify primitives differ: each returns one bit per
+ * byte of the block, bit i for byte i. Each ISA namespace defines the
+ * primitives and then stamps out the scanners.
+ *
+ * find() reads two blocks per iteration, then finishes with one block
+ * that ends at the last byte and overlaps what was already scanned,
+ * dropping the bits of the overlap, so there is no byte-by-byte tail.
+ *
+ * find_number_end() classifies the block and the block one byte on,
+ * which says for every byte whether the next one is a digit, and keeps
+ * the digits that end a run and have the wanted parity; '0' is even,
+ * so the parity of a digit is that of its byte.
+ */
+#define PLUTO_TEXT_SCANNERS(TARGET)																\
+template<kind K>																				\
+TARGET std::uint32_t match(vec v, const query& q)												\
+{																								\
+	if constexpr (K == kind::digit) return digits(v);											\
+	if constexpr (K == kind::non_digit) return ~digits(v) & full_mask;							\
+	if constexpr (K == kind::set) return in_set(v, *q.set);										\
+}																								\
+																								\
+template<kind K>																				\
+TARGET std::size_t find(const char* p, std::size_t n, const query& q)							\
+{																								\
+	if (n < width) return scalar::find<K>(p, n, q);												\
+	std::size_t i = 0;																			\
+	for (; i + 2 * width <= n; i += 2 * width)													\
+	{																							\
+		const std::uint64_t m = match<K>(load(p + i), q) |										\
+			static_cast<std::uint64_t>(match<K>(load(p + i + width), q)) << width;				\
+		if (m != 0) return i + static_cast<std::size_t>(__builtin_ctzll(m));					\
+	}																							\
+	if (i == n) return n;																		\
+	if (i + width <= n)																			\
+	{																							\
+		const std::uint32_t m = match<K>(load(p + i), q);										\
+		if (m != 0) return i + static_cast<std::size_t>(__builtin_ctz(m));						\
+		i += width;																				\
+		if (i == n) return n;																	\
+	}																							\
+	const std::uint32_t m = match<K>(load(p + n - width), q) >> (width - (n - i));				\
+	return m != 0 ? i + static_cast<std::size_t>(__builtin_ctz(m)) : n;							\
+}																								\
+																								\
+TARGET std::size_t find_number_end(const char* p, std::size_t n, unsigned odd)					\
+{																								\
+	std::size_t i = 0;																			\
+	for (; i + width + 1 <= n; i += width)														\
+	{																							\
+		const vec v = load(p + i);																\
+		const std::uint32_t ends = digits(v) & ~digits(load(p + i + 1)) & parity(v, odd);		\
+		if (ends != 0) return i + static_cast<std::size_t>(__builtin_ctz(ends));				\
+	}																							\
+	return scalar::find_number_end(p, n, i, odd);												\
+}
+
+namespace sse42
+{
+
+#define PLUTO_SSE42 __attribute__((target("sse4.2"))) inline
+
+using vec = __m128i;
+constexpr std::size_t width = 16;
+constexpr std::uint32_t full_mask = 0xffff;
+
+PLUTO_SSE42 vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+PLUTO_SSE42 std::uint32_t bits(vec v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+
+/* c - '0' <= 9 unsigned, as min(c - '0', 9) == c - '0' */
+PLUTO_SSE42 std::uint32_t digits(vec v)
+{
+	const vec t = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+	return bits(_mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(9)), t));
+}
+
+PLUTO_SSE42 std::uint32_t parity(vec v, unsigned odd)
+{
+	const vec one = _mm_set1_epi8(1);
+	return bits(_mm_cmpeq_epi8(_mm_and_si128(v, one), odd ? one : _mm_setzero_si128()));
+}
+
+/* the row by the low nibble (high_rows when the sign bit is set), the bit by the high nibble */
+PLUTO_SSE42 std::uint32_t in_set(vec v, const byte_set& s)
+{
+	const vec low_nibble = _mm_and_si128(v, _mm_set1_epi8(0x0f));
+	const vec high_nibble = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+	const vec rows = _mm_blendv_epi8(
+		_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.low_rows())), low_nibble),
+		_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.high_rows())), low_nibble),
+		v);
+	const vec bit = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128), high_nibble);
+	return ~bits(_mm_cmpeq_epi8(_mm_and_si128(rows, bit), _mm_setzero_si128())) & full_mask;
+}
+
+PLUTO_TEXT_SCANNERS(PLUTO_SSE42)
+
+#undef PLUTO_SSE42
+
+} // sse42
+
+namespace avx2
+{
+
+#define PLUTO_AVX2 __attribute__((target("avx2"))) inline
+
+using vec = __m256i;
+constexpr std::size_t width = 32;
+constexpr std::uint32_t full_mask = 0xffffffff;
+
+PLUTO_AVX2 vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+PLUTO_AVX2 std::uint32_t bits(vec v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+
+PLUTO_AVX2 std::uint32_t digits(vec v)
+{
+	const vec t = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+	return bits(_mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(9)), t));
+}
+
+PLUTO_AVX2 std::uint32_t parity(vec v, unsigned odd)
+{
+	const vec one = _mm256_set1_epi8(1);
+	return bits(_mm256_cmpeq_epi8(_mm256_and_si256(v, one), odd ? one : _mm256_setzero_si256()));
+}
+
+/* vpshufb looks up within each 128-bit lane, so the tables are in both lanes */
+PLUTO_AVX2 std::uint32_t in_set(vec v, const byte_set& s)
+{
+	const vec low_nibble = _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+	const vec high_nibble = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+	const vec rows = _mm256_blendv_epi8(
+		_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.low_rows()))), low_nibble),
+		_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.high_rows()))), low_nibble),
+		v);
+	const vec bit = _mm256_shuffle_epi8(_mm256_setr_epi8(
+		1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+		1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128), high_nibble);
+	return ~bits(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), _mm256_setzero_si256()));
+}
+
+PLUTO_TEXT_SCANNERS(PLUTO_AVX2)
+
+#undef PLUTO_AVX2
+
+} // avx2
+
+#undef PLUTO_TEXT_SCANNERS
+
+#endif // PLUTO_SIMD_X86
+
+cpu::isa_dispatch& dispatch()
+{
+	static cpu::isa_dispatch scanners{ isa::sse42, isa::avx2 };
+	return scanners;
+}
+
+template<kind K>
+std::size_t run_find(std::string_view text, const query& q)
+{
+#if PLUTO_SIMD_X86
+	switch (active_isa())
+	{
+	case isa::avx2: return avx2::find<K>(text.data(), text.size(), q);
+	case isa::sse42: return sse42::find<K>(text.data(), text.size(), q);
+	default: break;
+	}
+#endif
+	return scalar::find<K>(text.data(), text.size(), q);
+}
+
+std::size_t run_find_number_end(std::string_view text, unsigned odd)
+{
+#if PLUTO_SIMD_X86
+	switch (active_isa())
+	{
+	case isa::avx2: return avx2::find_number_end(text.data(), text.size(), odd);
+	case isa::sse42: return sse42::find_number_end(text.data(), text.size(), odd);
+	default: break;
+	}
+#endif
+	return scalar::find_number_end(text.data(), text.size(), 0, odd);
+}
+
+std::optional<std::size_t> found(std::size_t i, std::string_view text)
+{
+	if (i == text.size()) return std::nullopt;
+	return i;
+}
+
+/* the number ending at end, its digits go back to the previous non-digit */
+number_ref number_ending_at(std::string_view text, std::size_t end)
+{
+	std::size_t begin = end;
+	while (begin > 0 && scalar::is_digit(text[begin - 1])) --begin;
+	return { begin, text.substr(begin, end + 1 - begin) };
+}
+
+std::optional<number_ref> find_number_by_parity(std::string_view text, unsigned odd)
+{
+	const std::size_t end = run_find_number_end(text, odd);
+	if (end == text.size()) return std::nullopt;
+	return number_ending_at(text, end);
+}
+
+} // namespace
+
+isa detected_isa()
+{
+	return dispatch().detected();
+}
+
+isa active_isa()
+{
+	return dispatch().active();
+}
+
+isa set_isa(isa requested)
+{
+	return dispatch().set(requested);
+}
+
+std::optional<std::uint64_t> number_ref::value() const noexcept
+{
+	std::uint64_t v = 0;
+	const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), v);
+	if (error != std::errc() || end != digits.data() + digits.size()) return std::nullopt;
+	return v;
+}
+
+std::optional<std::size_t> find_digit(std::string_view text) noexcept
+{
+	return found(run_find<kind::digit>(text, {}), text);
+}
+
+std::optional<std::size_t> find_byte(std::string_view text, char c) noexcept
+{
+	const std::size_t i = text.find(c);
+	if (i == std::string_view::npos) return std::nullopt;
+	return i;
+}
+
+std::optional<std::size_t> find_first_of(std::string_view text, const byte_set& set) noexcept
+{
+	return found(run_find<kind::set>(text, { &set }), text);
+}
+
+std::optional<number_ref> find_number(std::string_view text) noexcept
+{
+	const auto begin = find_digit(text);
+	if (!begin) return std::nullopt;
+	const std::string_view rest = text.substr(*begin);
+	const std::size_t length = run_find<kind::non_digit>(rest, {});
+	return number_ref{ *begin, rest.substr(0, length) };
+}
+
+std::optional<number_ref> find_even_number(std::string_view text) noexcept
+{
+	return find_number_by_parity(text, 0);
+}
+
+std::optional<number_ref> find_odd_number(std::string_view text) noexcept
+{
+	return find_number_by_parity(text, 1);
+}
+
+std::optional<unsigned> first_even_number_in(std::string_view text) noexcept
+{
+	const auto number = find_even_number(text);
+	if (!number) return std::nullopt;
+	const auto value = number->value();
+	if (!value || *value > std::numeric_limits<unsigned>::max()) return std::nullopt;
+	return static_cast<unsigned>(*value);
+}
+
+} // text_scan
+} // cxx17
+} // pluto
@@ -0,0 +1,132 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 06:14:03
+ * @brief
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "common/cpu_isa.h"
+
+namespace pluto
+{
+namespace cxx17
+{
+namespace text_scan
+{
+
+/*
+ * Scanners over log text that answer "where is the first ...", the
+ * firstEvenNumberIn(text) of optional.h, without a magic npos:
+ *
+ *		std::optional<unsigned> n = first_even_number_in("took 17 ms, 42 rows");	// 42
+ *
+ *		if (auto eol = find_newline(buffer)) line = buffer.substr(0, *eol);
+ *
+ *		static constexpr byte_set separators(" \t,;=");
+ *		auto end = find_first_of(field, separators);
+ *
+ * A "number" is a maximal run of ASCII digits, "17" and "42" above; it
+ * is even or odd by its last digit, so the even/odd scanners never
+ * look at the value and work for runs of any length.
+ *
+ * The scanners classify 32 bytes at a time with AVX2 or 16 with SSE4.2,
+ * chosen at run time from what the CPU supports, with a plain loop
+ * everywhere else. A byte_set of any size, up to all 256 byte values,
+ * is matched with two table lookups per block: one on the low nibble
+ * for the row of the set, one on the high nibble for the bit in it.
+ * Results do not depend on the instruction set, the tests compare
+ * every path with the loop on random text.
+ *
+ * find_byte() and find_newline() are string_view::find, i.e. memchr,
+ * which the C library already vectorizes better than a scanner of ours.
+ */
+
+/* scalar, sse42 or avx2, see common/cpu_isa.h */
+using cpu::isa;
+using cpu::isa_name;
+
+/* best instruction set available on this CPU */
+isa detected_isa();
+
+/* instruction set the scanners currently use */
+isa active_isa();
+
+/*
+ * Restrict the scanners to an instruction set, e.g. to compare paths in
+ * tests. Requests above detected_isa() are clamped. Returns the new
+ * active_isa().
+ */
+isa set_isa(isa requested);
+
+/* a set of byte values, kept as the two nibble tables the vector code looks up */
+class byte_set
+{
+public:
+	constexpr byte_set() = default;
+
+	constexpr explicit byte_set(std::string_view members)
+	{
+		for (char c : members) insert(c);
+	}
+
+	constexpr void insert(char c)
+	{
+		const auto b = static_cast<unsigned char>(c);
+		(b < 0x80 ? low_ : high_)[b & 0x0f] |= static_cast<unsigned char>(1u << ((b >> 4) & 7));
+	}
+
+	constexpr bool contains(char c) const
+	{
+		const auto b = static_cast<unsigned char>(c);
+		return ((b < 0x80 ? low_ : high_)[b & 0x0f] >> ((b >> 4) & 7)) & 1;
+	}
+
+	/* row low_[b & 15] has bit (b >> 4) set for b < 0x80, high_ likewise for the rest */
+	const unsigned char* low_rows() const noexcept { return low_; }
+	const unsigned char* high_rows() const noexcept { return high_; }
+
+private:
+	unsigned char low_[16] = {};
+	unsigned char high_[16] = {};
+};
+
+/* a maximal run of digits found in a text */
+struct number_ref
+{
+	std::size_t position;
+	std::string_view digits;
+
+	/* nullopt when it does not fit */
+	std::optional<std::uint64_t> value() const noexcept;
+};
+
+std::optional<std::size_t> find_digit(std::string_view text) noexcept;
+
+std::optional<std::size_t> find_byte(std::string_view text, char c) noexcept;
+
+std::optional<std::size_t> find_first_of(std::string_view text, const byte_set& set) noexcept;
+
+inline std::optional<std::size_t> find_newline(std::string_view text) noexcept
+{
+	return find_byte(text, '\n');
+}
+
+std::optional<number_ref> find_number(std::string_view text) noexcept;
+
+/* the first number whose last digit is even / odd */
+std::optional<number_ref> find_even_number(std::string_view text) noexcept;
+std::optional<number_ref> find_odd_number(std::string_view text) noexcept;
+
+/* value of the first even number, nullopt if there is none or it does not fit in unsigned */
+std::optional<unsigned> first_even_number_in(std::string_view text) noexcept;
+
+} // text_scan
+} // cxx17
+} // pluto
@@ -0,0 +1,116 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 07:05:36
+ * @brief
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <benchmark/benchmark.h>
+
+#include "text_scan.h"
+
+using namespace std;
+using namespace pluto::cxx17::text_scan;
+
+namespace
+{
+
+/* 64 KiB, cache resident; every scan below misses and reads all of it */
+constexpr size_t text_size = 64 * 1024;
+
+string repeat(string_view line)
+{
+	string text;
+	while (text.size() < text_size) text += line;
+	text.resize(text_size);
+	return text;
+}
+
+/* log lines joined without their newlines */
+const string words = repeat("INFO worker started and queue drained ");
+const string odd_numbers = repeat("INFO took 17 ms, 35 rows, id 1023. ");
+
+const byte_set separators("\t,;=");
+
+/* state.range(0) is the isa, skipped when the CPU lacks it */
+template<class Scan>
+void scan(benchmark::State& state, const string& text, Scan f)
+{
+	const isa saved = active_isa();
+	const isa wanted = static_cast<isa>(state.range(0));
+	if (set_isa(wanted) != wanted)
+	{
+		state.SkipWithError("isa not available");
+		set_isa(saved);
+		return;
+	}
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(f(string_view(text)));
+	}
+	set_isa(saved);
+	state.SetLabel(isa_name(wanted));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+} // namespace
+
+static void BM_FindNewline(benchmark::State& state)
+{
+	scan(state, words, [](string_view t) { return find_newline(t); });
+}
+
+static void BM_FindDigit(benchmark::State& state)
+{
+	scan(state, words, [](string_view t) { return find_digit(t); });
+}
+
+static void BM_FindFirstOf(benchmark::State& state)
+{
+	scan(state, words, [](string_view t) { return find_first_of(t, separators); });
+}
+
+static void BM_FindEvenNumber(benchmark::State& state)
+{
+	scan(state, odd_numbers, [](string_view t) { return find_even_number(t); });
+}
+
+/* the references: libc memchr, string_view::find_first_of and a digit loop */
+static void BM_Memchr(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(memchr(words.data(), '\n', words.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(words.size()));
+}
+
+static void BM_StringViewFindFirstOf(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(string_view(words).find_first_of("\t,;="));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(words.size()));
+}
+
+static void BM_FindIfDigit(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(find_if(words.begin(), words.end(), [](char c) { return c >= '0' && c <= '9'; }));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(words.size()));
+}
+
+BENCHMARK(BM_FindNewline)->Arg(0);	// memchr, the same on every isa
+BENCHMARK(BM_FindDigit)->DenseRange(0, 2);
+BENCHMARK(BM_FindFirstOf)->DenseRange(0, 2);
+BENCHMARK(BM_FindEvenNumber)->DenseRange(0, 2);
+BENCHMARK(BM_Memchr);
+BENCHMARK(BM_StringViewFindFirstOf);
+BENCHMARK(BM_FindIfDigit);
@@ -0,0 +1,181 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 06:47:21
+ * @brief
+ */
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+
+#include "text_scan.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx17::text_scan;
+
+namespace
+{
+
+/* the obvious loops, what every instruction set has to agree with */
+namespace reference
+{
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+optional<size_t> find_if(string_view text, bool (*pred)(char, const void*), const void* arg)
+{
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		if (pred(text[i], arg)) return i;
+	}
+	return nullopt;
+}
+
+optional<size_t> find_digit(string_view text)
+{
+	return find_if(text, [](char c, const void*) { return is_digit(c); }, nullptr);
+}
+
+optional<size_t> find_first_of(string_view text, string_view members)
+{
+	const size_t i = text.find_first_of(members);
+	if (i == string_view::npos) return nullopt;
+	return i;
+}
+
+/* the first maximal run of digits, any (-1) or ending in an even (0) / odd (1) digit */
+optional<pair<size_t, size_t>> find_run(string_view text, int want_last_parity)
+{
+	for (size_t i = 0; i < text.size();)
+	{
+		if (!is_digit(text[i]))
+		{
+			++i;
+			continue;
+		}
+		size_t j = i;
+		while (j < text.size() && is_digit(text[j])) ++j;
+		if (want_last_parity < 0 || (text[j - 1] - '0') % 2 == want_last_parity) return pair{ i, j - i };
+		i = j;
+	}
+	return nullopt;
+}
+
+} // reference
+
+/* a mix of log-like runs and raw bytes, the alphabet changes from text to text */
+string random_text(mt19937& gen, size_t n)
+{
+	static const string alphabets[] = {
+		"abcdefghij klmnop,;=\t",
+		"0123456789",
+		"0123456789 ",
+		"13579 x",
+		"ab\n\r",
+		string("\x80\xff\x90\x0f\x7f\x00 9/:", 11),
+	};
+	const string& alphabet = alphabets[gen() % size(alphabets)];
+	const bool raw = gen() % 4 == 0;
+	string text(n, ' ');
+	for (auto& c : text)
+	{
+		c = raw ? static_cast<char>(gen()) : alphabet[gen() % alphabet.size()];
+	}
+	return text;
+}
+
+string random_members(mt19937& gen)
+{
+	string members(gen() % 40, ' ');
+	for (auto& c : members) c = static_cast<char>(gen());
+	return members;
+}
+
+void check_against_reference(string_view text, mt19937& gen)
+{
+	ASSERT_EQ(find_digit(text), reference::find_digit(text)) << text;
+
+	const char c = static_cast<char>(gen());
+	const size_t i = text.find(c);
+	ASSERT_EQ(find_byte(text, c), i == string_view::npos ? nullopt : optional<size_t>(i));
+	const size_t eol = text.find('\n');
+	ASSERT_EQ(find_newline(text), eol == string_view::npos ? nullopt : optional<size_t>(eol));
+
+	const string members = random_members(gen);
+	ASSERT_EQ(find_first_of(text, byte_set(members)), reference::find_first_of(text, members));
+
+	const auto as_pair = [](const optional<number_ref>& n) -> optional<pair<size_t, size_t>> {
+		if (!n) return nullopt;
+		return pair{ n->position, n->digits.size() };
+	};
+	ASSERT_EQ(as_pair(find_number(text)), reference::find_run(text, -1)) << text;
+	ASSERT_EQ(as_pair(find_even_number(text)), reference::find_run(text, 0)) << text;
+	ASSERT_EQ(as_pair(find_odd_number(text)), reference::find_run(text, 1)) << text;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX17_TEXT_SCAN) {
+
+	TEST_COUT << "text_scan detected isa: " << isa_name(detected_isa()) << endl;
+
+	/* the optional.h example */
+	EXPECT_EQ(first_even_number_in("took 17 ms, 42 rows"), 42u);
+	EXPECT_EQ(first_even_number_in("allen"), nullopt);
+	EXPECT_EQ(first_even_number_in("13 15 0"), 0u);
+	EXPECT_EQ(first_even_number_in("id 99999999999999999998"), nullopt);
+
+	const auto n = find_number("user=1024 took 35ms");
+	ASSERT_TRUE(n);
+	EXPECT_EQ(n->position, 5u);
+	EXPECT_EQ(n->digits, "1024");
+	EXPECT_EQ(n->value(), 1024u);
+	EXPECT_EQ(find_odd_number("user=1024 took 35ms")->digits, "35");
+	EXPECT_EQ((number_ref{ 0, "18446744073709551616" }.value()), nullopt);
+
+	static constexpr byte_set separators(" \t,;=");
+	static_assert(separators.contains(';') && !separators.contains('a'));
+	EXPECT_EQ(find_first_of("key=value", separators), 3u);
+	EXPECT_EQ(find_first_of("key", separators), nullopt);
+	EXPECT_EQ(find_first_of("anything", byte_set()), nullopt);
+	EXPECT_EQ(find_newline(""), nullopt);
+
+	byte_set everything;
+	for (int b = 0; b < 256; ++b) everything.insert(static_cast<char>(b));
+	EXPECT_EQ(find_first_of("\xff", everything), 0u);
+
+	/*
+	 * every instruction set against the loops: lengths around the block
+	 * sizes, starting at every offset of a 64-byte line, numbers that
+	 * cross block boundaries
+	 */
+	const isa saved = active_isa();
+	for (isa i : { isa::scalar, isa::sse42, isa::avx2 })
+	{
+		if (set_isa(i) != i) continue;
+		mt19937 gen(2026 + static_cast<unsigned>(i));
+		const string buffer = random_text(gen, 400);
+		for (int round = 0; round < 3000; ++round)
+		{
+			const string text = random_text(gen, gen() % 200);
+			check_against_reference(text, gen);
+			const size_t offset = gen() % 64;
+			check_against_reference(string_view(buffer).substr(offset, gen() % (buffer.size() - offset)), gen);
+			if (HasFatalFailure())
+			{
+				ADD_FAILURE() << "isa " << isa_name(i) << " round " << round;
+				set_isa(saved);
+				return;
+			}
+		}
+		const string long_number = string(70, 'x') + string(100, '7') + "4 1";
+		EXPECT_EQ(find_even_number(long_number)->position, 70u);
+		EXPECT_EQ(find_odd_number(long_number)->position, 172u);
+	}
+	set_isa(saved);
+}
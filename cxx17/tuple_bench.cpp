@@ -0,0 +1,124 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 20:01:47
+ * @brief
+ */
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "tuple.h"
+
+using namespace std;
+using namespace pluto::cxx17::tuple;
+
+static void BM_TupleCat(benchmark::State& state)
+{
+	auto a = std::make_tuple(1, 2.0, 'c');
+	auto b = std::make_tuple(3L, 4.0f);
+	int i = 0;
+	for (auto _ : state)
+	{
+		std::get<0>(a) = i++;
+		auto t = std::tuple_cat(a, b, foo_tuple());
+		benchmark::DoNotOptimize(t);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* tuple_cat with a member that owns memory, every call copies the string */
+static void BM_TupleCat_String(benchmark::State& state)
+{
+	auto student = get_student(1);
+	auto id = std::make_tuple(1);
+	for (auto _ : state)
+	{
+		auto t = std::tuple_cat(id, student);
+		benchmark::DoNotOptimize(t);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* std::apply(add, t) against add(get<0>(t), get<1>(t)) */
+static void BM_Apply(benchmark::State& state)
+{
+	vector<tuple<int, int>> v(4096);
+	for (int i = 0; i < 4096; ++i) v[i] = { i, -i / 2 };
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (const auto& t : v) sum += std::apply(add, t);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+static void BM_Apply_Get(benchmark::State& state)
+{
+	vector<tuple<int, int>> v(4096);
+	for (int i = 0; i < 4096; ++i) v[i] = { i, -i / 2 };
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (const auto& t : v) sum += add(std::get<0>(t), std::get<1>(t));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+/* unpacking a returned tuple: structured bindings, std::tie, std::get */
+static void BM_StructuredBinding(benchmark::State& state)
+{
+	int id = 0;
+	for (auto _ : state)
+	{
+		auto [gpa, grade, name] = get_student(id);
+		benchmark::DoNotOptimize(gpa);
+		benchmark::DoNotOptimize(grade);
+		benchmark::DoNotOptimize(name.data());
+		id = (id + 1) % 3;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Tie(benchmark::State& state)
+{
+	int id = 0;
+	double gpa;
+	char grade;
+	string name;
+	for (auto _ : state)
+	{
+		std::tie(gpa, grade, name) = get_student(id);
+		benchmark::DoNotOptimize(gpa);
+		benchmark::DoNotOptimize(grade);
+		benchmark::DoNotOptimize(name.data());
+		id = (id + 1) % 3;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Get(benchmark::State& state)
+{
+	int id = 0;
+	for (auto _ : state)
+	{
+		auto t = get_student(id);
+		benchmark::DoNotOptimize(std::get<0>(t));
+		benchmark::DoNotOptimize(std::get<1>(t));
+		benchmark::DoNotOptimize(std::get<2>(t).data());
+		id = (id + 1) % 3;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TupleCat);
+BENCHMARK(BM_TupleCat_String);
+BENCHMARK(BM_Apply);
+BENCHMARK(BM_Apply_Get);
+BENCHMARK(BM_StructuredBinding);
+BENCHMARK(BM_Tie);
+BENCHMARK(BM_Get);
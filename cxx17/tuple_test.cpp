@@ -18,6 +18,7 @@ using namespace pluto::cxx17::tuple;
 TEST(PLUTO, CXX17_TUPLE) {
 
 	{
+		TEST_PERF_SCOPE("foo_tuple");
 		auto t = foo_tuple();
 		TEST_COUT << get<1>(t) << endl;
 	}
@@ -25,6 +26,7 @@ TEST(PLUTO, CXX17_TUPLE) {
 	TEST_COUT_DELIMITER;
 
 	{
+		TEST_PERF_SCOPE("get_student");
 		auto student0 = get_student(0);
 		TEST_COUT << "ID: 0, "
 			<< "GPA: " << std::get<0>(student0) << ", "
@@ -57,6 +59,7 @@ TEST(PLUTO, CXX17_TUPLE) {
 		// t is std::tuple<std::tuple<const char *>, std::tuple<int, int>>
 		// auto t = make_tuple(make_tuple("hello"), make_tuple(1, 2));
 
+		TEST_PERF_SCOPE("piecewise_construct");
 		// call a function pair().
 		pair<string, complex<double>> scp(piecewise_construct, make_tuple("hello"), make_tuple(1, 2));
 
@@ -108,6 +111,7 @@ TEST(PLUTO, CXX17_TUPLE) {
 	// TEST_COUT_DELIMITER;
 
 	{
+		TEST_PERF_SCOPE("tuple_cat");
 		TEST_COUT;
 		std::tuple<int, std::string, float> t1(10, "Test", 3.14);
 		int n = 7;
@@ -119,6 +123,7 @@ TEST(PLUTO, CXX17_TUPLE) {
 	TEST_COUT_DELIMITER;
 
 	{
+		TEST_PERF_SCOPE("apply");
 		// OK
 		TEST_COUT << std::apply(add, std::pair(1, 2)) << '\n';
 
@@ -144,6 +149,7 @@ TEST(PLUTO, CXX17_TUPLE) {
 			}
 		};
 
+		TEST_PERF_SCOPE("make_from_tuple");
 		auto tuple = std::make_tuple(42, 3.14f, 0);
 		std::make_from_tuple<Foo>(std::move(tuple));
 	}
@@ -0,0 +1,116 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 19:53:08
+ * @brief
+ */
+
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "variant.h"
+
+using namespace std;
+using namespace pluto::cxx17::variant;
+
+namespace
+{
+
+using value_t = std::variant<int, float, std::string>;
+
+/* 4096 values with the alternative picked at random */
+vector<value_t> random_values()
+{
+	std::mt19937 gen(1);
+	vector<value_t> v;
+	v.reserve(4096);
+	for (int i = 0; i < 4096; ++i)
+	{
+		switch (gen() % 3)
+		{
+		case 0: v.emplace_back(i); break;
+		case 1: v.emplace_back(static_cast<float>(i)); break;
+		default: v.emplace_back(std::string("item")); break;
+		}
+	}
+	return v;
+}
+
+/* PrintVisitor writes to std::cout, send it nowhere while it is measured */
+class null_cout
+{
+public:
+	null_cout() : old_(std::cout.rdbuf(sink_.rdbuf())) {}
+	~null_cout() { std::cout.rdbuf(old_); }
+
+	void clear() { sink_.str(std::string()); }
+
+private:
+	std::ostringstream sink_;
+	std::streambuf* old_;
+};
+
+} // namespace
+
+static void BM_Visit_AddVisitor(benchmark::State& state)
+{
+	auto v = random_values();
+	for (auto _ : state)
+	{
+		for (auto& x : v) std::visit(AddVisitor{}, x);
+		benchmark::ClobberMemory();
+
+		state.PauseTiming();
+		for (auto& x : v) if (auto* s = std::get_if<std::string>(&x)) s->resize(4);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+/* the same update dispatched by hand on index() */
+static void BM_Visit_IndexSwitch(benchmark::State& state)
+{
+	auto v = random_values();
+	for (auto _ : state)
+	{
+		for (auto& x : v)
+		{
+			switch (x.index())
+			{
+			case 0: *std::get_if<0>(&x) += 1; break;
+			case 1: *std::get_if<1>(&x) += 1.0f; break;
+			case 2: *std::get_if<2>(&x) += " !!!"; break;
+			}
+		}
+		benchmark::ClobberMemory();
+
+		state.PauseTiming();
+		for (auto& x : v) if (auto* s = std::get_if<std::string>(&x)) s->resize(4);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+static void BM_Visit_PrintVisitor(benchmark::State& state)
+{
+	auto v = random_values();
+	null_cout quiet;
+	for (auto _ : state)
+	{
+		for (const auto& x : v) std::visit(PrintVisitor{}, x);
+
+		state.PauseTiming();
+		quiet.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * v.size());
+}
+
+BENCHMARK(BM_Visit_AddVisitor);
+BENCHMARK(BM_Visit_IndexSwitch);
+BENCHMARK(BM_Visit_PrintVisitor);
@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "variant.h"
+#include "common/alloc_counter.h"
 #include "common/define.h"
 
 using namespace std;
@@ -76,4 +77,13 @@ TEST(PLUTO, CXX17_VARIANT) {
 		std::visit(AddVisitor(), v);
 		std::visit(PrintVisitor(), v);
 	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// re-assignment switches the alternative in place; only a string past the SSO length allocates
+		std::variant<int, float, std::string> v = 1;
+		EXPECT_NO_ALLOCATIONS({ v = 2.0f; v = 3; v = "short"; v = 4; });
+		EXPECT_ALLOCATIONS_LE(1, { v = "a string too long for the small buffer"; });
+	}
 }
\ No newline at end of file
@@ -0,0 +1,211 @@
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 18:02:14
+ * @brief
+ */
+
+#include "constexpr.h"
+
+#if PLUTO_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace pluto
+{
+namespace cxx20
+{
+namespace constexpr_ns
+{
+namespace sorting_network
+{
+
+namespace
+{
+
+/*
+ * The network for N lanes as a list of layers. In layer l lane i is
+ * compared with lane partner[l][i] (itself if idle) and keeps the max
+ * when take_max[l][i] is set, the min otherwise. Lanes are split into
+ * registers of 8: lane i of a layer reads its partner from register
+ * partner / 8, slot partner % 8.
+ */
+template<std::size_t N>
+struct lane_plan
+{
+	static constexpr std::size_t layers = depth<N>();
+
+	std::array<std::array<std::int32_t, N>, layers> slot{};
+	std::array<std::array<std::int32_t, N>, layers> other_reg{};
+	std::array<std::array<std::int32_t, N>, layers> take_max{};
+};
+
+template<std::size_t N>
+constexpr lane_plan<N> make_lane_plan()
+{
+	lane_plan<N> plan;
+	for (std::size_t l = 0; l < plan.layers; ++l)
+	{
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			plan.slot[l][i] = static_cast<std::int32_t>(i % 8);
+		}
+	}
+
+	std::array<std::size_t, N> ready{};
+	for (auto c : network<N>)
+	{
+		std::size_t l = std::max(ready[c.lo], ready[c.hi]);
+		ready[c.lo] = ready[c.hi] = l + 1;
+
+		plan.slot[l][c.lo] = c.hi % 8;
+		plan.slot[l][c.hi] = c.lo % 8;
+		plan.other_reg[l][c.lo] = c.lo / 8 != c.hi / 8 ? -1 : 0;
+		plan.other_reg[l][c.hi] = c.lo / 8 != c.hi / 8 ? -1 : 0;
+		plan.take_max[l][c.hi] = -1;
+	}
+	return plan;
+}
+
+constexpr auto plan8 = make_lane_plan<8>();
+constexpr auto plan16 = make_lane_plan<16>();
+
+cpu::isa_dispatch& dispatch()
+{
+	static cpu::isa_dispatch networks{ isa::avx2 };
+	return networks;
+}
+
+bool use_avx2()
+{
+	return dispatch().active() == isa::avx2;
+}
+
+#if PLUTO_SIMD_X86
+
+namespace avx2
+{
+
+#define PLUTO_AVX2 __attribute__((target("avx2"))) inline
+
+/* the same code for both key types, only the instructions differ */
+struct i32
+{
+	using reg = __m256i;
+	PLUTO_AVX2 static reg load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	PLUTO_AVX2 static void store(std::int32_t* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	PLUTO_AVX2 static reg permute(reg v, __m256i idx) { return _mm256_permutevar8x32_epi32(v, idx); }
+	PLUTO_AVX2 static reg select(reg a, reg b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+	PLUTO_AVX2 static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+	PLUTO_AVX2 static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+};
+
+struct f32
+{
+	using reg = __m256;
+	PLUTO_AVX2 static reg load(const float* p) { return _mm256_loadu_ps(p); }
+	PLUTO_AVX2 static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+	PLUTO_AVX2 static reg permute(reg v, __m256i idx) { return _mm256_permutevar8x32_ps(v, idx); }
+	PLUTO_AVX2 static reg select(reg a, reg b, __m256i mask) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask)); }
+	PLUTO_AVX2 static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+	PLUTO_AVX2 static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+};
+
+PLUTO_AVX2 __m256i row(const std::int32_t* p)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template<class K, class T>
+PLUTO_AVX2 void sort8(T* first)
+{
+	auto v = K::load(first);
+	for (std::size_t l = 0; l < plan8.layers; ++l)
+	{
+		auto partner = K::permute(v, row(plan8.slot[l].data()));
+		v = K::select(K::min(v, partner), K::max(v, partner), row(plan8.take_max[l].data()));
+	}
+	K::store(first, v);
+}
+
+template<class K, class T>
+PLUTO_AVX2 void sort16(T* first)
+{
+	auto a = K::load(first);
+	auto b = K::load(first + 8);
+	for (std::size_t l = 0; l < plan16.layers; ++l)
+	{
+		const std::int32_t* slot = plan16.slot[l].data();
+		const std::int32_t* other = plan16.other_reg[l].data();
+		const std::int32_t* take_max = plan16.take_max[l].data();
+
+		// gather each lane's partner from its own or the other register
+		auto ia = row(slot), ib = row(slot + 8);
+		auto pa = K::select(K::permute(a, ia), K::permute(b, ia), row(other));
+		auto pb = K::select(K::permute(b, ib), K::permute(a, ib), row(other + 8));
+
+		a = K::select(K::min(a, pa), K::max(a, pa), row(take_max));
+		b = K::select(K::min(b, pb), K::max(b, pb), row(take_max + 8));
+	}
+	K::store(first, a);
+	K::store(first + 8, b);
+}
+
+#undef PLUTO_AVX2
+
+} // avx2
+
+#endif
+
+} // namespace
+
+isa detected_isa()
+{
+	return dispatch().detected();
+}
+
+isa active_isa()
+{
+	return dispatch().active();
+}
+
+isa set_isa(isa requested)
+{
+	return dispatch().set(requested);
+}
+
+void simd_sort8(std::int32_t* first)
+{
+#if PLUTO_SIMD_X86
+	if (use_avx2()) return avx2::sort8<avx2::i32>(first);
+#endif
+	sort<8>(first);
+}
+
+void simd_sort8(float* first)
+{
+#if PLUTO_SIMD_X86
+	if (use_avx2()) return avx2::sort8<avx2::f32>(first);
+#endif
+	sort<8>(first);
+}
+
+void simd_sort16(std::int32_t* first)
+{
+#if PLUTO_SIMD_X86
+	if (use_avx2()) return avx2::sort16<avx2::i32>(first);
+#endif
+	sort<16>(first);
+}
+
+void simd_sort16(float* first)
+{
+#if PLUTO_SIMD_X86
+	if (use_avx2()) return avx2::sort16<avx2::f32>(first);
+#endif
+	sort<16>(first);
+}
+
+} // sorting_network
+} // constexpr_ns
+} // cxx20
+} // pluto
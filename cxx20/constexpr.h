@@ -7,6 +7,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "common/cpu_isa.h"
+
 namespace pluto
 {
 namespace cxx20
@@ -44,7 +57,7 @@ constexpr auto add5 = adder(5);
 template <unsigned N>
 class X {};
 
-int foo() {
+inline int foo() {
 	//use in a constant expression
 	X<add5(22)> x27;
 	(void)x27;
@@ -151,6 +164,661 @@ auto f(T t) {
 	else return "aaa";
 }
 
+/*
+ * Constexpr tables :
+ *
+ * X<add5(22)> above works because add5(22) is evaluated by the compiler.
+ * The same holds for a whole loop: a constexpr function may fill a
+ * std::array, and binding the result to a constexpr variable forces the
+ * evaluation to happen during compilation. The finished table is emitted
+ * into read-only data, exactly like a hand written initializer list:
+ *
+ *		constexpr auto squares = make_table<16>([](std::size_t i) { return i * i; });
+ *		static_assert(squares[15] == 225);
+ *
+ * Compared with computing on every call, or filling a static table
+ * lazily on first use, there is no startup cost, no "is it initialized
+ * yet" guard in the hot loop, and no chance to get the data races of
+ * lazy initialization wrong.
+ *
+ * The element type is whatever f returns; it must be default
+ * constructible and f must be usable in a constant expression.
+ */
+
+template<std::size_t N, class F>
+constexpr auto make_table(F f)
+{
+	using T = std::decay_t<decltype(f(std::size_t{}))>;
+	std::array<T, N> table{};
+	for (std::size_t i = 0; i < N; ++i) table[i] = f(i);
+	return table;
+}
+
+namespace tables
+{
+
+namespace detail
+{
+
+/* byte-at-a-time table for a reflected CRC-32 polynomial */
+constexpr auto crc_table(std::uint32_t poly)
+{
+	return make_table<256>([poly](std::size_t i) {
+		std::uint32_t c = static_cast<std::uint32_t>(i);
+		for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+		return c;
+	});
+}
+
+/* std::sin / std::log are not constexpr (until C++26), series do */
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double sin_series(double x)
+{
+	// reduce to [-pi, pi], then sum x - x^3/3! + x^5/5! - ...
+	while (x > pi) x -= 2 * pi;
+	while (x < -pi) x += 2 * pi;
+	double term = x, sum = x;
+	for (int n = 1; n < 20; ++n)
+	{
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+/* ln(x) = 2 atanh((x - 1) / (x + 1)), converges fast for x in [1, 2] */
+constexpr double log_series(double x)
+{
+	double y = (x - 1) / (x + 1), y2 = y * y;
+	double term = y, sum = 0;
+	for (int n = 1; n < 60; n += 2)
+	{
+		sum += term / n;
+		term *= y2;
+	}
+	return 2 * sum;
+}
+
+constexpr std::int32_t round_to_int(double x)
+{
+	return static_cast<std::int32_t>(x >= 0 ? x + 0.5 : x - 0.5);
+}
+
+} // detail
+
+// CRC-32 (zlib, ethernet) and CRC-32C (Castagnoli, iSCSI, ext4)
+
+inline constexpr auto crc32_table = detail::crc_table(0xEDB88320u);
+inline constexpr auto crc32c_table = detail::crc_table(0x82F63B78u);
+
+constexpr std::uint32_t crc32(std::string_view s, std::uint32_t crc = 0)
+{
+	crc = ~crc;
+	for (unsigned char c : s) crc = crc32_table[(crc ^ c) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
+
+constexpr std::uint32_t crc32c(std::string_view s, std::uint32_t crc = 0)
+{
+	crc = ~crc;
+	for (unsigned char c : s) crc = crc32c_table[(crc ^ c) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
+
+// bits of a byte
+
+inline constexpr auto popcount8_table = make_table<256>([](std::size_t i) {
+	std::uint8_t n = 0;
+	for (; i != 0; i >>= 1) n += i & 1;
+	return n;
+});
+
+inline constexpr auto bit_reverse8_table = make_table<256>([](std::size_t i) {
+	std::uint8_t r = 0;
+	for (int k = 0; k < 8; ++k) r = static_cast<std::uint8_t>(r << 1 | ((i >> k) & 1));
+	return r;
+});
+
+constexpr std::uint32_t reverse_bits(std::uint32_t v)
+{
+	return std::uint32_t{ bit_reverse8_table[v & 0xff] } << 24
+		| std::uint32_t{ bit_reverse8_table[(v >> 8) & 0xff] } << 16
+		| std::uint32_t{ bit_reverse8_table[(v >> 16) & 0xff] } << 8
+		| std::uint32_t{ bit_reverse8_table[v >> 24] };
+}
+
+// character classes, one lookup instead of a chain of comparisons
+
+enum char_class : std::uint8_t
+{
+	cc_digit = 1 << 0,
+	cc_upper = 1 << 1,
+	cc_lower = 1 << 2,
+	cc_space = 1 << 3,
+	cc_xdigit = 1 << 4,
+	cc_punct = 1 << 5,
+	cc_ident = 1 << 6, // [A-Za-z0-9_]
+	cc_alpha = cc_upper | cc_lower,
+};
+
+inline constexpr auto char_class_table = make_table<256>([](std::size_t i) {
+	const char c = static_cast<char>(i);
+	std::uint8_t m = 0;
+	if (c >= '0' && c <= '9') m |= cc_digit | cc_xdigit | cc_ident;
+	if (c >= 'A' && c <= 'Z') m |= cc_upper | cc_ident;
+	if (c >= 'a' && c <= 'z') m |= cc_lower | cc_ident;
+	if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) m |= cc_xdigit;
+	if (c == ' ' || (c >= '\t' && c <= '\r')) m |= cc_space;
+	if (i > 0x20 && i < 0x7f && !(m & (cc_digit | cc_alpha))) m |= cc_punct;
+	if (c == '_') m |= cc_ident;
+	return m;
+});
+
+constexpr bool has_class(char c, std::uint8_t mask)
+{
+	return (char_class_table[static_cast<unsigned char>(c)] & mask) != 0;
+}
+
+// fixed point math
+
+/* sin(2 pi i / 256) in Q1.15, the angle is a byte: 64 is 90 degrees */
+inline constexpr auto sin_q15_table = make_table<256>([](std::size_t i) {
+	return static_cast<std::int16_t>(detail::round_to_int(
+		detail::sin_series(2 * detail::pi * static_cast<double>(i) / 256) * 32767));
+});
+
+constexpr std::int16_t sin_q15(std::uint8_t angle) { return sin_q15_table[angle]; }
+
+constexpr std::int16_t cos_q15(std::uint8_t angle) { return sin_q15_table[static_cast<std::uint8_t>(angle + 64)]; }
+
+/* log2(1 + i / 256) in Q16, the mantissa part of a fixed point log2 */
+inline constexpr auto log2_q16_table = make_table<257>([](std::size_t i) {
+	return static_cast<std::uint32_t>(detail::round_to_int(
+		detail::log_series(1 + static_cast<double>(i) / 256) / detail::log_series(2) * 65536));
+});
+
+/*
+ * log2(x) in Q16: integer part from the leading bit, fraction from the
+ * table, linearly interpolated on the next 8 bits. log2(0) has no value,
+ * log2_q16(0) is defined as 0, the same as log2_q16(1).
+ */
+constexpr std::uint32_t log2_q16(std::uint32_t x)
+{
+	if (x == 0) return 0;
+
+	int msb = 31;
+	while (!(x >> msb)) --msb;
+
+	// normalize the mantissa to 16 bits below the leading one
+	std::uint32_t m = msb >= 16 ? x >> (msb - 16) : x << (16 - msb);
+	std::uint32_t index = (m >> 8) & 0xff, frac = m & 0xff;
+	std::uint32_t lo = log2_q16_table[index], hi = log2_q16_table[index + 1];
+
+	return (static_cast<std::uint32_t>(msb) << 16) + lo + (((hi - lo) * frac + 128) >> 8);
+}
+
+} // tables
+
+/*
+ * Constexpr string hashing :
+ *
+ * A switch only takes integral case labels, so dispatch on a string key
+ * is usually a chain of compares, like get_student() in cxx17/tuple.cpp:
+ *
+ *		if (cmd == "get") ...
+ *		else if (cmd == "set") ...
+ *		else if (cmd == "del") ...
+ *
+ * Every miss costs a compare. A constexpr hash turns the literals into
+ * integers during compilation, so they can be case labels, and the
+ * runtime key is hashed exactly once:
+ *
+ *		switch (commands.find(cmd)) {
+ *		case "get"_hash: ...
+ *		case "set"_hash: ...
+ *		default: // unknown command
+ *		}
+ *
+ * A hash hit is not a match, two different strings may share a hash.
+ * string_keys::find() therefore compares the text of the key it hit
+ * before answering, and reports no_match otherwise. Collisions between
+ * the labels themselves are caught while compiling: string_keys refuses
+ * them (consteval), and a switch with two equal case labels is ill-formed
+ * anyway.
+ *
+ * The hash is 64-bit FNV-1a: one xor and one multiply per byte, short
+ * keys like these hash in a few nanoseconds.
+ */
+namespace string_hash
+{
+
+constexpr std::uint64_t fnv1a(std::string_view s)
+{
+	std::uint64_t h = 0xcbf29ce484222325ull;
+	for (char c : s)
+	{
+		h ^= static_cast<unsigned char>(c);
+		h *= 0x100000001b3ull;
+	}
+	return h;
+}
+
+/* what find() returns for unknown keys, no key may hash to it */
+inline constexpr std::uint64_t no_match = 0;
+
+/* a string literal together with its hash, usable as a case label */
+struct hashed_string
+{
+	std::uint64_t hash;
+	std::string_view text;
+
+	constexpr operator std::uint64_t() const { return hash; }
+
+	/* runtime verification after a hash hit */
+	constexpr bool matches(std::string_view s) const { return s == text; }
+};
+
+consteval hashed_string operator""_hash(const char* s, std::size_t n)
+{
+	return { fnv1a({ s, n }), { s, n } };
+}
+
+/*
+ * The set of keys one switch dispatches on. Construction happens at
+ * compile time and fails to compile if two keys collide:
+ *
+ *		constexpr string_keys commands{ "get", "set", "del" };
+ */
+template<std::size_t N>
+class string_keys
+{
+public:
+	template<class... S>
+	consteval explicit string_keys(const S&... s) : keys_{ hashed_string{ fnv1a(s), s }... }
+	{
+		std::sort(keys_.begin(), keys_.end(), [](const hashed_string& a, const hashed_string& b) {
+			return a.hash < b.hash;
+		});
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			if (keys_[i].hash == no_match) throw "string_keys: key hashes to no_match";
+			if (i > 0 && keys_[i - 1].hash == keys_[i].hash) throw "string_keys: hash collision";
+		}
+	}
+
+	/* hash of s if s is one of the keys, no_match otherwise */
+	constexpr std::uint64_t find(std::string_view s) const
+	{
+		const std::uint64_t h = fnv1a(s);
+		auto it = std::lower_bound(keys_.begin(), keys_.end(), h, [](const hashed_string& k, std::uint64_t v) {
+			return k.hash < v;
+		});
+		return it != keys_.end() && it->hash == h && it->matches(s) ? h : no_match;
+	}
+
+	constexpr bool contains(std::string_view s) const { return find(s) != no_match; }
+
+	static constexpr std::size_t size() { return N; }
+
+private:
+	std::array<hashed_string, N> keys_;
+};
+
+template<class... S>
+string_keys(const S&...) -> string_keys<sizeof...(S)>;
+
+} // string_hash
+
+/*
+ * Runtime values as template arguments :
+ *
+ * X<add5(22)> works because the argument is known while compiling. A
+ * stride or an unroll factor read from a config is not, but it usually
+ * comes from a small known set, so every candidate can be instantiated
+ * ahead of time and the runtime value only picks one of them:
+ *
+ *		pluto::specialize<1, 2, 4, 8>(stride, [&]<int S>() {
+ *			for (std::size_t i = 0; i < n; i += S) sum += p[i];	// S is a constant here
+ *		});
+ *
+ * specialize<Vs...>(v, f) calls f.template operator()<V>() for the V that
+ * equals v through a table of function pointers, one entry per value, so
+ * dispatch costs one indirect call however many values there are. The
+ * index is v - V0 when the values are consecutive integers, otherwise a
+ * linear compare over the values.
+ *
+ * Several parameters are dispatched at once by passing values<...> lists,
+ * one per runtime value; f is instantiated for the whole cartesian product:
+ *
+ *		using namespace pluto::cxx20::constexpr_ns::specialization;
+ *		specialize<values<1, 2, 4>, values<8, 16>>(stride, width, [&]<int S, int W>() { ... });
+ *
+ * The result is the common type of what the instantiations return. A
+ * value outside its list throws std::out_of_range.
+ */
+namespace specialization
+{
+
+template<auto... Vs>
+struct values {};
+
+namespace detail
+{
+
+template<class T>
+struct is_values : std::false_type {};
+
+template<auto... Vs>
+struct is_values<values<Vs...>> : std::true_type {};
+
+/* Vs are V0, V0 + 1, V0 + 2, ... */
+template<auto V0, auto... Vs>
+constexpr bool consecutive()
+{
+	if constexpr ((std::is_integral_v<decltype(V0)> && ... && std::is_integral_v<decltype(Vs)>))
+	{
+		std::size_t i = 0;
+		return ((Vs == V0 + static_cast<decltype(V0)>(++i)) && ...);
+	}
+	else return false;
+}
+
+/* integers std::cmp_* accepts: no bool, no character types */
+template<class T>
+inline constexpr bool is_cmp_integer = std::is_integral_v<T>
+	&& !std::is_same_v<T, bool> && !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t>
+	&& !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+/* v == V, without sign-compare surprises between integer types */
+template<auto V, class T>
+constexpr bool equal(const T& v)
+{
+	if constexpr (is_cmp_integer<T> && is_cmp_integer<decltype(V)>) return std::cmp_equal(v, V);
+	else return v == V;
+}
+
+/* position of v in Vs, sizeof...(Vs) if absent */
+template<auto V0, auto... Vs, class T>
+constexpr std::size_t index_of(const T& v)
+{
+	constexpr std::size_t n = 1 + sizeof...(Vs);
+	if constexpr (is_cmp_integer<T> && is_cmp_integer<decltype(V0)> && consecutive<V0, Vs...>())
+	{
+		using V = decltype(V0);
+		if (std::cmp_less(v, V0) || std::cmp_greater(v, V0 + static_cast<V>(n - 1))) return n;
+		return static_cast<std::size_t>(static_cast<V>(v) - V0);
+	}
+	else
+	{
+		std::size_t i = 0;
+		if (!(equal<V0>(v) || ... || (++i, equal<Vs>(v)))) ++i;
+		return i;
+	}
+}
+
+/* Bound holds the values chosen so far, Lists the ones still to dispatch */
+template<class Bound, class... Lists>
+struct dispatcher;
+
+template<auto... Bound>
+struct dispatcher<values<Bound...>>
+{
+	template<class F>
+	static decltype(auto) run(F& f)
+	{
+		return f.template operator()<Bound...>();
+	}
+};
+
+template<auto... Bound, auto... Vs, class... Lists>
+struct dispatcher<values<Bound...>, values<Vs...>, Lists...>
+{
+	template<class F, class T, class... Ts>
+	static decltype(auto) run(F& f, const T& v, const Ts&... vs)
+	{
+		using result = std::common_type_t<decltype(dispatcher<values<Bound..., Vs>, Lists...>::run(f, vs...))...>;
+		using entry = result (*)(F&, const Ts&...);
+
+		static constexpr entry table[] = {
+			[](F& f, const Ts&... vs) -> result {
+				return dispatcher<values<Bound..., Vs>, Lists...>::run(f, vs...);
+			}...
+		};
+
+		const std::size_t i = index_of<Vs...>(v);
+		if (i == sizeof...(Vs)) throw std::out_of_range("specialize: value not in the list");
+		return table[i](f, vs...);
+	}
+};
+
+} // detail
+
+/* one runtime value against the values Vs */
+template<auto V0, auto... Vs, class T, class F>
+decltype(auto) specialize(const T& v, F&& f)
+{
+	return detail::dispatcher<values<>, values<V0, Vs...>>::run(f, v);
+}
+
+/* cartesian dispatch, specialize<values<...>, values<...>>(v0, v1, f) */
+template<class List, class... Lists, class... Args>
+	requires detail::is_values<List>::value
+decltype(auto) specialize(Args&&... args)
+{
+	static_assert(sizeof...(Args) == sizeof...(Lists) + 2, "one runtime value per values<> list, then f");
+
+	auto tuple = std::forward_as_tuple(std::forward<Args>(args)...);
+	return [&]<std::size_t... I>(std::index_sequence<I...>) -> decltype(auto) {
+		return detail::dispatcher<values<>, List, Lists...>::run(
+			std::get<sizeof...(Args) - 1>(tuple), std::get<I>(tuple)...);
+	}(std::make_index_sequence<sizeof...(Args) - 1>{});
+}
+
+} // specialization
+
+/*
+ * Sorting networks :
+ *
+ * A sorting network is a fixed list of compare-exchange steps (i, j):
+ * "put the smaller of a[i], a[j] into a[i]". The list depends only on
+ * the size, never on the data, so
+ *
+ *	- it can be computed by the compiler, like the tables above,
+ *	- the sort has no data dependent branches, each step is a min and a
+ *	  max (cmov, minss/maxss, or a whole vector of them),
+ *	- it is a plain constexpr loop, usable in constant expressions.
+ *
+ * For 2..32 elements this beats std::sort, whose introsort spends most
+ * of its time on mispredicted branches at these sizes.
+ *
+ *		constexpr auto a = sorted(std::array{ 3, 1, 2 });	// { 1, 2, 3 }
+ *		sorting_network::sort<8>(p);						// p[0..8)
+ *		sorting_network::sort_small(p, n);					// any n, a network for n <= 32
+ *
+ * The networks are Batcher's odd-even merge sort, generated for the next
+ * power of two and pruned: a step that touches an index past the end
+ * only ever compares against +infinity and does nothing.
+ *
+ * simd_sort8 / simd_sort16 sort 8 or 16 int32 or float keys inside AVX2
+ * registers, one permute + min + max + blend per layer of the network
+ * (constexpr.cpp), and fall back to the scalar network elsewhere. Order
+ * among NaNs is unspecified. The AVX2 path is picked at run time and
+ * can be switched off with set_isa() independently of other modules.
+ */
+namespace sorting_network
+{
+
+inline constexpr std::size_t max_size = 32;
+
+/* one compare-exchange step, a[lo] <= a[hi] afterwards */
+struct comparator
+{
+	std::uint8_t lo;
+	std::uint8_t hi;
+};
+
+namespace detail
+{
+
+constexpr std::size_t ceil_pow2(std::size_t n)
+{
+	std::size_t p = 1;
+	while (p < n) p <<= 1;
+	return p;
+}
+
+/* calls emit(lo, hi) for Batcher's network on n elements, in layer order */
+template<class Emit>
+constexpr void batcher(std::size_t n, Emit emit)
+{
+	const std::size_t m = ceil_pow2(n);
+	for (std::size_t p = 1; p < m; p <<= 1)
+	{
+		for (std::size_t k = p; k >= 1; k >>= 1)
+		{
+			for (std::size_t j = k % p; j + k < m; j += 2 * k)
+			{
+				for (std::size_t i = 0; i < k && i + j + k < m; ++i)
+				{
+					if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < n) emit(i + j, i + j + k);
+				}
+			}
+		}
+	}
+}
+
+constexpr std::size_t network_size(std::size_t n)
+{
+	std::size_t count = 0;
+	batcher(n, [&](std::size_t, std::size_t) { ++count; });
+	return count;
+}
+
+template<std::size_t N>
+constexpr auto make_network()
+{
+	std::array<comparator, network_size(N)> net{};
+	std::size_t k = 0;
+	batcher(N, [&](std::size_t lo, std::size_t hi) {
+		net[k++] = { static_cast<std::uint8_t>(lo), static_cast<std::uint8_t>(hi) };
+	});
+	return net;
+}
+
+} // detail
+
+/* the compare-exchange steps for N elements */
+template<std::size_t N>
+inline constexpr auto network = detail::make_network<N>();
+
+/*
+ * Parallel depth of a network: steps are packed into layers of disjoint
+ * pairs, a step lands one layer after the last step touching its indices.
+ */
+template<std::size_t N>
+constexpr std::size_t depth()
+{
+	std::array<std::size_t, (N > 0 ? N : 1)> ready{};
+	std::size_t d = 0;
+	for (auto c : network<N>)
+	{
+		std::size_t layer = std::max(ready[c.lo], ready[c.hi]) + 1;
+		ready[c.lo] = ready[c.hi] = layer;
+		d = std::max(d, layer);
+	}
+	return d;
+}
+
+/* branch free for arithmetic types: both sides are selects, not jumps */
+template<class T, class Compare>
+constexpr void compare_exchange(T& a, T& b, Compare comp)
+{
+	const bool swap = comp(b, a);
+	T lo = swap ? b : a;
+	T hi = swap ? a : b;
+	a = std::move(lo);
+	b = std::move(hi);
+}
+
+/* sort first[0..N) with the network for N, fully unrolled */
+template<std::size_t N, class T, class Compare = std::less<>>
+constexpr void sort(T* first, Compare comp = Compare())
+{
+	static_assert(N <= max_size, "networks are generated for up to 32 elements");
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		(compare_exchange(first[network<N>[I].lo], first[network<N>[I].hi], comp), ...);
+	}(std::make_index_sequence<network<N>.size()>{});
+}
+
+template<class T, std::size_t N, class Compare = std::less<>>
+constexpr void sort(std::array<T, N>& a, Compare comp = Compare())
+{
+	sort<N>(a.data(), comp);
+}
+
+template<class T, std::size_t N, class Compare = std::less<>>
+constexpr std::array<T, N> sorted(std::array<T, N> a, Compare comp = Compare())
+{
+	sort<N>(a.data(), comp);
+	return a;
+}
+
+// in-register versions, constexpr.cpp
+
+/* scalar or avx2, see common/cpu_isa.h */
+using cpu::isa;
+using cpu::isa_name;
+
+/* best instruction set the networks can use on this CPU */
+isa detected_isa();
+
+/* instruction set the networks currently use */
+isa active_isa();
+
+/* restrict the networks to an instruction set, returns the new active_isa() */
+isa set_isa(isa requested);
+
+void simd_sort8(std::int32_t* first);
+void simd_sort8(float* first);
+void simd_sort16(std::int32_t* first);
+void simd_sort16(float* first);
+
+/*
+ * Sort first[0..n) for a size known only at run time: n <= 32 jumps to
+ * the network for n (int32 and float keys of 8 or 16 go through the
+ * SIMD versions), anything larger is handed to std::sort.
+ */
+template<class T, class Compare = std::less<>>
+constexpr void sort_small(T* first, std::size_t n, Compare comp = Compare())
+{
+	if (n > max_size)
+	{
+		std::sort(first, first + n, comp);
+		return;
+	}
+
+	constexpr bool simd_keys = (std::is_same_v<T, std::int32_t> || std::is_same_v<T, float>) &&
+		(std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>);
+	if constexpr (simd_keys)
+	{
+		if (!std::is_constant_evaluated())
+		{
+			if (n == 8) return simd_sort8(first);
+			if (n == 16) return simd_sort16(first);
+		}
+	}
+
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		(void)((n == I ? (sort<I>(first, comp), true) : false) || ...);
+	}(std::make_index_sequence<max_size + 1>{});
+}
+
+} // sorting_network
+
 } // constexpr_ns
 } // cxx17
+
+using cxx20::constexpr_ns::specialization::specialize;
+
 } // pluto
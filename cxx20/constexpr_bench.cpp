@@ -0,0 +1,201 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 16:48:52
+ * @brief
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+
+#include "constexpr.h"
+
+using namespace std;
+using namespace pluto::cxx20::constexpr_ns::string_hash;
+namespace sn = pluto::cxx20::constexpr_ns::sorting_network;
+
+namespace
+{
+
+const vector<string> names = {
+	"get", "set", "del", "list", "watch", "unwatch", "expire", "persist",
+};
+
+/* a command stream, one in eight is unknown */
+vector<string> random_commands(size_t n)
+{
+	std::mt19937 gen(7);
+	vector<string> cmds(n);
+	for (auto& c : cmds)
+	{
+		auto i = gen() % (names.size() + 1);
+		c = i < names.size() ? names[i] : "unknown";
+	}
+	return cmds;
+}
+
+int by_if_chain(const string& cmd)
+{
+	if (cmd == "get") return 1;
+	else if (cmd == "set") return 2;
+	else if (cmd == "del") return 3;
+	else if (cmd == "list") return 4;
+	else if (cmd == "watch") return 5;
+	else if (cmd == "unwatch") return 6;
+	else if (cmd == "expire") return 7;
+	else if (cmd == "persist") return 8;
+	return 0;
+}
+
+constexpr string_keys commands{ "get", "set", "del", "list", "watch", "unwatch", "expire", "persist" };
+
+int by_hash_switch(const string& cmd)
+{
+	switch (commands.find(cmd))
+	{
+	case "get"_hash: return 1;
+	case "set"_hash: return 2;
+	case "del"_hash: return 3;
+	case "list"_hash: return 4;
+	case "watch"_hash: return 5;
+	case "unwatch"_hash: return 6;
+	case "expire"_hash: return 7;
+	case "persist"_hash: return 8;
+	default: return 0;
+	}
+}
+
+} // namespace
+
+static void BM_DispatchIfChain(benchmark::State& state)
+{
+	auto cmds = random_commands(4096);
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (const auto& c : cmds) sum += by_if_chain(c);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cmds.size()));
+}
+BENCHMARK(BM_DispatchIfChain);
+
+static void BM_DispatchUnorderedMap(benchmark::State& state)
+{
+	unordered_map<string, function<int()>> table;
+	for (size_t i = 0; i < names.size(); ++i)
+	{
+		table.emplace(names[i], [i] { return static_cast<int>(i + 1); });
+	}
+
+	auto cmds = random_commands(4096);
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (const auto& c : cmds)
+		{
+			auto it = table.find(c);
+			sum += it != table.end() ? it->second() : 0;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cmds.size()));
+}
+BENCHMARK(BM_DispatchUnorderedMap);
+
+static void BM_DispatchHashSwitch(benchmark::State& state)
+{
+	auto cmds = random_commands(4096);
+	for (auto _ : state)
+	{
+		int sum = 0;
+		for (const auto& c : cmds) sum += by_hash_switch(c);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cmds.size()));
+}
+BENCHMARK(BM_DispatchHashSwitch);
+
+// sorting networks, many small arrays of N keys each
+
+namespace
+{
+
+template<class T>
+vector<T> random_keys(size_t n)
+{
+	std::mt19937 gen(11);
+	vector<T> v(n);
+	for (auto& x : v) x = static_cast<T>(static_cast<int32_t>(gen() % 100000));
+	return v;
+}
+
+template<class T>
+void insertion_sort(T* first, size_t n)
+{
+	for (size_t i = 1; i < n; ++i)
+	{
+		T x = first[i];
+		size_t j = i;
+		for (; j > 0 && x < first[j - 1]; --j) first[j] = first[j - 1];
+		first[j] = x;
+	}
+}
+
+enum class method { std_sort, insertion, network, sort_small, simd };
+
+} // namespace
+
+template<class T, size_t N, method M>
+static void BM_SmallSort(benchmark::State& state)
+{
+	const auto keys = random_keys<T>(N * 1024);
+	auto work = keys;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		work = keys;
+		state.ResumeTiming();
+		for (size_t i = 0; i < work.size(); i += N)
+		{
+			T* p = work.data() + i;
+			if constexpr (M == method::std_sort) std::sort(p, p + N);
+			if constexpr (M == method::insertion) insertion_sort(p, N);
+			if constexpr (M == method::network) sn::sort<N>(p);
+			if constexpr (M == method::sort_small) sn::sort_small(p, N);
+			if constexpr (M == method::simd)
+			{
+				if constexpr (N == 8) sn::simd_sort8(p);
+				else sn::simd_sort16(p);
+			}
+		}
+		benchmark::DoNotOptimize(work.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(work.size() / N));
+}
+
+#define PLUTO_SMALL_SORT_BENCH(T, N)									\
+BENCHMARK_TEMPLATE(BM_SmallSort, T, N, method::std_sort);				\
+BENCHMARK_TEMPLATE(BM_SmallSort, T, N, method::insertion);				\
+BENCHMARK_TEMPLATE(BM_SmallSort, T, N, method::network);				\
+BENCHMARK_TEMPLATE(BM_SmallSort, T, N, method::sort_small)
+
+PLUTO_SMALL_SORT_BENCH(int32_t, 4);
+PLUTO_SMALL_SORT_BENCH(int32_t, 8);
+PLUTO_SMALL_SORT_BENCH(int32_t, 16);
+PLUTO_SMALL_SORT_BENCH(int32_t, 32);
+PLUTO_SMALL_SORT_BENCH(float, 8);
+PLUTO_SMALL_SORT_BENCH(float, 16);
+BENCHMARK_TEMPLATE(BM_SmallSort, int32_t, 8, method::simd);
+BENCHMARK_TEMPLATE(BM_SmallSort, int32_t, 16, method::simd);
+BENCHMARK_TEMPLATE(BM_SmallSort, float, 8, method::simd);
+BENCHMARK_TEMPLATE(BM_SmallSort, float, 16, method::simd);
+
+#undef PLUTO_SMALL_SORT_BENCH
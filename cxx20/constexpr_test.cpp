@@ -5,7 +5,15 @@
  * @brief
  */
 
+#include <cctype>
+#include <cmath>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <array>
+#include <random>
+#include <algorithm>
 #include <gtest/gtest.h>
 
 #include "constexpr.h"
@@ -29,4 +37,305 @@ TEST(PLUTO, CXX20_CONST_EXPR) {
 	auto b = f("123");
 	cout << typeid(b).name() << " " << b << endl;
 
-}
\ No newline at end of file
+}
+
+using namespace pluto::cxx20::constexpr_ns::tables;
+
+TEST(PLUTO, CXX20_CONST_EXPR_TABLE) {
+
+	{
+		// everything below is checked by the compiler
+		constexpr auto squares = make_table<16>([](std::size_t i) { return i * i; });
+		static_assert(squares[15] == 225);
+
+		static_assert(crc32("123456789") == 0xCBF43926u);
+		static_assert(crc32c("123456789") == 0xE3069283u);
+		static_assert(popcount8_table[0xff] == 8 && popcount8_table[0x5a] == 4);
+		static_assert(bit_reverse8_table[0x01] == 0x80);
+		static_assert(reverse_bits(0x00000001u) == 0x80000000u);
+		static_assert(has_class('7', cc_digit) && !has_class('x', cc_digit));
+		static_assert(has_class('_', cc_ident) && has_class('\n', cc_space));
+		static_assert(sin_q15(64) == 32767 && sin_q15(0) == 0 && sin_q15(192) == -32767);
+		static_assert(log2_q16(1) == 0 && log2_q16(1024) == (10u << 16));
+		static_assert(log2_q16(0) == 0);
+
+		TEST_COUT << hex << crc32("123456789") << dec << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// the runtime lookups agree with the math library
+		for (int a = 0; a < 256; ++a)
+		{
+			double expected = std::sin(2 * 3.14159265358979323846 * a / 256) * 32767;
+			EXPECT_NEAR(expected, sin_q15(static_cast<std::uint8_t>(a)), 1.0);
+		}
+
+		for (std::uint32_t x : { 3u, 10u, 1000u, 123456u, 0xffffffffu })
+		{
+			EXPECT_NEAR(std::log2(x), log2_q16(x) / 65536.0, 1e-4) << x;
+		}
+		volatile std::uint32_t zero = 0;
+		EXPECT_EQ(0u, log2_q16(zero));
+
+		for (int c = 0; c < 256; ++c)
+		{
+			EXPECT_EQ(std::isdigit(c) != 0, has_class(static_cast<char>(c), cc_digit));
+			EXPECT_EQ(std::isxdigit(c) != 0, has_class(static_cast<char>(c), cc_xdigit));
+			EXPECT_EQ(std::isspace(c) != 0, has_class(static_cast<char>(c), cc_space));
+			EXPECT_EQ(std::ispunct(c) != 0, has_class(static_cast<char>(c), cc_punct));
+		}
+	}
+}
+
+using namespace pluto::cxx20::constexpr_ns::string_hash;
+
+namespace {
+
+constexpr string_keys commands{ "get", "set", "del", "list" };
+
+int dispatch(std::string_view cmd)
+{
+	switch (commands.find(cmd))
+	{
+	case "get"_hash: return 1;
+	case "set"_hash: return 2;
+	case "del"_hash: return 3;
+	case "list"_hash: return 4;
+	default: return 0;
+	}
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_CONST_EXPR_STRING_HASH) {
+
+	{
+		// FNV-1a reference values
+		static_assert(fnv1a("") == 0xcbf29ce484222325ull);
+		static_assert(fnv1a("a") == 0xaf63dc4c8601ec8cull);
+		static_assert(fnv1a("foobar") == 0x85944171f73967e8ull);
+		static_assert("get"_hash == fnv1a("get"));
+		static_assert(commands.size() == 4 && commands.contains("del") && !commands.contains("put"));
+
+		TEST_COUT << hex << "get"_hash.hash << dec << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		EXPECT_EQ(1, dispatch("get"));
+		EXPECT_EQ(2, dispatch(std::string("set")));
+		EXPECT_EQ(3, dispatch("del"));
+		EXPECT_EQ(4, dispatch("list"));
+		EXPECT_EQ(0, dispatch("put"));
+		EXPECT_EQ(0, dispatch(""));
+		EXPECT_EQ(0, dispatch("gett"));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// a hash hit alone is not trusted, the text is compared too
+		constexpr hashed_string forged{ fnv1a("get"), "not get" };
+		EXPECT_FALSE(forged.matches("get"));
+		EXPECT_TRUE("get"_hash.matches("get"));
+
+		// colliding labels do not compile:
+		//	constexpr string_keys twice{ "get", "get" };
+	}
+}
+
+using namespace pluto::cxx20::constexpr_ns::specialization;
+
+namespace {
+
+enum class width { w8, w16, w32 };
+
+/* sum of every stride-th element, S is a compile time constant */
+template<std::size_t S>
+int strided_sum(const std::vector<int>& v)
+{
+	int sum = 0;
+	for (std::size_t i = 0; i < v.size(); i += S) sum += v[i];
+	return sum;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_CONST_EXPR_SPECIALIZE) {
+
+	{
+		// consecutive values, the index is v - 1
+		for (int v = 1; v <= 4; ++v)
+		{
+			int got = pluto::specialize<1, 2, 3, 4>(v, []<int V>() { return V * 10; });
+			EXPECT_EQ(v * 10, got);
+		}
+
+		// sparse values, with an unsigned runtime value
+		std::vector<int> data(64);
+		for (std::size_t i = 0; i < data.size(); ++i) data[i] = static_cast<int>(i);
+
+		for (std::size_t stride : { 1u, 2u, 4u, 8u })
+		{
+			int got = pluto::specialize<1, 2, 4, 8>(stride, [&]<int S>() { return strided_sum<S>(data); });
+			int expected = 0;
+			for (std::size_t i = 0; i < data.size(); i += stride) expected += data[i];
+			EXPECT_EQ(expected, got);
+		}
+
+		TEST_COUT << pluto::specialize<1, 2, 4, 8>(4, [&]<int S>() { return strided_sum<S>(data); }) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// cartesian product of two lists, mixing enums and integers
+		auto name = [](width w, int unroll) {
+			return specialize<values<width::w8, width::w16, width::w32>, values<1, 2, 4>>(w, unroll,
+				[]<width W, int U>() { return std::to_string(8 << static_cast<int>(W)) + "x" + std::to_string(U); });
+		};
+
+		EXPECT_EQ("8x1", name(width::w8, 1));
+		EXPECT_EQ("16x4", name(width::w16, 4));
+		EXPECT_EQ("32x2", name(width::w32, 2));
+
+		TEST_COUT << name(width::w32, 4) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// void results and values outside the list
+		int calls = 0;
+		pluto::specialize<-1, 0, 1>(-1, [&]<int V>() { calls += V == -1; });
+		EXPECT_EQ(1, calls);
+
+		EXPECT_THROW((pluto::specialize<1, 2, 4>(3, []<int>() {})), std::out_of_range);
+		EXPECT_THROW((pluto::specialize<1, 2, 3>(-1, []<int>() {})), std::out_of_range);
+		EXPECT_THROW((pluto::specialize<1, 2, 3>(4u, []<int>() {})), std::out_of_range);
+		EXPECT_THROW((specialize<values<1, 2>, values<3, 4>>(1, 5, []<int, int>() {})), std::out_of_range);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// bool flags and character keys compare with ==
+		for (bool flag : { false, true })
+		{
+			bool got = pluto::specialize<false, true>(flag, []<bool B>() { return B; });
+			EXPECT_EQ(flag, got);
+		}
+
+		for (char c : { 'a', 'b', 'x' })
+		{
+			char got = pluto::specialize<'a', 'b', 'x'>(c, []<char C>() { return C; });
+			EXPECT_EQ(c, got);
+		}
+
+		EXPECT_EQ(2, (pluto::specialize<'a', 'b'>('b', []<char C>() { return C - 'a' + 1; })));
+		EXPECT_THROW((pluto::specialize<'a', 'b'>('c', []<char>() {})), std::out_of_range);
+	}
+}
+
+namespace sn = pluto::cxx20::constexpr_ns::sorting_network;
+
+namespace {
+
+/* 0-1 principle: a network sorts everything iff it sorts every 0/1 input */
+template<std::size_t N>
+bool sorts_all_binary_inputs()
+{
+	for (std::uint32_t bits = 0; bits < (1u << N); ++bits)
+	{
+		std::array<int, N> a{};
+		for (std::size_t i = 0; i < N; ++i) a[i] = (bits >> i) & 1;
+		sn::sort(a);
+		if (!std::is_sorted(a.begin(), a.end())) return false;
+	}
+	return true;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_CONST_EXPR_SORTING_NETWORK) {
+
+	{
+		constexpr auto a = sn::sorted(std::array{ 5, 3, 9, 1, 7 });
+		static_assert(a == std::array{ 1, 3, 5, 7, 9 });
+		static_assert(sn::network<4>.size() == 5 && sn::depth<4>() == 3);
+		static_assert(sn::network<8>.size() == 19 && sn::depth<8>() == 6);
+		static_assert(sn::network<16>.size() == 63 && sn::depth<16>() == 10);
+
+		TEST_COUT << "32 elements: " << sn::network<32>.size() << " steps, depth " << sn::depth<32>() << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		auto failed = []<std::size_t... N>(std::index_sequence<N...>) {
+			std::vector<std::size_t> sizes;
+			((sorts_all_binary_inputs<N>() ? void() : sizes.push_back(N)), ...);
+			return sizes;
+		}(std::make_index_sequence<17>{});
+		EXPECT_TRUE(failed.empty());
+
+		// the larger ones and the run time entry point on random data
+		std::mt19937 gen(3);
+		for (std::size_t n = 0; n <= 40; ++n)
+		{
+			for (int round = 0; round < 50; ++round)
+			{
+				std::vector<int> v(n);
+				for (auto& x : v) x = static_cast<int>(gen() % 100);
+				auto expected = v;
+				std::sort(expected.begin(), expected.end());
+				sn::sort_small(v.data(), n);
+				EXPECT_EQ(expected, v) << n;
+			}
+		}
+
+		// custom comparator, descending strings
+		std::array<std::string, 5> s{ "b", "d", "a", "e", "c" };
+		sn::sort(s, std::greater<>());
+		EXPECT_EQ((std::array<std::string, 5>{ "e", "d", "c", "b", "a" }), s);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// every instruction set the machine has agrees with std::sort
+		std::mt19937 gen(4);
+		for (sn::isa isa : { sn::isa::scalar, sn::isa::avx2 })
+		{
+			if (sn::set_isa(isa) != isa) continue;
+			for (int round = 0; round < 200; ++round)
+			{
+				std::array<std::int32_t, 16> i16;
+				std::array<float, 16> f16;
+				for (auto& x : i16) x = static_cast<std::int32_t>(gen()) >> (round % 28);
+				for (auto& x : f16) x = static_cast<float>(static_cast<std::int32_t>(gen())) / 1024.0f;
+
+				auto i8 = i16, ei8 = i16, ei16 = i16;
+				auto f8 = f16, ef8 = f16, ef16 = f16;
+				std::sort(ei8.begin(), ei8.begin() + 8);
+				std::sort(ef8.begin(), ef8.begin() + 8);
+				std::sort(ei16.begin(), ei16.end());
+				std::sort(ef16.begin(), ef16.end());
+
+				sn::simd_sort8(i8.data());
+				sn::simd_sort8(f8.data());
+				sn::simd_sort16(i16.data());
+				sn::sort_small(f16.data(), 16);
+
+				EXPECT_EQ(ei8, i8) << sn::isa_name(isa);
+				EXPECT_EQ(ef8, f8) << sn::isa_name(isa);
+				EXPECT_EQ(ei16, i16) << sn::isa_name(isa);
+				EXPECT_EQ(ef16, f16) << sn::isa_name(isa);
+			}
+		}
+		sn::set_isa(sn::detected_isa());
+	}
+}
@@ -0,0 +1,134 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 05:08:44
+ * @brief
+ */
+
+#include "coroutine.h"
+
+#include <new>
+
+namespace pluto
+{
+namespace cxx20
+{
+namespace coroutine
+{
+namespace detail
+{
+namespace
+{
+
+constexpr std::size_t frame_granularity = 64;
+constexpr std::size_t frame_classes = 16;	// frames up to 1 KiB are cached
+constexpr std::size_t frames_per_class = 32;
+
+struct free_frame
+{
+	free_frame* next;
+};
+
+class frame_cache
+{
+public:
+	~frame_cache()
+	{
+		for (auto& list : lists_)
+		{
+			while (list.head != nullptr)
+			{
+				::operator delete(std::exchange(list.head, list.head->next));
+			}
+		}
+	}
+
+	void* allocate(std::size_t size)
+	{
+		const std::size_t c = size_class(size);
+		if (c >= frame_classes) return ::operator new(size);
+		auto& list = lists_[c];
+		if (list.head == nullptr) return ::operator new((c + 1) * frame_granularity);
+		--list.count;
+		return std::exchange(list.head, list.head->next);
+	}
+
+	void deallocate(void* frame, std::size_t size) noexcept
+	{
+		const std::size_t c = size_class(size);
+		if (c >= frame_classes || lists_[c].count == frames_per_class)
+		{
+			::operator delete(frame);
+			return;
+		}
+		auto& list = lists_[c];
+		list.head = ::new (frame) free_frame{ list.head };
+		++list.count;
+	}
+
+private:
+	static std::size_t size_class(std::size_t size) noexcept
+	{
+		return (size - 1) / frame_granularity;
+	}
+
+	struct list
+	{
+		free_frame* head = nullptr;
+		std::size_t count = 0;
+	};
+
+	list lists_[frame_classes];
+};
+
+frame_cache& cache()
+{
+	thread_local frame_cache c;
+	return c;
+}
+
+struct student_row
+{
+	double gpa;
+	char grade;
+	const char* name;
+};
+
+constexpr student_row student_rows[] = {
+	{ 3.8, 'A', "Lisa Simpson" },
+	{ 2.9, 'C', "Milhouse Van Houten" },
+	{ 1.7, 'D', "Ralph Wiggum" },
+};
+
+} // namespace
+
+void* allocate_frame(std::size_t size)
+{
+	return cache().allocate(size);
+}
+
+/* a frame freed on another thread than it was allocated on joins this thread's cache */
+void deallocate_frame(void* frame, std::size_t size) noexcept
+{
+	cache().deallocate(frame, size);
+}
+
+} // detail
+
+generator<const student&> students(int count)
+{
+	student s;
+	for (int id = 0; id < count; ++id)
+	{
+		const auto& row = detail::student_rows[id % std::size(detail::student_rows)];
+		auto& [gpa, grade, name] = s;
+		gpa = row.gpa;
+		grade = row.grade;
+		name.assign(row.name);
+		co_yield s;
+	}
+}
+
+} // coroutine
+} // cxx20
+} // pluto
@@ -0,0 +1,289 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 05:08:44
+ * @brief
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pluto
+{
+namespace cxx20
+{
+namespace coroutine
+{
+
+/*
+ * generator<T> is a coroutine that hands out a sequence lazily, one
+ * co_yield at a time, so a producer can stream records straight into
+ * a consumer instead of collecting them in a std::vector first:
+ *
+ *		generator<const student&> students(int count)
+ *		{
+ *			student s;
+ *			for (int id = 0; id < count; ++id)
+ *			{
+ *				fill(s, id);	// reuses s and its string buffer
+ *				co_yield s;
+ *			}
+ *		}
+ *
+ *		for (const auto& [gpa, grade, name] : students(1'000'000)
+ *			| filter([](const student& s) { return std::get<1>(s) != 'D'; })
+ *			| take(10))
+ *			...
+ *
+ * Iteration yields references: co_yield stores the address of its
+ * operand in the promise and the iterator dereferences it, nothing is
+ * copied. An lvalue stays valid as long as the coroutine keeps it, a
+ * temporary (co_yield f(x)) until the iterator is incremented, because
+ * it lives to the end of the co_yield expression, across the suspend.
+ *
+ * generator<T> yields T&, generator<const T&> yields const T&; both
+ * accept lvalues and temporaries, generator<T&> only lvalues.
+ *
+ * The coroutine frame is the only allocation, once per generator, and
+ * it comes from a per-thread cache of recently freed frames, so a
+ * pipeline of adaptors built per request reuses the same few blocks.
+ *
+ * filter, transform and take are coroutines themselves, composed with
+ * operator| like the std::views adaptors; each stage costs one resume
+ * per element it passes on. An exception thrown by the body propagates
+ * out of begin() or operator++.
+ */
+
+namespace detail
+{
+
+/* per-thread free lists of coroutine frames, by size rounded up to 64 bytes */
+void* allocate_frame(std::size_t size);
+void deallocate_frame(void* frame, std::size_t size) noexcept;
+
+} // detail
+
+template<class T>
+class generator
+{
+	static_assert(!std::is_rvalue_reference_v<T>, "generator<T&&> is not supported");
+
+public:
+	using value_type = std::remove_cvref_t<T>;
+	using reference = std::conditional_t<std::is_reference_v<T>, T, T&>;
+	using pointer = std::add_pointer_t<reference>;
+
+	class promise_type
+	{
+	public:
+		static void* operator new(std::size_t size)
+		{
+			return detail::allocate_frame(size);
+		}
+
+		static void operator delete(void* frame, std::size_t size) noexcept
+		{
+			detail::deallocate_frame(frame, size);
+		}
+
+		generator get_return_object() noexcept
+		{
+			return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		std::suspend_always final_suspend() const noexcept { return {}; }
+
+		std::suspend_always yield_value(std::remove_reference_t<reference>& value) noexcept
+		{
+			value_ = std::addressof(value);
+			return {};
+		}
+
+		std::suspend_always yield_value(std::remove_reference_t<reference>&& value) noexcept
+			requires (!std::is_lvalue_reference_v<T> || std::is_const_v<std::remove_reference_t<T>>)
+		{
+			value_ = std::addressof(value);
+			return {};
+		}
+
+		void return_void() const noexcept {}
+
+		void unhandled_exception() noexcept
+		{
+			exception_ = std::current_exception();
+		}
+
+		/* no co_await inside a generator, only co_yield */
+		template<class U>
+		std::suspend_never await_transform(U&&) = delete;
+
+	private:
+		friend class generator;
+
+		void rethrow()
+		{
+			if (exception_) std::rethrow_exception(std::exchange(exception_, nullptr));
+		}
+
+		pointer value_ = nullptr;
+		std::exception_ptr exception_;
+	};
+
+	class iterator
+	{
+	public:
+		using value_type = generator::value_type;
+		using reference = generator::reference;
+		using difference_type = std::ptrdiff_t;
+		using iterator_concept = std::input_iterator_tag;
+
+		iterator() = default;
+
+		reference operator*() const noexcept
+		{
+			return static_cast<reference>(*handle_.promise().value_);
+		}
+
+		iterator& operator++()
+		{
+			handle_.resume();
+			handle_.promise().rethrow();
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+		{
+			return it.handle_.done();
+		}
+
+	private:
+		friend class generator;
+
+		explicit iterator(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+		std::coroutine_handle<promise_type> handle_;
+	};
+
+	generator(generator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+	generator& operator=(generator other) noexcept
+	{
+		std::swap(handle_, other.handle_);
+		return *this;
+	}
+
+	~generator()
+	{
+		if (handle_) handle_.destroy();
+	}
+
+	/* starts the body, runs it to the first co_yield; call once */
+	iterator begin()
+	{
+		handle_.resume();
+		handle_.promise().rethrow();
+		return iterator(handle_);
+	}
+
+	std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+	explicit generator(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+	std::coroutine_handle<promise_type> handle_;
+};
+
+template<class Pred>
+struct filter_closure
+{
+	Pred pred;
+};
+
+template<class F>
+struct transform_closure
+{
+	F f;
+};
+
+struct take_closure
+{
+	std::size_t count;
+};
+
+/* keeps the elements pred returns true for */
+template<class Pred>
+filter_closure<std::decay_t<Pred>> filter(Pred&& pred)
+{
+	return { std::forward<Pred>(pred) };
+}
+
+/* yields f(element); a reference result is passed on, a value lives until the next element */
+template<class F>
+transform_closure<std::decay_t<F>> transform(F&& f)
+{
+	return { std::forward<F>(f) };
+}
+
+/* the first count elements, the source is not resumed for the one after */
+inline take_closure take(std::size_t count)
+{
+	return { count };
+}
+
+template<class T, class F>
+using transform_result_t = std::invoke_result_t<F&, typename generator<T>::reference>;
+
+template<class T, class Pred>
+generator<T> operator|(generator<T> source, filter_closure<Pred> c)
+{
+	for (auto&& element : source)
+	{
+		if (std::invoke(c.pred, std::as_const(element))) co_yield static_cast<typename generator<T>::reference>(element);
+	}
+}
+
+template<class T, class F>
+generator<transform_result_t<T, F>> operator|(generator<T> source, transform_closure<F> c)
+{
+	for (auto&& element : source)
+	{
+		co_yield std::invoke(c.f, static_cast<typename generator<T>::reference>(element));
+	}
+}
+
+template<class T>
+generator<T> operator|(generator<T> source, take_closure c)
+{
+	if (c.count == 0) co_return;
+	for (auto&& element : source)
+	{
+		co_yield static_cast<typename generator<T>::reference>(element);
+		if (--c.count == 0) co_return;
+	}
+}
+
+/* gpa, grade, name, as cxx17::tuple::get_student() returns them */
+using student = std::tuple<double, char, std::string>;
+
+/*
+ * count student records streamed from one reused tuple, the name
+ * string keeps its capacity, so the steady state allocates nothing
+ */
+generator<const student&> students(int count);
+
+} // coroutine
+} // cxx20
+} // pluto
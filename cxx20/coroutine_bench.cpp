@@ -0,0 +1,104 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 05:52:30
+ * @brief
+ */
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "coroutine.h"
+#include "cxx17/tuple.h"
+
+using namespace std;
+using namespace pluto::cxx20::coroutine;
+
+namespace
+{
+
+/* the batch job: average gpa of the students that passed */
+bool passed(const student& s) { return get<1>(s) != 'D'; }
+
+double gpa_of(const student& s) { return get<0>(s); }
+
+} // namespace
+
+/* collect every record into a vector first, then process it */
+static void BM_VectorStudents(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		vector<student> all;
+		for (int id = 0; id < n; ++id) all.push_back(pluto::cxx17::tuple::get_student(id % 3));
+		double total = 0;
+		int count = 0;
+		for (const auto& s : all)
+		{
+			if (!passed(s)) continue;
+			total += gpa_of(s);
+			++count;
+		}
+		benchmark::DoNotOptimize(total / count);
+		bytes = all.capacity() * sizeof(student);
+	}
+	state.counters["held_bytes"] = static_cast<double>(bytes);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* stream the records through the same loop, one at a time */
+static void BM_GeneratorStudents(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		double total = 0;
+		int count = 0;
+		for (const auto& s : students(n))
+		{
+			if (!passed(s)) continue;
+			total += gpa_of(s);
+			++count;
+		}
+		benchmark::DoNotOptimize(total / count);
+	}
+	state.counters["held_bytes"] = static_cast<double>(sizeof(student));
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* the same as a pipeline of adaptors, three more coroutines per run */
+static void BM_GeneratorPipeline(benchmark::State& state)
+{
+	const int n = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		double total = 0;
+		int count = 0;
+		for (double gpa : students(n) | filter(passed) | transform(gpa_of))
+		{
+			total += gpa;
+			++count;
+		}
+		benchmark::DoNotOptimize(total / count);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+/* a short generator per request: the frame comes from the per-thread cache */
+static void BM_GeneratorShort(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		for (const auto& s : students(3) | take(2)) benchmark::DoNotOptimize(&s);
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(BM_VectorStudents)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_GeneratorStudents)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_GeneratorPipeline)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_GeneratorShort);
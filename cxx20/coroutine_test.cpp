@@ -0,0 +1,163 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 05:36:15
+ * @brief
+ */
+
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "coroutine.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx20::coroutine;
+
+namespace
+{
+
+/* counts copies, a generator pipeline should not make any */
+struct record
+{
+	static inline int copies = 0;
+
+	int id;
+
+	explicit record(int i) : id(i) {}
+	record(const record& other) : id(other.id) { ++copies; }
+	record& operator=(const record& other) { id = other.id; ++copies; return *this; }
+};
+
+generator<int> iota(int first, int last, int* started = nullptr)
+{
+	if (started != nullptr) ++*started;
+	for (int i = first; i < last; ++i) co_yield i;
+}
+
+generator<int&> elements(vector<int>& v)
+{
+	for (int& x : v) co_yield x;
+}
+
+generator<const record&> records(int count, int* produced)
+{
+	record r(0);
+	for (int i = 0; i < count; ++i)
+	{
+		r.id = i;
+		++*produced;
+		co_yield r;
+	}
+}
+
+generator<string> throws_after(int n)
+{
+	for (int i = 0; i < n; ++i) co_yield to_string(i);
+	throw runtime_error("source failed");
+}
+
+template<class G>
+auto collect(G&& g)
+{
+	vector<typename remove_cvref_t<G>::value_type> out;
+	for (auto&& x : g) out.push_back(x);
+	return out;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_COROUTINE) {
+
+	static_assert(ranges::input_range<generator<int>>);
+	static_assert(is_same_v<generator<int>::reference, int&>);
+	static_assert(is_same_v<generator<const string&>::reference, const string&>);
+
+	/* lazy, the body runs when iteration starts */
+	{
+		int started = 0;
+		auto g = iota(0, 5, &started);
+		EXPECT_EQ(started, 0);
+		EXPECT_EQ(collect(g), (vector<int>{ 0, 1, 2, 3, 4 }));
+		EXPECT_EQ(started, 1);
+		EXPECT_TRUE(collect(iota(3, 3)).empty());
+	}
+
+	/* generator<int&> hands out the elements themselves */
+	{
+		vector<int> v{ 1, 2, 3 };
+		for (int& x : elements(v)) x *= 10;
+		EXPECT_EQ(v, (vector<int>{ 10, 20, 30 }));
+	}
+
+	/* references all the way through the adaptors, no copies */
+	{
+		record::copies = 0;
+		int produced = 0;
+		int sum = 0;
+		for (const record& r : records(100, &produced)
+			| filter([](const record& r) { return r.id % 2 == 0; })
+			| take(5))
+		{
+			sum += r.id;
+		}
+		EXPECT_EQ(sum, 0 + 2 + 4 + 6 + 8);
+		EXPECT_EQ(record::copies, 0);
+		/* take stops at its last element, the source is not asked for the next */
+		EXPECT_EQ(produced, 9);
+	}
+
+	/* transform, to a value and to a reference into the element */
+	{
+		EXPECT_EQ(collect(iota(0, 4) | transform([](int i) { return i * i; })), (vector<int>{ 0, 1, 4, 9 }));
+
+		vector<string> names;
+		for (const string& name : students(7)
+			| filter([](const student& s) { return get<1>(s) != 'D'; })
+			| transform([](const student& s) -> const string& { return get<2>(s); })
+			| take(3))
+		{
+			names.push_back(name);
+		}
+		EXPECT_EQ(names, (vector<string>{ "Lisa Simpson", "Milhouse Van Houten", "Lisa Simpson" }));
+
+		double total = 0;
+		int count = 0;
+		for (const auto& [gpa, grade, name] : students(300))
+		{
+			total += gpa;
+			++count;
+		}
+		EXPECT_EQ(count, 300);
+		EXPECT_NEAR(total, 100 * (3.8 + 2.9 + 1.7), 1e-9);
+	}
+
+	/* take(0) never starts the source */
+	{
+		int started = 0;
+		EXPECT_TRUE(collect(iota(0, 5, &started) | take(0)).empty());
+		EXPECT_EQ(started, 0);
+	}
+
+	/* an exception in the body comes out of operator++, through the adaptors too */
+	{
+		vector<string> seen;
+		EXPECT_THROW(for (auto& s : throws_after(2)) seen.push_back(s), runtime_error);
+		EXPECT_EQ(seen, (vector<string>{ "0", "1" }));
+
+		EXPECT_THROW(collect(throws_after(0) | filter([](const string&) { return true; })), runtime_error);
+	}
+
+	/* a freed frame is handed out again for the next frame of its size class */
+	{
+		void* a = detail::allocate_frame(200);
+		detail::deallocate_frame(a, 200);
+		void* b = detail::allocate_frame(240);
+		EXPECT_EQ(a, b);
+		detail::deallocate_frame(b, 240);
+	}
+}
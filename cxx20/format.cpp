@@ -0,0 +1,56 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 00:41:07
+ * @brief
+ */
+
+#include "format.h"
+
+#include <ostream>
+
+namespace pluto
+{
+namespace cxx20
+{
+namespace format
+{
+namespace detail
+{
+
+char* pad_number(char* out, const char* text, std::size_t n, std::size_t width, bool zero)
+{
+	const std::size_t fill = width > n ? width - n : 0;
+	if (zero && fill != 0 && n != 0 && (text[0] == '-' || text[0] == '+'))
+	{
+		*out++ = *text++;
+		--n;
+	}
+	std::memset(out, zero ? '0' : ' ', fill);
+	std::memcpy(out + fill, text, n);
+	return out + fill + n;
+}
+
+char* pad_string(char* out, const char* text, std::size_t n, std::size_t width)
+{
+	const std::size_t fill = width > n ? width - n : 0;
+	std::memcpy(out, text, n);
+	std::memset(out + n, ' ', fill);
+	return out + n + fill;
+}
+
+std::string& print_buffer()
+{
+	thread_local std::string buf;
+	return buf;
+}
+
+void write(std::ostream& os, const std::string& text)
+{
+	os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+} // detail
+} // format
+} // cxx20
+} // pluto
@@ -0,0 +1,449 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 00:41:07
+ * @brief
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pluto
+{
+namespace cxx20
+{
+namespace format
+{
+
+/*
+ * Compile-time format strings :
+ *
+ * fold_expression::printer and every operator<< chain decide again on
+ * each call how to format each argument: a virtual call into the stream
+ * buffer, the locale's num_put, a look at the flags. snprintf parses its
+ * format string on every call. When the format string is a literal, all
+ * of that is known while compiling:
+ *
+ *		std::string s = format<"{} took {:.3f} ms, flags {:x}">(name, ms, flags);
+ *
+ * The string is a template argument (fixed_string, a class type used as
+ * a non-type template parameter). parse() runs in the compiler and turns
+ * it into a plan: the literal text with {{ and }} unescaped, and for each
+ * placeholder its spec and the literal in front of it. The plan is
+ * checked against the argument types, so a wrong argument count or a
+ * spec the type cannot take does not compile:
+ *
+ *		format<"{} {}">(1);		// placeholder count does not match the argument count
+ *		format<"{:x}">(1.5);	// floating point takes f, e or g
+ *
+ * What is left at run time are the plan's steps, unrolled: size the
+ * output once, memcpy a literal of a known length, std::to_chars an
+ * argument with the base / format / precision baked in, and so on. No
+ * parsing, no stream, no locale.
+ *
+ * The syntax is a subset of std::format, which GCC 12 does not ship:
+ *
+ *		{} or {:[0][width][.precision][type]}
+ *
+ *	integers	d (default), x, o, b; width pads on the left, 0 pads with zeros after the sign
+ *	floats		shortest round trip by default, precision alone means g; f, e, g (precision 6)
+ *	bool		true / false
+ *	char		the character
+ *	strings		s; precision cuts the text, width pads on the right
+ *	others		anything with an operator<<, through an ostringstream; empty spec only
+ *
+ * Positional arguments ({0}), fill characters and alignment are not
+ * supported.
+ */
+
+template<std::size_t N>
+struct fixed_string
+{
+	char text[N]{};
+
+	consteval fixed_string(const char (&s)[N]) { std::copy_n(s, N, text); }
+
+	constexpr std::string_view view() const { return { text, N - 1 }; }
+};
+
+/* what follows the ':' of a placeholder */
+struct spec
+{
+	char type = 0;				// 0: the default for the argument's type
+	bool zero = false;
+	std::uint16_t width = 0;
+	std::int16_t precision = -1;	// -1: none given
+};
+
+/* one placeholder: the literal text before it, then the argument */
+struct step
+{
+	std::size_t literal_begin;
+	std::size_t literal_length;
+	spec arg;
+};
+
+template<std::size_t Chars, std::size_t Args>
+struct plan
+{
+	std::array<char, Chars> literals{};	// every literal, unescaped, back to back
+	std::array<step, Args> steps{};
+	std::size_t tail_begin = 0;			// the literal after the last placeholder
+	std::size_t tail_length = 0;
+
+	static constexpr std::size_t literal_size = Chars;
+	static constexpr std::size_t args = Args;
+};
+
+namespace detail
+{
+
+inline constexpr std::size_t npos = std::string_view::npos;
+
+consteval unsigned parse_number(std::string_view s, std::size_t& i)
+{
+	unsigned n = 0;
+	while (i < s.size() && s[i] >= '0' && s[i] <= '9')
+	{
+		n = n * 10 + static_cast<unsigned>(s[i++] - '0');
+		if (n > 1024) throw "format: width and precision are limited to 1024";
+	}
+	return n;
+}
+
+/* s is the text between ':' and '}' */
+consteval spec parse_spec(std::string_view s)
+{
+	spec out;
+	std::size_t i = 0;
+	if (i < s.size() && s[i] == '0')
+	{
+		out.zero = true;
+		++i;
+	}
+	out.width = static_cast<std::uint16_t>(parse_number(s, i));
+	if (i < s.size() && s[i] == '.')
+	{
+		if (++i == s.size() || s[i] < '0' || s[i] > '9') throw "format: '.' without a precision";
+		out.precision = static_cast<std::int16_t>(parse_number(s, i));
+	}
+	if (i < s.size())
+	{
+		out.type = s[i++];
+		if (std::string_view("dxobfegs").find(out.type) == npos) throw "format: unknown type, use one of d x o b f e g s";
+	}
+	if (i != s.size()) throw "format: unexpected character in a placeholder";
+	return out;
+}
+
+/*
+ * One pass over the format string: literal(c) for every character of
+ * output text, placeholder(spec) at every {...}. Both the counting and
+ * the building pass below go through here, so they cannot disagree.
+ */
+template<class Literal, class Placeholder>
+consteval void walk(std::string_view s, Literal literal, Placeholder placeholder)
+{
+	for (std::size_t i = 0; i < s.size(); ++i)
+	{
+		const char c = s[i];
+		if (c == '}')
+		{
+			if (i + 1 == s.size() || s[i + 1] != '}') throw "format: unmatched '}', write }} for a literal brace";
+			literal(c);
+			++i;
+		}
+		else if (c != '{')
+		{
+			literal(c);
+		}
+		else if (i + 1 < s.size() && s[i + 1] == '{')
+		{
+			literal(c);
+			++i;
+		}
+		else
+		{
+			const std::size_t close = s.find('}', i);
+			if (close == npos) throw "format: '{' without '}'";
+			const std::string_view inside = s.substr(i + 1, close - i - 1);
+			if (!inside.empty() && inside[0] != ':') throw "format: only {} and {:spec} are supported, no {index}";
+			placeholder(parse_spec(inside.empty() ? inside : inside.substr(1)));
+			i = close;
+		}
+	}
+}
+
+struct counts
+{
+	std::size_t chars = 0;
+	std::size_t args = 0;
+};
+
+consteval counts count(std::string_view s)
+{
+	counts n;
+	walk(s, [&](char) { ++n.chars; }, [&](spec) { ++n.args; });
+	return n;
+}
+
+enum class kind
+{
+	integer,
+	floating,
+	boolean,
+	character,
+	string,
+	other,
+};
+
+template<class T>
+consteval kind kind_of()
+{
+	if constexpr (std::is_same_v<T, bool>) return kind::boolean;
+	else if constexpr (std::is_same_v<T, char>) return kind::character;
+	else if constexpr (std::is_integral_v<T>) return kind::integer;
+	else if constexpr (std::is_floating_point_v<T>) return kind::floating;
+	else if constexpr (std::is_convertible_v<const T&, std::string_view>) return kind::string;
+	else return kind::other;
+}
+
+template<class T>
+consteval void check(const spec& s)
+{
+	switch (kind_of<T>())
+	{
+	case kind::integer:
+		if (s.type != 0 && std::string_view("dxob").find(s.type) == npos) throw "format: integers take d, x, o or b";
+		if (s.precision >= 0) throw "format: integers take no precision";
+		break;
+	case kind::floating:
+		if (s.type != 0 && std::string_view("feg").find(s.type) == npos) throw "format: floating point takes f, e or g";
+		break;
+	case kind::boolean:
+	case kind::character:
+		if (s.type != 0 || s.zero || s.precision >= 0) throw "format: bool and char take only a width";
+		break;
+	case kind::string:
+		if ((s.type != 0 && s.type != 's') || s.zero) throw "format: strings take s, a width and a precision";
+		break;
+	case kind::other:
+		if (s.type != 0 || s.zero || s.width != 0 || s.precision >= 0) throw "format: types printed through operator<< take no spec";
+		break;
+	}
+}
+
+template<class Plan, class... Args>
+consteval bool validate(const Plan& p)
+{
+	if (Plan::args != sizeof...(Args)) throw "format: placeholder count does not match the argument count";
+	std::size_t i = 0;
+	(check<Args>(p.steps[i++].arg), ...);
+	return true;
+}
+
+/* the plan for S, without looking at any argument */
+template<fixed_string S>
+consteval auto parse()
+{
+	constexpr counts n = count(S.view());
+	plan<n.chars, n.args> p;
+	std::size_t pos = 0, start = 0, k = 0;
+	walk(S.view(), [&](char c) { p.literals[pos++] = c; }, [&](spec s) {
+		p.steps[k++] = { start, pos - start, s };
+		start = pos;
+	});
+	p.tail_begin = start;
+	p.tail_length = pos - start;
+	return p;
+}
+
+// run time, format.cpp
+
+/* text[0..n) right aligned in width: spaces in front, or zeros after the sign */
+char* pad_number(char* out, const char* text, std::size_t n, std::size_t width, bool zero);
+
+/* text[0..n) left aligned in width */
+char* pad_string(char* out, const char* text, std::size_t n, std::size_t width);
+
+/* the buffer print() formats into, one per thread */
+std::string& print_buffer();
+
+void write(std::ostream& os, const std::string& text);
+
+/* arguments without a native formatter become strings, on the calling thread */
+template<class T>
+decltype(auto) prepare(const T& v)
+{
+	if constexpr (kind_of<T>() == kind::other)
+	{
+		std::ostringstream os;
+		os << v;
+		return os.str();
+	}
+	else
+	{
+		return (v);
+	}
+}
+
+template<class T>
+constexpr std::string_view as_string(const T& v)
+{
+	if constexpr (std::is_pointer_v<T>)
+	{
+		if (v == nullptr) return "(null)";
+	}
+	return std::string_view(v);
+}
+
+/* the most characters put<S>() writes for v, the output is sized with it once */
+template<spec S, class T>
+constexpr std::size_t max_length(const T& v)
+{
+	constexpr kind k = kind_of<T>();
+	std::size_t n;
+	if constexpr (k == kind::integer) n = sizeof(T) * 8 + 1;
+	else if constexpr (k == kind::floating && S.type == 'f')
+	{
+		// sign, max_exponent10 + 1 integer digits, point, fraction
+		n = std::numeric_limits<T>::max_exponent10 + 3 + static_cast<std::size_t>(S.precision < 0 ? 6 : S.precision);
+	}
+	else if constexpr (k == kind::floating) n = 32 + static_cast<std::size_t>(S.precision < 0 ? 17 : S.precision);
+	else if constexpr (k == kind::boolean) n = 5;
+	else if constexpr (k == kind::character) n = 1;
+	else n = as_string(v).size();
+	return std::max<std::size_t>(n, S.width);
+}
+
+/* format one argument at out, no checks: max_length<S>() bytes are free there */
+template<spec S, class T>
+char* put(char* out, const T& v)
+{
+	constexpr kind k = kind_of<T>();
+	if constexpr (k == kind::integer || k == kind::floating)
+	{
+		// on error .ptr is last and the range holds nothing, write nothing then
+		auto convert = [&v](char* first, char* last) {
+			std::to_chars_result r;
+			if constexpr (k == kind::integer)
+			{
+				constexpr int base = S.type == 'x' ? 16 : S.type == 'o' ? 8 : S.type == 'b' ? 2 : 10;
+				r = std::to_chars(first, last, v, base);
+			}
+			else if constexpr (S.type == 0 && S.precision < 0)
+			{
+				r = std::to_chars(first, last, v);
+			}
+			else
+			{
+				constexpr auto fmt = S.type == 'f' ? std::chars_format::fixed
+					: S.type == 'e' ? std::chars_format::scientific : std::chars_format::general;
+				r = std::to_chars(first, last, v, fmt, S.precision < 0 ? 6 : S.precision);
+			}
+			return r.ec == std::errc{} ? r.ptr : first;
+		};
+
+		if constexpr (S.width == 0)
+		{
+			return convert(out, out + max_length<S>(v));
+		}
+		else
+		{
+			char buf[max_length<spec{ S.type, false, 0, S.precision }>(T{})];
+			const char* end = convert(buf, buf + sizeof(buf));
+			return pad_number(out, buf, static_cast<std::size_t>(end - buf), S.width, S.zero);
+		}
+	}
+	else if constexpr (k == kind::boolean)
+	{
+		const std::string_view s = v ? "true" : "false";
+		return pad_string(out, s.data(), s.size(), S.width);
+	}
+	else if constexpr (k == kind::character)
+	{
+		return pad_string(out, &v, 1, S.width);
+	}
+	else
+	{
+		std::string_view s = as_string(v);
+		if constexpr (S.precision >= 0) s = s.substr(0, static_cast<std::size_t>(S.precision));
+		if constexpr (S.width == 0)
+		{
+			std::memcpy(out, s.data(), s.size());
+			return out + s.size();
+		}
+		else
+		{
+			return pad_string(out, s.data(), s.size(), S.width);
+		}
+	}
+}
+
+template<const auto& P, class... Args, std::size_t... I>
+void run(std::string& out, std::index_sequence<I...>, const Args&... args)
+{
+	const std::size_t old = out.size();
+	out.resize(old + P.literal_size + (std::size_t{ 0 } + ... + max_length<P.steps[I].arg>(args)));
+	char* q = out.data() + old;
+
+	auto literal = [&q](std::size_t begin, std::size_t length) {
+		std::memcpy(q, P.literals.data() + begin, length);
+		q += length;
+	};
+	((literal(P.steps[I].literal_begin, P.steps[I].literal_length), q = put<P.steps[I].arg>(q, args)), ...);
+	literal(P.tail_begin, P.tail_length);
+
+	out.resize(static_cast<std::size_t>(q - out.data()));
+}
+
+} // detail
+
+/* the plan for S, built once by the compiler */
+template<fixed_string S>
+inline constexpr auto plan_of = detail::parse<S>();
+
+/* append the formatted text to out, reusing its capacity */
+template<fixed_string S, class... Args>
+void format_to(std::string& out, const Args&... args)
+{
+	static_assert(detail::validate<std::decay_t<decltype(plan_of<S>)>, Args...>(plan_of<S>));
+	[&out](const auto&... prepared) {
+		detail::run<plan_of<S>>(out, std::index_sequence_for<Args...>{}, prepared...);
+	}(detail::prepare(args)...);
+}
+
+template<fixed_string S, class... Args>
+std::string format(const Args&... args)
+{
+	std::string out;
+	format_to<S>(out, args...);
+	return out;
+}
+
+/* format into a per-thread buffer and write it to os in one call */
+template<fixed_string S, class... Args>
+void print(std::ostream& os, const Args&... args)
+{
+	std::string& buf = detail::print_buffer();
+	buf.clear();
+	format_to<S>(buf, args...);
+	detail::write(os, buf);
+}
+
+} // format
+} // cxx20
+} // pluto
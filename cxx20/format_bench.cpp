@@ -0,0 +1,148 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 01:27:33
+ * @brief
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "format.h"
+
+using namespace std;
+namespace fmt = pluto::cxx20::format;
+
+namespace
+{
+
+/* one log-line shaped record: int, string, fixed point double, hex */
+struct record
+{
+	int id;
+	string name;
+	double score;
+	unsigned flags;
+};
+
+const record records[] = {
+	{ 1, "alice", 93.125, 0x1f },
+	{ 42, "bob", 7.5, 0xdeadbeef },
+	{ -7, "carol", 1234567.891, 0 },
+	{ 100000, "dave", 0.001, 0x80 },
+};
+
+} // namespace
+
+static void BM_FormatPlan(benchmark::State& state)
+{
+	string out;
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const record& r = records[i++ & 3];
+		out.clear();
+		fmt::format_to<"id={} name={} score={:.2f} flags={:x}">(out, r.id, r.name, r.score, r.flags);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* a fresh std::string per call, the allocation included */
+static void BM_FormatPlanString(benchmark::State& state)
+{
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const record& r = records[i++ & 3];
+		string s = fmt::format<"id={} name={} score={:.2f} flags={:x}">(r.id, r.name, r.score, r.flags);
+		benchmark::DoNotOptimize(s.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Snprintf(benchmark::State& state)
+{
+	char buf[128];
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const record& r = records[i++ & 3];
+		const int n = snprintf(buf, sizeof(buf), "id=%d name=%s score=%.2f flags=%x", r.id, r.name.c_str(), r.score, r.flags);
+		benchmark::DoNotOptimize(n);
+		benchmark::DoNotOptimize(buf);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* the stream is reused, as a printer writing to one ostream would */
+static void BM_Ostringstream(benchmark::State& state)
+{
+	ostringstream os;
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const record& r = records[i++ & 3];
+		os.str(string());
+		os << "id=" << r.id << " name=" << r.name << " score=" << fixed << setprecision(2) << r.score
+			<< " flags=" << hex << r.flags << dec;
+		benchmark::DoNotOptimize(os);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_OstringstreamString(benchmark::State& state)
+{
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		const record& r = records[i++ & 3];
+		ostringstream os;
+		os << "id=" << r.id << " name=" << r.name << " score=" << fixed << setprecision(2) << r.score
+			<< " flags=" << hex << r.flags;
+		string s = os.str();
+		benchmark::DoNotOptimize(s.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/* integers only, where the plan is a run of to_chars calls */
+static void BM_FormatPlanInts(benchmark::State& state)
+{
+	string out;
+	int64_t v = 1234567;
+	for (auto _ : state)
+	{
+		out.clear();
+		fmt::format_to<"{} {} {} {}">(out, v, v + 1, v * 3, -v);
+		benchmark::DoNotOptimize(out.data());
+		++v;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SnprintfInts(benchmark::State& state)
+{
+	char buf[128];
+	int64_t v = 1234567;
+	for (auto _ : state)
+	{
+		const int n = snprintf(buf, sizeof(buf), "%" PRId64 " %" PRId64 " %" PRId64 " %" PRId64, v, v + 1, v * 3, -v);
+		benchmark::DoNotOptimize(n);
+		benchmark::DoNotOptimize(buf);
+		++v;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FormatPlan);
+BENCHMARK(BM_FormatPlanString);
+BENCHMARK(BM_Snprintf);
+BENCHMARK(BM_Ostringstream);
+BENCHMARK(BM_OstringstreamString);
+BENCHMARK(BM_FormatPlanInts);
+BENCHMARK(BM_SnprintfInts);
@@ -0,0 +1,120 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/20 01:06:45
+ * @brief
+ */
+
+#include <cinttypes>
+#include <complex>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "format.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx20::format;
+
+namespace
+{
+
+template<class... Args>
+string c_format(const char* fmt, Args... args)
+{
+	char buf[512];
+	const int n = snprintf(buf, sizeof(buf), fmt, args...);
+	return string(buf, static_cast<size_t>(n));
+}
+
+string shortest(double d)
+{
+	char buf[32];
+	return string(buf, to_chars(buf, buf + sizeof(buf), d).ptr);
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_FORMAT) {
+
+	{
+		// the plan is built by the compiler
+		constexpr auto& p = plan_of<"a{{b}}c {} - {:08.3f}!">;
+		static_assert(p.args == 2);
+		static_assert(string_view(p.literals.data(), p.literal_size) == "a{b}c  - !");
+		static_assert(p.steps[0].literal_length == 6 && p.steps[1].literal_length == 3);
+		static_assert(p.steps[1].arg.zero && p.steps[1].arg.width == 8 && p.steps[1].arg.precision == 3);
+		static_assert(p.steps[1].arg.type == 'f' && p.tail_length == 1);
+	}
+
+	EXPECT_EQ(format<"">(), "");
+	EXPECT_EQ(format<"no placeholders">(), "no placeholders");
+	EXPECT_EQ(format<"{{}} {{{}}}">(1), "{} {1}");
+	EXPECT_EQ(format<"{}{}{}">('a', true, false), "atruefalse");
+	EXPECT_EQ(format<"{} {:s} {:.3} [{:6}] [{:6.2}]">("str", string("s2"), string_view("abcdef"), "ab", "abc"),
+		"str s2 abc [ab    ] [ab    ]");
+	EXPECT_EQ(format<"[{:3}] [{:5}]">('x', true), "[x  ] [true ]");
+	EXPECT_EQ(format<"{} {}">(complex<double>(1, 2), static_cast<const char*>(nullptr)), "(1,2) (null)");
+	EXPECT_EQ(format<"{} {}">(INT64_MIN, UINT64_MAX), "-9223372036854775808 18446744073709551615");
+	EXPECT_EQ(format<"{:b} {:o} {:x}">(5, 8, -255), "101 10 -ff");
+	EXPECT_EQ(format<"{} {} {}">(0.1, 1.0 / 3, 1e300), "0.1 0.3333333333333333 1e+300");
+	EXPECT_EQ(format<"{} {}">(2.5f, static_cast<signed char>(-3)), "2.5 -3");
+
+	{
+		// long double reaches past the double range, the buffer grows with it
+		const long double big = -1e400L;
+		EXPECT_EQ(format<"[{:.2f}]">(big), c_format("[%.2Lf]", big));
+		EXPECT_EQ(format<"[{:420.1f}]">(big), c_format("[%420.1Lf]", big));
+		EXPECT_EQ(format<"{:e} {:.3g}">(big, big), c_format("%Le %.3Lg", big, big));
+		EXPECT_EQ(format<"{}">(1.5L), "1.5");
+	}
+
+	{
+		// appends, keeps what is there
+		string out = "> ";
+		format_to<"{}, ">(out, 1);
+		format_to<"{}">(out, 2);
+		EXPECT_EQ(out, "> 1, 2");
+
+		ostringstream os;
+		print<"{}={:.1f}\n">(os, "pi", 3.14159);
+		EXPECT_EQ(os.str(), "pi=3.1\n");
+	}
+
+	{
+		// integers and floats against printf with the same spec
+		mt19937_64 rng(7);
+		int bad = 0;
+		for (int i = 0; i < 20000; ++i)
+		{
+			const auto raw = rng();
+			const auto v = static_cast<int64_t>(raw) >> (raw % 64);
+			const auto u = static_cast<unsigned>(raw >> 32);
+			const double d = static_cast<double>(v) / static_cast<double>(1 + (raw & 0xffff)) * (i % 2 ? 1e-7 : 1e5);
+
+			bad += format<"{}">(v) != c_format("%" PRId64, v);
+			bad += format<"{:12}|{:012}">(v, v) != c_format("%12" PRId64 "|%012" PRId64, v, v);
+			bad += format<"{:x} {:o} {:08x}">(u, u, u) != c_format("%x %o %08x", u, u, u);
+			bad += format<"{:f} {:.2f} {:12.3f} {:012.1f}">(d, d, d, d) != c_format("%f %.2f %12.3f %012.1f", d, d, d, d);
+			bad += format<"{:e} {:.3e} {:g} {:.10g} {:.4}">(d, d, d, d, d) != c_format("%e %.3e %g %.10g %.4g", d, d, d, d, d);
+			bad += format<"{}">(d) != shortest(d);
+		}
+		EXPECT_EQ(bad, 0);
+	}
+
+	TEST_COUT << format<"[{:8}] [{:08.3f}] [{:x}] [{:.2e}]">("name", 3.14159, 255u, 12345.678) << endl;
+
+	/*
+	 * Compile errors, each one names the rule:
+	 *
+	 *	format<"{} {}">(1);		// placeholder count does not match the argument count
+	 *	format<"{:x}">(1.5);	// floating point takes f, e or g
+	 *	format<"{:.2}">(1);		// integers take no precision
+	 *	format<"{0}">(1);		// only {} and {:spec} are supported, no {index}
+	 *	format<"}">();			// unmatched '}', write }} for a literal brace
+	 */
+}
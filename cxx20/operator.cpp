@@ -0,0 +1,8 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 18:40:51
+ * @brief
+ */
+
+#include "operator.h"
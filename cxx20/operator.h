@@ -1,6 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace pluto
 {
@@ -10,7 +31,7 @@ namespace cxx20
 namespace three_way_comparison_operator
 {
 
-void test()
+inline void test()
 {
 	double foo = -0.0;
 	double bar = 0.0;
@@ -29,6 +50,895 @@ void test()
 
 }
 
+/*
+ * Structured access to aggregates :
+ *
+ * There is no reflection, but the number of fields of an aggregate can be
+ * probed with brace initialization, T{ any, any, ... }, and then the
+ * fields can be bound with structured bindings. tie(x) returns a tuple of
+ * references to the fields of a plain struct, the elements for tuples,
+ * pairs and std::arrays. Supports up to 8 fields, none of them C arrays
+ * (brace elision would make the count ambiguous). A std::array is an
+ * aggregate too, but its elements are not fields: it is tuple-like.
+ */
+namespace aggregate
+{
+
+namespace detail
+{
+
+struct any_field
+{
+	template<class U>
+	operator U() const;
+};
+
+template<class T, std::size_t... I>
+constexpr bool brace_constructible(std::index_sequence<I...>)
+{
+	return requires { T{ (void(I), any_field{})... }; };
+}
+
+inline constexpr std::size_t max_fields = 8;
+
+template<class T, std::size_t N = max_fields>
+constexpr std::size_t field_count()
+{
+	if constexpr (N == 0) return 0;
+	else if constexpr (brace_constructible<T>(std::make_index_sequence<N>{})) return N;
+	else return field_count<T, N - 1>();
+}
+
+template<class T>
+struct is_tuple_like : std::false_type {};
+
+template<class... Ts>
+struct is_tuple_like<std::tuple<Ts...>> : std::true_type {};
+
+template<class A, class B>
+struct is_tuple_like<std::pair<A, B>> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_tuple_like<std::array<T, N>> : std::true_type {};
+
+} // detail
+
+template<class T>
+inline constexpr bool is_tuple_like_v = detail::is_tuple_like<std::remove_cv_t<T>>::value;
+
+/* a struct we can take apart: aggregate, not a tuple, not an array, not a std::array */
+template<class T>
+inline constexpr bool is_decomposable_v = std::is_aggregate_v<T> && !std::is_array_v<T> && !is_tuple_like_v<T>;
+
+template<class T>
+inline constexpr std::size_t field_count_v = detail::field_count<T>();
+
+namespace detail
+{
+
+/* 1 to max_fields fields: the probe stops at max_fields, so one more must fail */
+template<class T>
+constexpr bool tieable()
+{
+	if constexpr (is_tuple_like_v<T>) return true;
+	else if constexpr (!is_decomposable_v<T>) return false;
+	else return field_count<T>() > 0 && !brace_constructible<T>(std::make_index_sequence<max_fields + 1>{});
+}
+
+} // detail
+
+/* true if tie() can take T apart, checked without instantiating it */
+template<class T>
+inline constexpr bool is_tieable_v = detail::tieable<T>();
+
+template<class T>
+constexpr auto tie(const T& x)
+{
+	if constexpr (is_tuple_like_v<T>)
+	{
+		return std::apply([](const auto&... f) { return std::tie(f...); }, x);
+	}
+	else
+	{
+		constexpr std::size_t n = field_count_v<T>;
+		static_assert(n > 0 && n <= 8, "aggregate::tie supports 1 to 8 fields");
+		if constexpr (n == 1) { const auto& [a] = x; return std::tie(a); }
+		else if constexpr (n == 2) { const auto& [a, b] = x; return std::tie(a, b); }
+		else if constexpr (n == 3) { const auto& [a, b, c] = x; return std::tie(a, b, c); }
+		else if constexpr (n == 4) { const auto& [a, b, c, d] = x; return std::tie(a, b, c, d); }
+		else if constexpr (n == 5) { const auto& [a, b, c, d, e] = x; return std::tie(a, b, c, d, e); }
+		else if constexpr (n == 6) { const auto& [a, b, c, d, e, f] = x; return std::tie(a, b, c, d, e, f); }
+		else if constexpr (n == 7) { const auto& [a, b, c, d, e, f, g] = x; return std::tie(a, b, c, d, e, f, g); }
+		else { const auto& [a, b, c, d, e, f, g, h] = x; return std::tie(a, b, c, d, e, f, g, h); }
+	}
+}
+
+} // aggregate
+
+/*
+ * Normalized sort keys :
+ *
+ * Sorting records with a comparator calls <=> once per comparison, field
+ * by field, with a branch on every field. Instead, every record can be
+ * encoded once into a string of bytes whose memcmp order is the <=>
+ * order of the record. After that the records are just byte strings:
+ * they compare with one (vectorized) memcmp, or go through a radix sort
+ * without any comparison at all.
+ *
+ *		std::tuple<int, double, std::string> r{ -1, 2.5, "ab" };
+ *		std::string k = sort_key::make_key(r);
+ *		// make_key(a) < make_key(b)  <=>  (a <=> b) < 0
+ *
+ * Encoding per field, concatenated in field order:
+ *
+ *	unsigned	big-endian, so the most significant byte compares first
+ *	signed		sign bit flipped, then as unsigned: INT_MIN -> 0x00..
+ *	float		IEEE bits; negative numbers have every bit flipped, others
+ *				only the sign bit. -0.0 is first turned into +0.0, since
+ *				(-0.0 <=> 0.0) == 0, and every NaN into the same NaN,
+ *				which sorts after +inf (<=> leaves NaN unordered).
+ *	bool, enum	as their integer
+ *	string		bytes with 0x00 escaped as 00 FF, terminated by 00 00, so
+ *				a prefix sorts first: "a" < "a\0" < "ab"
+ *	optional	00 for nullopt, 01 + value otherwise: null first, like <=>
+ *	std::array	the elements in order, so a byte array is its bytes
+ *	tuple, pair, aggregate (see aggregate::tie): the fields in order
+ *
+ * Every field is self-delimiting, so the concatenation of keys orders
+ * like the lexicographic compare of the fields.
+ *
+ * If every field has a fixed width (no strings, no optionals) the key is
+ * a std::array of key_size_v<T> bytes, and radix_sort_by_key() sorts the
+ * records with LSD radix passes over those bytes.
+ */
+namespace sort_key
+{
+
+namespace detail
+{
+
+template<class T>
+struct is_optional : std::false_type {};
+
+template<class T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+template<class T>
+struct is_std_array : std::false_type {};
+
+template<class T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template<class T>
+inline constexpr bool is_string_v = std::is_convertible_v<const T&, std::string_view> && !std::is_arithmetic_v<T>;
+
+template<class T>
+using bits_t = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+/* unsigned bits whose order is the numeric order of a float (total order) */
+template<class F>
+constexpr bits_t<F> ordered_bits(F f)
+{
+	using U = bits_t<F>;
+	const U u = std::bit_cast<U>(f);
+	const U sign = U(1) << (sizeof(U) * 8 - 1);
+	return (u & sign) ? ~u : (u | sign);
+}
+
+/* the unsigned image of an integral or floating value, order preserving */
+template<class T>
+constexpr auto ordered_unsigned(T v)
+{
+	if constexpr (std::is_enum_v<T>)
+	{
+		return ordered_unsigned(static_cast<std::underlying_type_t<T>>(v));
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		return static_cast<std::uint8_t>(v);
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		static_assert(sizeof(T) == 4 || sizeof(T) == 8, "float and double only");
+		if (v == 0) v = 0;												// -0.0 -> +0.0
+		if (v != v) v = std::numeric_limits<T>::quiet_NaN();			// one NaN
+		return ordered_bits(v);
+	}
+	else if constexpr (std::is_signed_v<T>)
+	{
+		using U = std::make_unsigned_t<T>;
+		return static_cast<U>(static_cast<U>(v) ^ (U(1) << (sizeof(U) * 8 - 1)));
+	}
+	else
+	{
+		return v;
+	}
+}
+
+template<class T>
+constexpr std::size_t fixed_size()
+{
+	if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) return sizeof(ordered_unsigned(T()));
+	else if constexpr (is_std_array<T>::value)
+	{
+		constexpr std::size_t element = fixed_size<typename T::value_type>();
+		return element == std::size_t(-1) ? element : element * std::tuple_size_v<T>;
+	}
+	else if constexpr (aggregate::is_tuple_like_v<T> || aggregate::is_decomposable_v<T>)
+	{
+		using fields = decltype(aggregate::tie(std::declval<const T&>()));
+		return []<std::size_t... I>(std::index_sequence<I...>) {
+			constexpr std::size_t sizes[] = { fixed_size<std::decay_t<std::tuple_element_t<I, fields>>>()..., 0 };
+			std::size_t total = 0;
+			for (std::size_t s : sizes)
+			{
+				if (s == std::size_t(-1)) return std::size_t(-1);
+				total += s;
+			}
+			return total;
+		}(std::make_index_sequence<std::tuple_size_v<fields>>{});
+	}
+	else return std::size_t(-1);
+}
+
+/* writes bytes through put(byte) */
+template<class Put, class T>
+constexpr void encode(Put& put, const T& v)
+{
+	if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	{
+		const auto u = ordered_unsigned(v);
+		for (int shift = static_cast<int>(sizeof(u) * 8) - 8; shift >= 0; shift -= 8)
+		{
+			put(static_cast<std::uint8_t>(u >> shift));
+		}
+	}
+	else if constexpr (is_string_v<T>)
+	{
+		for (char c : std::string_view(v))
+		{
+			put(static_cast<std::uint8_t>(c));
+			if (c == '\0') put(0xff);
+		}
+		put(0);
+		put(0);
+	}
+	else if constexpr (is_optional<T>::value)
+	{
+		put(v.has_value() ? 1 : 0);
+		if (v) encode(put, *v);
+	}
+	else if constexpr (is_std_array<T>::value)
+	{
+		for (const auto& e : v) encode(put, e);
+	}
+	else if constexpr (aggregate::is_tuple_like_v<T> || aggregate::is_decomposable_v<T>)
+	{
+		std::apply([&](const auto&... f) { (encode(put, f), ...); }, aggregate::tie(v));
+	}
+	else
+	{
+		static_assert(sizeof(T) == 0, "sort_key: unsupported field type");
+	}
+}
+
+} // detail
+
+/* bytes of the key of T, if every field has a fixed width */
+template<class T>
+inline constexpr bool is_fixed_v = detail::fixed_size<T>() != std::size_t(-1);
+
+template<class T>
+inline constexpr std::size_t key_size_v = detail::fixed_size<T>();
+
+/* append the key of v to out */
+template<class T>
+void append_key(std::string& out, const T& v)
+{
+	auto put = [&out](std::uint8_t b) { out.push_back(static_cast<char>(b)); };
+	detail::encode(put, v);
+}
+
+template<class T>
+std::string make_key(const T& v)
+{
+	std::string out;
+	if constexpr (is_fixed_v<T>) out.reserve(key_size_v<T>);
+	append_key(out, v);
+	return out;
+}
+
+/* the key of a fixed width type as a byte array */
+template<class T>
+constexpr std::array<std::uint8_t, key_size_v<T>> make_fixed_key(const T& v)
+{
+	static_assert(is_fixed_v<T>, "strings and optionals have no fixed width key");
+	std::array<std::uint8_t, key_size_v<T>> key{};
+	std::size_t i = 0;
+	auto put = [&](std::uint8_t b) { key[i++] = b; };
+	detail::encode(put, v);
+	return key;
+}
+
+namespace detail
+{
+
+template<class T>
+void gather(std::vector<T>& v, const std::vector<std::uint32_t>& order)
+{
+	std::vector<T> out;
+	out.reserve(v.size());
+	for (std::uint32_t i : order) out.push_back(std::move(v[i]));
+	v = std::move(out);
+}
+
+template<std::size_t K>
+struct keyed
+{
+	std::array<std::uint8_t, K> key;
+	std::uint32_t index;
+};
+
+/* memcmp(a, b, K) < 0, eight bytes at a time as big-endian words */
+template<std::size_t K>
+bool key_less(const std::array<std::uint8_t, K>& a, const std::array<std::uint8_t, K>& b)
+{
+	std::size_t i = 0;
+	for (; i + 8 <= K; i += 8)
+	{
+		std::uint64_t x, y;
+		std::memcpy(&x, a.data() + i, 8);
+		std::memcpy(&y, b.data() + i, 8);
+		if (x != y)
+		{
+			if constexpr (std::endian::native == std::endian::little) return __builtin_bswap64(x) < __builtin_bswap64(y);
+			else return x < y;
+		}
+	}
+	return std::memcmp(a.data() + i, b.data() + i, K - i) < 0;
+}
+
+template<class T>
+auto fixed_keys(const std::vector<T>& v)
+{
+	std::vector<keyed<key_size_v<T>>> items(v.size());
+	for (std::size_t i = 0; i < v.size(); ++i) items[i] = { make_fixed_key(v[i]), static_cast<std::uint32_t>(i) };
+	return items;
+}
+
+} // detail
+
+/*
+ * Sort by memcmp on the keys, any supported T. Fixed width keys are kept
+ * inline next to the record index, variable ones are packed into a single
+ * buffer, so no key needs an allocation of its own.
+ */
+template<class T>
+void sort_by_key(std::vector<T>& v)
+{
+	std::vector<std::uint32_t> order(v.size());
+	if constexpr (is_fixed_v<T>)
+	{
+		auto items = detail::fixed_keys(v);
+		std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+			return detail::key_less(a.key, b.key);
+		});
+		for (std::size_t i = 0; i < items.size(); ++i) order[i] = items[i].index;
+	}
+	else
+	{
+		std::string buffer;
+		std::vector<std::size_t> offset(v.size() + 1);
+		for (std::size_t i = 0; i < v.size(); ++i)
+		{
+			append_key(buffer, v[i]);
+			offset[i + 1] = buffer.size();
+		}
+
+		auto key = [&](std::uint32_t i) {
+			return std::string_view(buffer.data() + offset[i], offset[i + 1] - offset[i]);
+		};
+		std::iota(order.begin(), order.end(), std::uint32_t{ 0 });
+		std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return key(a) < key(b); });
+	}
+	detail::gather(v, order);
+}
+
+/*
+ * LSD radix sort on the fixed width keys: one stable counting pass per
+ * key byte, last byte first. The histograms of all bytes are built in a
+ * single read of the keys, and a byte that is the same in every key is
+ * skipped, so e.g. small ints in an int64 field cost no extra passes.
+ */
+template<class T>
+void radix_sort_by_key(std::vector<T>& v)
+{
+	constexpr std::size_t K = key_size_v<T>;
+	const std::size_t n = v.size();
+
+	auto a = detail::fixed_keys(v);
+	decltype(a) b(n);
+
+	std::vector<std::array<std::uint32_t, 256>> count(K);
+	for (const auto& it : a)
+	{
+		for (std::size_t byte = 0; byte < K; ++byte) ++count[byte][it.key[byte]];
+	}
+
+	for (std::size_t byte = K; byte-- > 0;)
+	{
+		auto& c = count[byte];
+		if (n == 0 || c[a[0].key[byte]] == n) continue;
+
+		std::exclusive_scan(c.begin(), c.end(), c.begin(), std::uint32_t{ 0 });
+		for (const auto& it : a) b[c[it.key[byte]]++] = it;
+		a.swap(b);
+	}
+
+	std::vector<std::uint32_t> order(n);
+	for (std::size_t i = 0; i < n; ++i) order[i] = a[i].index;
+	detail::gather(v, order);
+}
+
+} // sort_key
+
+/*
+ * IEEE 754 total order :
+ *
+ * three_way_comparison_operator::test() shows that <=> on doubles is only
+ * a partial_ordering: -0.0 and 0.0 compare equal and NaN is unordered
+ * with everything, so a NaN in the input breaks std::sort's strict weak
+ * ordering requirement (anything may happen, up to reading out of range).
+ *
+ * totalOrder from IEEE 754-2008 orders every bit pattern:
+ *
+ *		-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN
+ *
+ * and it can be computed with integer instructions only. Read the bits as
+ * a signed integer: positive floats already compare correctly, negative
+ * ones compare backwards, and flipping all bits but the sign of the
+ * negative ones fixes that:
+ *
+ *		i ^= (unsigned)(i >> 63) >> 1;		// arithmetic shift: all 1s or all 0s
+ *
+ * No branch, no floating point compare. std::strong_order gives the same
+ * order in C++20, total_order is the branch free spelling of it.
+ *
+ * radix_sort() sorts float/double arrays in that order without any
+ * comparison: LSD radix sort on the same bits read as unsigned, 11 bits
+ * per pass (3 passes for float, 6 for double), and radix_sort_pairs()
+ * carries a value along with each key.
+ */
+namespace total_order_ns
+{
+
+namespace detail
+{
+
+template<class F>
+using bits_t = sort_key::detail::bits_t<F>;
+
+/* signed integer whose order is totalOrder of f */
+template<class F>
+constexpr auto signed_key(F f)
+{
+	static_assert(std::is_floating_point_v<F> && (sizeof(F) == 4 || sizeof(F) == 8), "float and double only");
+	using S = std::make_signed_t<bits_t<F>>;
+	using U = bits_t<F>;
+	const S i = std::bit_cast<S>(f);
+	return static_cast<S>(i ^ static_cast<S>(static_cast<U>(i >> (sizeof(S) * 8 - 1)) >> 1));
+}
+
+} // detail
+
+struct total_order
+{
+	/* a < b in IEEE totalOrder, usable with std::sort */
+	template<class F>
+	constexpr bool operator()(F a, F b) const
+	{
+		return detail::signed_key(a) < detail::signed_key(b);
+	}
+
+	template<class F>
+	static constexpr std::strong_ordering compare(F a, F b)
+	{
+		return detail::signed_key(a) <=> detail::signed_key(b);
+	}
+};
+
+namespace detail
+{
+
+inline constexpr unsigned radix_bits = 11;
+inline constexpr std::size_t radix_buckets = std::size_t(1) << radix_bits;
+
+/*
+ * LSD passes over keys (already mapped to ordered unsigned integers),
+ * moving the matching values along. Returns true if the result ended up
+ * in the scratch buffers.
+ */
+template<class U, class V>
+bool radix_passes(U* keys, U* keys_tmp, V* values, V* values_tmp, std::size_t n)
+{
+	constexpr unsigned passes = (sizeof(U) * 8 + radix_bits - 1) / radix_bits;
+	constexpr bool with_values = !std::is_same_v<V, std::nullptr_t>;
+
+	std::vector<std::array<std::size_t, radix_buckets>> count(passes);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (unsigned p = 0; p < passes; ++p) ++count[p][(keys[i] >> (p * radix_bits)) & (radix_buckets - 1)];
+	}
+
+	bool swapped = false;
+	for (unsigned p = 0; p < passes; ++p)
+	{
+		const unsigned shift = p * radix_bits;
+		auto& c = count[p];
+		if (c[(keys[0] >> shift) & (radix_buckets - 1)] == n) continue;	// one bucket, nothing moves
+
+		std::exclusive_scan(c.begin(), c.end(), c.begin(), std::size_t{ 0 });
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const std::size_t to = c[(keys[i] >> shift) & (radix_buckets - 1)]++;
+			keys_tmp[to] = keys[i];
+			if constexpr (with_values) values_tmp[to] = std::move(values[i]);
+		}
+		std::swap(keys, keys_tmp);
+		if constexpr (with_values) std::swap(values, values_tmp);
+		swapped = !swapped;
+	}
+	return swapped;
+}
+
+template<class F, class V>
+void radix_sort(F* keys, V* values, std::size_t n)
+{
+	using U = bits_t<F>;
+	if (n < 2) return;
+
+	std::vector<U> bits(n), bits_tmp(n);
+	for (std::size_t i = 0; i < n; ++i) bits[i] = sort_key::detail::ordered_bits(keys[i]);
+
+	bool in_tmp;
+	if constexpr (std::is_same_v<V, std::nullptr_t>)
+	{
+		in_tmp = radix_passes<U, std::nullptr_t>(bits.data(), bits_tmp.data(), nullptr, nullptr, n);
+	}
+	else
+	{
+		std::vector<V> values_tmp(n);
+		in_tmp = radix_passes(bits.data(), bits_tmp.data(), values, values_tmp.data(), n);
+		if (in_tmp) std::move(values_tmp.begin(), values_tmp.end(), values);
+	}
+
+	// back from ordered bits to the float
+	const U* sorted = in_tmp ? bits_tmp.data() : bits.data();
+	const U sign = U(1) << (sizeof(U) * 8 - 1);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		const U u = sorted[i];
+		keys[i] = std::bit_cast<F>((u & sign) ? (u ^ sign) : ~u);
+	}
+}
+
+} // detail
+
+/* sort in IEEE totalOrder, stable */
+template<class F>
+void radix_sort(F* first, std::size_t n)
+{
+	detail::radix_sort<F, std::nullptr_t>(first, nullptr, n);
+}
+
+template<class F>
+void radix_sort(std::vector<F>& v)
+{
+	radix_sort(v.data(), v.size());
+}
+
+/* sort keys[0..n) in totalOrder and apply the same permutation to values */
+template<class F, class V>
+void radix_sort_pairs(F* keys, V* values, std::size_t n)
+{
+	detail::radix_sort(keys, values, n);
+}
+
+/* throws std::invalid_argument unless every key has exactly one value */
+template<class F, class V>
+void radix_sort_pairs(std::vector<F>& keys, std::vector<V>& values)
+{
+	if (keys.size() != values.size()) throw std::invalid_argument("radix_sort_pairs: keys and values differ in size");
+	radix_sort_pairs(keys.data(), values.data(), keys.size());
+}
+
+} // total_order_ns
+
+using total_order_ns::total_order;
+using total_order_ns::radix_sort;
+using total_order_ns::radix_sort_pairs;
+
+/*
+ * Fast three way comparison :
+ *
+ * A defaulted <=> on a wide record compares field by field, one compare
+ * and one branch per field, even when the records share a long prefix:
+ *
+ *		struct order_key { uint32_t venue; uint32_t desk; uint64_t account; std::array<uint8_t, 16> id; };
+ *
+ * If every field is an unsigned integer or a byte array, and the fields
+ * fill the object without padding, the records can be compared as raw
+ * memory instead:
+ *
+ *	1) find the first byte where a and b differ, 16 bytes per step with
+ *	   SSE2 (compare bytes, movemask, count trailing zeros),
+ *	2) the field holding that byte is the first field that differs, all
+ *	   fields before it are equal byte for byte,
+ *	3) compare just that field: as an integer (the differing byte of a
+ *	   little-endian integer is not its most significant one), or as
+ *	   bytes for a byte array.
+ *
+ * fast_three_way(a, b) does that for aggregates and tuples of such
+ * fields (a tuple may lay its fields out backwards, then the scan runs
+ * from the end), and returns a <=> b for everything else.
+ */
+namespace fast_three_way_ns
+{
+
+namespace detail
+{
+
+template<class T>
+struct is_byte_array : std::false_type {};
+
+template<std::size_t N>
+struct is_byte_array<std::array<std::uint8_t, N>> : std::true_type {};
+
+template<std::size_t N>
+struct is_byte_array<std::array<std::byte, N>> : std::true_type {};
+
+template<class T>
+inline constexpr bool is_lane_field_v = (std::is_integral_v<T> && std::is_unsigned_v<T>) || is_byte_array<T>::value;
+
+template<class T>
+constexpr bool is_packed()
+{
+	// a struct with more fields than tie() binds, or none it can count, stays on <=>
+	if constexpr (!aggregate::is_tieable_v<T>) return false;
+	else
+	{
+		using fields = decltype(aggregate::tie(std::declval<const T&>()));
+		return []<std::size_t... I>(std::index_sequence<I...>) {
+			return (is_lane_field_v<std::remove_cvref_t<std::tuple_element_t<I, fields>>> && ...) &&
+				(sizeof(std::remove_cvref_t<std::tuple_element_t<I, fields>>) + ... + 0) == sizeof(T);
+		}(std::make_index_sequence<std::tuple_size_v<fields>>{});
+	}
+}
+
+/* index of the first byte where a and b differ, n if none */
+inline std::size_t first_mismatch(const unsigned char* a, const unsigned char* b, std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16)
+	{
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		const unsigned diff = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffu;
+		if (diff) return i + static_cast<std::size_t>(std::countr_zero(diff));
+	}
+#endif
+	for (; i + 8 <= n; i += 8)
+	{
+		std::uint64_t x, y;
+		std::memcpy(&x, a + i, 8);
+		std::memcpy(&y, b + i, 8);
+		if (x != y)
+		{
+			if constexpr (std::endian::native == std::endian::little) return i + std::countr_zero(x ^ y) / 8;
+			else return i + std::countl_zero(x ^ y) / 8;
+		}
+	}
+	for (; i < n; ++i)
+	{
+		if (a[i] != b[i]) return i;
+	}
+	return n;
+}
+
+/*
+ * first_mismatch for a size known at compile time and up to 64 bytes:
+ * the movemask of every 16-byte chunk goes into one 64-bit mask of equal
+ * bytes, no early exit to mispredict.
+ */
+template<std::size_t N>
+std::size_t first_mismatch(const unsigned char* a, const unsigned char* b)
+{
+#if defined(__SSE2__)
+	if constexpr (N >= 16 && N <= 64)
+	{
+		std::uint64_t diff = 0;
+		auto chunk = [&](std::size_t at) {
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + at));
+			const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + at));
+			const auto eq = static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))));
+			diff |= (~eq & 0xffff) << at;
+		};
+		[&]<std::size_t... C>(std::index_sequence<C...>) { (chunk(C * 16), ...); }(std::make_index_sequence<N / 16>{});
+		if constexpr (N % 16 != 0) chunk(N - 16);	// overlaps the last full chunk
+		return diff ? static_cast<std::size_t>(std::countr_zero(diff)) : N;
+	}
+	else
+#endif
+	return first_mismatch(a, b, N);
+}
+
+/* index of the last byte where a and b differ, n if none */
+inline std::size_t last_mismatch(const unsigned char* a, const unsigned char* b, std::size_t n)
+{
+	std::size_t i = n;
+#if defined(__SSE2__)
+	for (; i >= 16; i -= 16)
+	{
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 16));
+		const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i - 16));
+		const unsigned diff = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffu;
+		if (diff) return i - 16 + 31 - static_cast<std::size_t>(std::countl_zero(diff));
+	}
+#endif
+	for (; i > 0; --i)
+	{
+		if (a[i - 1] != b[i - 1]) return i - 1;
+	}
+	return n;
+}
+
+/* compare one field of a and b, the first one that differs */
+template<class F>
+std::strong_ordering compare_field(const F& x, const F& y)
+{
+	if constexpr (is_byte_array<F>::value)
+	{
+		const auto* px = reinterpret_cast<const unsigned char*>(x.data());
+		const auto* py = reinterpret_cast<const unsigned char*>(y.data());
+		const std::size_t k = first_mismatch(px, py, x.size());
+		return k == x.size() ? std::strong_ordering::equal : px[k] <=> py[k];
+	}
+	else
+	{
+		return x <=> y;
+	}
+}
+
+} // detail
+
+/* true if fast_three_way compares T as raw memory */
+template<class T>
+inline constexpr bool is_packed_v = detail::is_packed<T>();
+
+namespace detail
+{
+
+template<class T>
+using fields_t = std::remove_cvref_t<decltype(aggregate::tie(std::declval<const T&>()))>;
+
+/*
+ * For every byte of a packed aggregate: where to read the value that
+ * decides the comparison when that byte is the first difference. The
+ * members of an aggregate are laid out in declaration order and, with no
+ * padding, each one starts where the previous one ends. An integer field
+ * is read whole, a byte array only at the differing byte; both as an
+ * 8-byte load at pos, shifted and masked.
+ */
+struct lane
+{
+	std::uint8_t pos;
+	std::uint8_t shift;
+	std::uint64_t mask;
+};
+
+template<class T>
+constexpr auto make_lanes()
+{
+	static_assert(sizeof(T) >= 8 && sizeof(T) < 256);
+	std::array<lane, sizeof(T)> lanes{};
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		std::size_t at = 0;
+		auto add = [&]<class F>(std::type_identity<F>) {
+			for (std::size_t d = at; d < at + sizeof(F); ++d)
+			{
+				const std::size_t start = is_byte_array<F>::value ? d : at;
+				const std::size_t width = is_byte_array<F>::value ? 1 : sizeof(F);
+				const std::size_t pos = std::min(start, sizeof(T) - 8);
+				lanes[d] = { static_cast<std::uint8_t>(pos), static_cast<std::uint8_t>((start - pos) * 8),
+					width == 8 ? ~std::uint64_t(0) : (std::uint64_t(1) << (width * 8)) - 1 };
+			}
+			at += sizeof(F);
+		};
+		(add(std::type_identity<std::remove_cvref_t<std::tuple_element_t<I, fields_t<T>>>>{}), ...);
+	}(std::make_index_sequence<std::tuple_size_v<fields_t<T>>>{});
+	return lanes;
+}
+
+template<class T>
+inline constexpr auto lanes = make_lanes<T>();
+
+inline std::uint64_t load_lane(const unsigned char* p, const lane& l)
+{
+	std::uint64_t v;
+	std::memcpy(&v, p + l.pos, 8);
+	return (v >> l.shift) & l.mask;
+}
+
+/* compare field `which` of a and b */
+template<class Fields>
+std::strong_ordering compare_nth(const Fields& fa, const Fields& fb, std::size_t which)
+{
+	std::strong_ordering result = std::strong_ordering::equal;
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		(void)((which == I ? (result = compare_field(std::get<I>(fa), std::get<I>(fb)), true) : false) || ...);
+	}(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+	return result;
+}
+
+} // detail
+
+template<class T>
+auto fast_three_way(const T& a, const T& b)
+{
+	if constexpr (is_packed_v<T>)
+	{
+		const auto* pa = reinterpret_cast<const unsigned char*>(std::addressof(a));
+		const auto* pb = reinterpret_cast<const unsigned char*>(std::addressof(b));
+
+		if constexpr (aggregate::is_decomposable_v<T> && sizeof(T) >= 8 && std::endian::native == std::endian::little)
+		{
+			const std::size_t d = detail::first_mismatch<sizeof(T)>(pa, pb);
+			if (d == sizeof(T)) return std::strong_ordering::equal;
+			const detail::lane& l = detail::lanes<T>[d];
+			return detail::load_lane(pa, l) <=> detail::load_lane(pb, l);
+		}
+		else
+		{
+			// a tuple, the standard does not say in which order its fields are stored
+			const auto fa = aggregate::tie(a);
+			auto offset = [pa](const auto& field) {
+				return static_cast<std::size_t>(reinterpret_cast<const unsigned char*>(std::addressof(field)) - pa);
+			};
+
+			constexpr std::size_t fields = std::tuple_size_v<detail::fields_t<T>>;
+			bool forward = true;
+			if constexpr (fields > 1) forward = offset(std::get<0>(fa)) < offset(std::get<1>(fa));
+
+			const std::size_t d = forward ? detail::first_mismatch(pa, pb, sizeof(T)) : detail::last_mismatch(pa, pb, sizeof(T));
+			if (d == sizeof(T)) return std::strong_ordering::equal;
+
+			std::size_t which = 0;
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				(void)(((offset(std::get<I>(fa)) <= d && d < offset(std::get<I>(fa)) + sizeof(std::get<I>(fa))) ? (which = I, true) : false) || ...);
+			}(std::make_index_sequence<fields>{});
+			return detail::compare_nth(fa, aggregate::tie(b), which);
+		}
+	}
+	else
+	{
+		return a <=> b;
+	}
+}
+
+/* a < b through fast_three_way, for std::sort and friends */
+struct fast_less
+{
+	template<class T>
+	bool operator()(const T& a, const T& b) const { return fast_three_way(a, b) < 0; }
+};
+
+} // fast_three_way_ns
+
+using fast_three_way_ns::fast_three_way;
+using fast_three_way_ns::fast_less;
+
+
 
 } // cxx20
 } // pluto
@@ -0,0 +1,216 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 18:40:51
+ * @brief
+ */
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "operator.h"
+
+using namespace std;
+using namespace pluto::cxx20;
+
+namespace
+{
+
+using row = tuple<int32_t, double, uint32_t>;
+using named_row = tuple<string, int32_t>;
+
+template<class Row>
+vector<Row> random_rows(size_t n);
+
+template<>
+vector<row> random_rows<row>(size_t n)
+{
+	std::mt19937 gen(21);
+	vector<row> v(n);
+	for (auto& r : v) r = { static_cast<int32_t>(gen() % 1000) - 500, static_cast<int>(gen() % 4096) / 16.0, gen() };
+	return v;
+}
+
+template<>
+vector<named_row> random_rows<named_row>(size_t n)
+{
+	std::mt19937 gen(22);
+	vector<named_row> v(n);
+	for (auto& r : v) r = { "sym" + to_string(gen() % 5000), static_cast<int32_t>(gen()) };
+	return v;
+}
+
+enum class method { three_way, by_key, radix };
+
+} // namespace
+
+/* sort a fresh copy of n records per iteration */
+template<class Row, method M>
+static void BM_SortRecords(benchmark::State& state)
+{
+	const auto rows = random_rows<Row>(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto work = rows;
+		state.ResumeTiming();
+
+		if constexpr (M == method::three_way)
+		{
+			std::sort(work.begin(), work.end(), [](const auto& a, const auto& b) { return (a <=> b) < 0; });
+		}
+		if constexpr (M == method::by_key) sort_key::sort_by_key(work);
+		if constexpr (M == method::radix) sort_key::radix_sort_by_key(work);
+		benchmark::DoNotOptimize(work.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_SortRecords, row, method::three_way)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortRecords, row, method::by_key)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortRecords, row, method::radix)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortRecords, named_row, method::three_way)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortRecords, named_row, method::by_key)->Range(1 << 12, 1 << 20);
+
+// floating point sorts, NaN-free input so that std::sort with < is legal
+
+template<class F, class Sort>
+static void sort_floats(benchmark::State& state, Sort sort)
+{
+	std::mt19937_64 gen(23);
+	std::normal_distribution<F> dist(0, 1000);
+	vector<F> data(static_cast<size_t>(state.range(0)));
+	for (auto& x : data) x = dist(gen);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto work = data;
+		state.ResumeTiming();
+		sort(work);
+		benchmark::DoNotOptimize(work.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class F>
+static void BM_SortFloat_Less(benchmark::State& state)
+{
+	sort_floats<F>(state, [](vector<F>& v) { std::sort(v.begin(), v.end(), [](F a, F b) { return a < b; }); });
+}
+
+template<class F>
+static void BM_SortFloat_TotalOrder(benchmark::State& state)
+{
+	sort_floats<F>(state, [](vector<F>& v) { std::sort(v.begin(), v.end(), total_order{}); });
+}
+
+template<class F>
+static void BM_SortFloat_Radix(benchmark::State& state)
+{
+	sort_floats<F>(state, [](vector<F>& v) { radix_sort(v); });
+}
+
+template<class F>
+static void BM_SortFloat_RadixPairs(benchmark::State& state)
+{
+	vector<uint32_t> payload(static_cast<size_t>(state.range(0)));
+	sort_floats<F>(state, [&](vector<F>& v) { radix_sort_pairs(v, payload); });
+}
+
+BENCHMARK_TEMPLATE(BM_SortFloat_Less, double)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SortFloat_TotalOrder, double)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SortFloat_Radix, double)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SortFloat_RadixPairs, double)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SortFloat_Less, float)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SortFloat_Radix, float)->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+
+// wide records, compared field by field or as memory
+
+namespace
+{
+
+struct wide
+{
+	uint32_t venue;
+	uint32_t desk;
+	uint64_t account;
+	array<uint8_t, 16> id;
+	uint64_t book;
+	uint32_t seq;
+	uint16_t side;
+	uint16_t flags;
+
+	auto operator<=>(const wide&) const = default;
+	bool operator==(const wide&) const = default;
+};
+
+/*
+ * Records equal to a common base except for one field, picked at random,
+ * so the position of the first difference is unpredictable.
+ */
+vector<wide> random_wide(size_t n)
+{
+	std::mt19937_64 gen(24);
+	vector<wide> v(n);
+	for (auto& w : v)
+	{
+		w = { 1, 2, 3, {}, 4, 5, 6, 7 };
+		switch (gen() % 8)
+		{
+		case 0: w.venue = static_cast<uint32_t>(gen() % 3); break;
+		case 1: w.desk = static_cast<uint32_t>(gen() % 3); break;
+		case 2: w.account = gen() % 8; break;
+		case 3: w.id[gen() % 16] = static_cast<uint8_t>(gen()); break;
+		case 4: w.book = gen() % 8; break;
+		case 5: w.seq = static_cast<uint32_t>(gen() % 8); break;
+		case 6: w.side = static_cast<uint16_t>(gen() % 8); break;
+		default: w.flags = static_cast<uint16_t>(gen()); break;
+		}
+	}
+	return v;
+}
+
+} // namespace
+
+template<bool Fast>
+static void BM_CompareWide(benchmark::State& state)
+{
+	const auto v = random_wide(4096);
+	for (auto _ : state)
+	{
+		int less = 0;
+		for (size_t i = 1; i < v.size(); ++i)
+		{
+			if constexpr (Fast) less += fast_three_way(v[i - 1], v[i]) < 0;
+			else less += (v[i - 1] <=> v[i]) < 0;
+		}
+		benchmark::DoNotOptimize(less);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(v.size() - 1));
+}
+
+template<bool Fast>
+static void BM_SortWide(benchmark::State& state)
+{
+	const auto v = random_wide(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto work = v;
+		state.ResumeTiming();
+		if constexpr (Fast) std::sort(work.begin(), work.end(), fast_less{});
+		else std::sort(work.begin(), work.end());
+		benchmark::DoNotOptimize(work.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_CompareWide, false);
+BENCHMARK_TEMPLATE(BM_CompareWide, true);
+BENCHMARK_TEMPLATE(BM_SortWide, false)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortWide, true)->Range(1 << 12, 1 << 20);
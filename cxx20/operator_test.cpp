@@ -0,0 +1,350 @@
+
+/*
+ * @author WardenAllen
+ * @date   2026/10/19 18:40:51
+ * @brief
+ */
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "operator.h"
+#include "common/define.h"
+
+using namespace std;
+using namespace pluto::cxx20;
+
+namespace {
+
+struct trade
+{
+	int32_t day;
+	double price;
+	string symbol;
+	optional<uint16_t> venue;
+
+	auto operator<=>(const trade&) const = default;
+	bool operator==(const trade&) const = default;
+};
+
+struct point
+{
+	int16_t x;
+	int64_t y;
+	bool flag;
+};
+
+struct tagged
+{
+	uint32_t venue;
+	array<uint8_t, 16> id;
+	array<int16_t, 2> pos;
+
+	auto operator<=>(const tagged&) const = default;
+};
+
+int sign(int x) { return (x > 0) - (x < 0); }
+
+template<class T>
+int sign(const T& a, const T& b)
+{
+	auto c = a <=> b;
+	return c < 0 ? -1 : c > 0 ? 1 : 0;
+}
+
+} // namespace
+
+TEST(PLUTO, CXX20_THREE_WAY_COMPARISON) {
+
+	TEST_COUT;
+	three_way_comparison_operator::test();
+	cout << endl;
+}
+
+TEST(PLUTO, CXX20_SORT_KEY) {
+
+	{
+		static_assert(aggregate::field_count_v<trade> == 4);
+		static_assert(aggregate::field_count_v<point> == 3);
+		static_assert(sort_key::is_fixed_v<point> && sort_key::key_size_v<point> == 11);
+		static_assert(!sort_key::is_fixed_v<trade>);
+		static_assert(sort_key::key_size_v<tuple<uint8_t, float, pair<int64_t, bool>>> == 14);
+
+		// a std::array field is one field, keyed element by element
+		static_assert(aggregate::field_count_v<tagged> == 3);
+		static_assert(!aggregate::is_decomposable_v<array<uint8_t, 16>>);
+		static_assert(sort_key::key_size_v<tagged> == 4 + 16 + 4);
+		static_assert(!sort_key::is_fixed_v<array<string, 2>>);
+		EXPECT_EQ(string("\x01\x02\xff", 3), sort_key::make_key(array<uint8_t, 3>{ 1, 2, 255 }));
+
+		// a few encodings byte by byte
+		EXPECT_EQ(string("\x80\x00\x00\x01", 4), sort_key::make_key(int32_t{ 1 }));
+		EXPECT_EQ(string("\x7f\xff\xff\xff", 4), sort_key::make_key(int32_t{ -1 }));
+		EXPECT_EQ(string("a\0\xff" "b\0\0", 6), sort_key::make_key(string("a\0b", 3)));
+		EXPECT_EQ(string("\0", 1), sort_key::make_key(optional<int>()));
+		EXPECT_EQ(sort_key::make_key(0.0), sort_key::make_key(-0.0));
+
+		TEST_COUT << sort_key::make_key(trade{ 1, 2.0, "IBM", 7 }).size() << " bytes" << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// memcmp order of the keys == <=> order of the values
+		mt19937 gen(5);
+		auto pick_double = [&] {
+			static const double special[] = { 0.0, -0.0, 1.0, -1.0, numeric_limits<double>::infinity(),
+				-numeric_limits<double>::infinity(), numeric_limits<double>::denorm_min(), -1e300 };
+			return gen() % 3 == 0 ? special[gen() % 8] : static_cast<int>(gen() % 200 - 100) / 8.0;
+		};
+		auto pick_string = [&] {
+			string s(gen() % 3, 'a');
+			for (auto& c : s) c = "\0ab\xff"[gen() % 4];
+			return s;
+		};
+		auto pick_trade = [&] {
+			trade t{ static_cast<int32_t>(gen() % 5) - 2, pick_double(), pick_string(), nullopt };
+			if (gen() % 2) t.venue = static_cast<uint16_t>(gen() % 3);
+			return t;
+		};
+
+		int mismatches = 0;
+		for (int i = 0; i < 20000; ++i)
+		{
+			trade a = pick_trade(), b = pick_trade();
+			if (gen() % 4 == 0) b = a;
+			mismatches += sign(a, b) != sign(sort_key::make_key(a).compare(sort_key::make_key(b)));
+
+			point p{ static_cast<int16_t>(gen()), static_cast<int64_t>(gen()) - (1ll << 31), gen() % 2 == 0 };
+			point q{ static_cast<int16_t>(gen()), static_cast<int64_t>(gen()) - (1ll << 31), gen() % 2 == 0 };
+			auto kp = sort_key::make_fixed_key(p), kq = sort_key::make_fixed_key(q);
+			mismatches += sign(aggregate::tie(p), aggregate::tie(q)) != sign(memcmp(kp.data(), kq.data(), kp.size()));
+
+			tagged t{ static_cast<uint32_t>(gen() % 2), {}, { static_cast<int16_t>(gen() % 3 - 1), 0 } }, u = t;
+			t.id[gen() % 16] = static_cast<uint8_t>(gen() % 3);
+			u.id[gen() % 16] = static_cast<uint8_t>(gen() % 3);
+			u.pos[gen() % 2] = static_cast<int16_t>(gen() % 3 - 1);
+			mismatches += sign(t, u) != sign(sort_key::make_key(t).compare(sort_key::make_key(u)));
+		}
+		EXPECT_EQ(0, mismatches);
+
+		// NaN is unordered for <=>, in the key it is one value after +inf
+		double nan = std::nan("");
+		EXPECT_EQ(sort_key::make_key(nan), sort_key::make_key(-nan));
+		EXPECT_LT(sort_key::make_key(numeric_limits<double>::infinity()), sort_key::make_key(nan));
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		mt19937 gen(6);
+		vector<tuple<int32_t, double, uint8_t>> rows(5000);
+		for (auto& r : rows) r = { static_cast<int32_t>(gen() % 100) - 50, static_cast<int>(gen() % 64) / 4.0, static_cast<uint8_t>(gen()) };
+
+		auto expected = rows;
+		stable_sort(expected.begin(), expected.end());
+
+		auto by_key = rows;
+		sort_key::sort_by_key(by_key);
+		EXPECT_EQ(expected, by_key);
+
+		auto by_radix = rows;
+		sort_key::radix_sort_by_key(by_radix);
+		EXPECT_EQ(expected, by_radix);
+
+		vector<trade> trades{ { 2, 1.5, "b", 1 }, { 1, 9.0, "a", nullopt }, { 2, 1.5, "a", 3 }, { 2, 1.5, "a", nullopt } };
+		auto sorted_trades = trades;
+		sort(sorted_trades.begin(), sorted_trades.end());
+		sort_key::sort_by_key(trades);
+		EXPECT_EQ(sorted_trades, trades);
+	}
+}
+
+TEST(PLUTO, CXX20_TOTAL_ORDER) {
+
+	const double inf = numeric_limits<double>::infinity();
+	const double qnan = numeric_limits<double>::quiet_NaN();
+
+	{
+		// -0.0 and 0.0 are no longer equal, NaN has a place
+		static_assert(total_order{}(-0.0, 0.0) && !total_order{}(0.0, -0.0));
+		static_assert(total_order::compare(1.0f, 1.0f) == strong_ordering::equal);
+		EXPECT_TRUE(total_order{}(inf, qnan));
+		EXPECT_TRUE(total_order{}(-qnan, -inf));
+		EXPECT_FALSE(total_order{}(qnan, qnan));
+
+		TEST_COUT << boolalpha << total_order{}(-0.0, 0.0) << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// same answers as std::strong_order on interesting bit patterns
+		vector<double> values = { 0.0, -0.0, 1.0, -1.0, inf, -inf, qnan, -qnan, numeric_limits<double>::denorm_min(),
+			-numeric_limits<double>::denorm_min(), numeric_limits<double>::max(), numeric_limits<double>::lowest(),
+			bit_cast<double>(uint64_t{ 0x7ff0000000000001 }), bit_cast<double>(uint64_t{ 0xfff8000000000001 }) };
+		int mismatches = 0;
+		for (double a : values)
+		{
+			for (double b : values)
+			{
+				mismatches += total_order::compare(a, b) != strong_order(a, b);
+				mismatches += total_order::compare(float(a), float(b)) != strong_order(float(a), float(b));
+			}
+		}
+		EXPECT_EQ(0, mismatches);
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		mt19937_64 gen(9);
+		vector<double> d(20000);
+		for (auto& x : d) x = gen() % 16 == 0 ? bit_cast<double>(gen()) : static_cast<int>(gen() % 2000 - 1000) / 3.0;
+		d[0] = qnan;
+		d[1] = -0.0;
+		d[2] = 0.0;
+
+		auto expected = d;
+		stable_sort(expected.begin(), expected.end(), total_order{});
+		radix_sort(d);
+		EXPECT_EQ(0, memcmp(expected.data(), d.data(), d.size() * sizeof(double)));
+
+		vector<float> f(5000);
+		for (auto& x : f) x = static_cast<float>(static_cast<int32_t>(gen())) / 7.0f;
+		auto fexpected = f;
+		sort(fexpected.begin(), fexpected.end(), total_order{});
+		radix_sort(f);
+		EXPECT_EQ(fexpected, f);
+
+		// the values follow their keys, equal keys keep their order
+		vector<float> keys = { 3.0f, -1.0f, 3.0f, -0.0f, 0.0f };
+		vector<string> names = { "a", "b", "c", "d", "e" };
+		radix_sort_pairs(keys, names);
+		EXPECT_EQ((vector<string>{ "b", "d", "e", "a", "c" }), names);
+		EXPECT_EQ((vector<float>{ -1.0f, -0.0f, 0.0f, 3.0f, 3.0f }), keys);
+
+		// a key without a value is an error, not a partial sort
+		names.pop_back();
+		EXPECT_THROW(radix_sort_pairs(keys, names), std::invalid_argument);
+	}
+}
+
+namespace {
+
+struct order_key
+{
+	uint32_t venue;
+	uint32_t seq;
+	uint64_t account;
+	array<uint8_t, 16> id;
+	uint16_t side;
+	uint16_t flags;
+	uint32_t extra;
+
+	auto operator<=>(const order_key&) const = default;
+	bool operator==(const order_key&) const = default;
+};
+
+struct padded
+{
+	uint8_t a;
+	uint32_t b;
+
+	auto operator<=>(const padded&) const = default;
+	bool operator==(const padded&) const = default;
+};
+
+/* more fields than aggregate::tie binds */
+struct wide
+{
+	uint8_t f0, f1, f2, f3, f4, f5, f6, f7, f8;
+
+	auto operator<=>(const wide&) const = default;
+	bool operator==(const wide&) const = default;
+};
+
+struct wide_signed
+{
+	int f0, f1, f2, f3, f4, f5, f6, f7, f8, f9;
+
+	auto operator<=>(const wide_signed&) const = default;
+	bool operator==(const wide_signed&) const = default;
+};
+
+} // namespace
+
+TEST(PLUTO, CXX20_FAST_THREE_WAY) {
+
+	{
+		static_assert(fast_three_way_ns::is_packed_v<order_key>);
+		static_assert(fast_three_way_ns::is_packed_v<tuple<uint32_t, uint32_t, uint64_t>>);
+		static_assert(!fast_three_way_ns::is_packed_v<padded>);					// padding bytes
+		static_assert(!fast_three_way_ns::is_packed_v<tuple<int32_t, uint32_t>>);	// signed field
+		static_assert(!fast_three_way_ns::is_packed_v<double>);
+		static_assert(!fast_three_way_ns::is_packed_v<wide>);						// 9 fields
+		static_assert(!fast_three_way_ns::is_packed_v<wide_signed>);
+		static_assert(aggregate::is_tieable_v<order_key> && !aggregate::is_tieable_v<wide>);
+
+		TEST_COUT << sizeof(order_key) << " bytes compared as memory" << endl;
+	}
+
+	TEST_COUT_DELIMITER;
+
+	{
+		// agrees with <=> on records that differ in one random field
+		mt19937_64 gen(12);
+		auto random_key = [&] {
+			order_key k{ static_cast<uint32_t>(gen() % 3), static_cast<uint32_t>(gen() % 3), gen() % 3, {},
+				static_cast<uint16_t>(gen() % 3), static_cast<uint16_t>(gen()), static_cast<uint32_t>(gen() % 3) };
+			for (auto& b : k.id) b = static_cast<uint8_t>(gen() % 3);
+			return k;
+		};
+
+		int mismatches = 0;
+		for (int i = 0; i < 50000; ++i)
+		{
+			order_key a = random_key(), b = random_key();
+			if (gen() % 2)
+			{
+				b = a;
+				switch (gen() % 4)
+				{
+				case 0: b.account = gen(); break;
+				case 1: b.id[gen() % 16] = static_cast<uint8_t>(gen()); break;
+				case 2: b.flags = static_cast<uint16_t>(gen()); break;
+				default: break;
+				}
+			}
+			mismatches += fast_three_way(a, b) != (a <=> b);
+
+			tuple<uint8_t, uint8_t, uint16_t, uint32_t> t{ static_cast<uint8_t>(gen() % 2), static_cast<uint8_t>(gen() % 2),
+				static_cast<uint16_t>(gen() % 2), static_cast<uint32_t>(gen() % 300) };
+			tuple<uint8_t, uint8_t, uint16_t, uint32_t> u{ static_cast<uint8_t>(gen() % 2), static_cast<uint8_t>(gen() % 2),
+				static_cast<uint16_t>(gen() % 2), static_cast<uint32_t>(gen() % 300) };
+			mismatches += fast_three_way(t, u) != (t <=> u);
+
+			tuple<array<uint8_t, 4>, uint32_t> x{ { static_cast<uint8_t>(gen() % 2), 1, static_cast<uint8_t>(gen() % 2), 0 }, 0 };
+			tuple<array<uint8_t, 4>, uint32_t> y{ { static_cast<uint8_t>(gen() % 2), 1, static_cast<uint8_t>(gen() % 2), 0 }, 0 };
+			mismatches += fast_three_way(x, y) != (x <=> y);
+		}
+		EXPECT_EQ(0, mismatches);
+
+		// everything else goes through <=>
+		EXPECT_EQ(partial_ordering::less, fast_three_way(1.0, 2.0));
+		EXPECT_EQ(strong_ordering::greater, fast_three_way(string("b"), string("a")));
+		EXPECT_TRUE(fast_less{}(padded{ 1, 2 }, padded{ 1, 3 }));
+		EXPECT_EQ(strong_ordering::less, fast_three_way(wide{ 1, 2, 3, 4, 5, 6, 7, 8, 9 }, wide{ 1, 2, 3, 4, 5, 6, 7, 8, 10 }));
+		EXPECT_EQ(strong_ordering::greater, fast_three_way(wide_signed{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, wide_signed{ 1, -2, 3, 4, 5, 6, 7, 8, 9, 10 }));
+	}
+}